@@ -52,6 +52,7 @@
  *  │ TIM             │ Measure reaction time in microseconds            │
  *  │ EXTI            │ Detect button press via interrupt                │
  *  │ NVIC            │ Configure and handle interrupts                  │
+ *  │ RNG             │ True random wait times from the hardware TRNG    │
  *  │ Bit Manipulation│ All register configurations                      │
  *  └─────────────────┴──────────────────────────────────────────────────┘
  *  
@@ -79,7 +80,7 @@
  *  ==========================================
  *  
  *  Every peripheral lives at a specific address in memory.
- *  We need: RCC, GPIO (B, C, E), SYSCFG, EXTI, TIM2, NVIC
+ *  We need: RCC, GPIO (B, C, E), SYSCFG, EXTI, TIM2, RNG, NVIC
  * ============================================================================ */
 
 #define RCC_BASE        0x58024400UL
@@ -89,6 +90,7 @@
 #define SYSCFG_BASE     0x58000400UL
 #define EXTI_BASE       0x58000000UL
 #define TIM2_BASE       0x40000000UL
+#define RNG_BASE        0x48021800UL    /* AHB2 */
 
 /* NVIC registers are in the Cortex-M7 core, not the STM32 peripheral space */
 #define NVIC_ISER_BASE  0xE000E100UL    /* Interrupt Set Enable Registers */
@@ -231,6 +233,12 @@ typedef struct {
     volatile uint32_t CCR4;
 } TIM_TypeDef;
 
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t SR;
+    volatile uint32_t DR;
+} RNG_TypeDef;
+
 /* Peripheral pointers */
 #define RCC     ((RCC_TypeDef *) RCC_BASE)
 #define GPIOB   ((GPIO_TypeDef *) GPIOB_BASE)
@@ -239,6 +247,7 @@ typedef struct {
 #define SYSCFG  ((SYSCFG_TypeDef *) SYSCFG_BASE)
 #define EXTI    ((EXTI_TypeDef *) EXTI_BASE)
 #define TIM2    ((TIM_TypeDef *) TIM2_BASE)
+#define RNG     ((RNG_TypeDef *) RNG_BASE)
 
 /* NVIC registers (arrays) */
 #define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
@@ -255,6 +264,19 @@ typedef struct {
 #define RCC_AHB4ENR_GPIOEEN     (1U << 4)
 #define RCC_APB4ENR_SYSCFGEN    (1U << 1)
 #define RCC_APB1LENR_TIM2EN     (1U << 0)
+#define RCC_AHB2ENR_RNGEN       (1U << 6)
+#define RCC_CR_HSI48ON          (1U << 12)  /* RNG kernel clock source */
+#define RCC_CR_HSI48RDY         (1U << 13)
+#define RCC_D2CCIP2R_RNGSEL_Msk (3U << 8)   /* 00 = HSI48 */
+
+/* RNG */
+#define RNG_CR_RNGEN            (1U << 2)   /* Generator enable */
+#define RNG_CR_IE               (1U << 3)   /* Interrupt enable */
+#define RNG_SR_DRDY             (1U << 0)   /* A random word is ready */
+#define RNG_SR_CECS             (1U << 1)   /* Clock error, current status */
+#define RNG_SR_SECS             (1U << 2)   /* Seed error, current status */
+#define RNG_SR_CEIS             (1U << 5)   /* Clock error flag (write 0 to clear) */
+#define RNG_SR_SEIS             (1U << 6)   /* Seed error flag (write 0 to clear) */
 
 /* TIM */
 #define TIM_CR1_CEN             (1U << 0)
@@ -266,6 +288,7 @@ typedef struct {
 
 /* NVIC - EXTI15_10 is IRQ number 40 */
 #define EXTI15_10_IRQn          40
+#define RNG_IRQn                80
 
 /* LED Pins */
 #define LED_GREEN_PIN           0       /* PB0 */
@@ -529,25 +552,241 @@ void delay_ms(uint32_t ms) {
 }
 
 /* ============================================================================
- *  PSEUDO-RANDOM NUMBER GENERATOR
- *  ================================
  *  
- *  We use a Linear Congruential Generator (LCG) for simplicity.
- *  Seeded by timer value for randomness.
+ *  📚 QUICK LESSON: TRUE RANDOM NUMBERS
+ *  ====================================
+ *  
+ *  A software generator (LCG) seeded from TIM2->CNT is predictable: the
+ *  timer always holds about the same value this early after reset, so
+ *  every game starts with the same "random" waits.
+ *  
+ *  The STM32H7 has a TRNG: analog noise sources sampled by the 48 MHz
+ *  HSI48 clock, conditioned into 32-bit words. Two things can go wrong:
+ *  
+ *  ┌──────────────┬───────────────────────────────┬──────────────────────┐
+ *  │ Error        │ Meaning                       │ Recovery             │
+ *  ├──────────────┼───────────────────────────────┼──────────────────────┤
+ *  │ Clock (CECS) │ RNG clock < HCLK / 32         │ Fix clock, clear CEIS│
+ *  │ Seed (SECS)  │ Noise source stuck / too      │ Clear SEIS, discard  │
+ *  │              │ regular                       │ 12 words, re-check   │
+ *  └──────────────┴───────────────────────────────┴──────────────────────┘
+ *  
+ *  Words arrive every ~40 RNG clocks. So nobody waits for one, the
+ *  interrupt keeps a 32-word POOL full and switches itself off while the
+ *  pool is full:
+ *  
+ *      RNG ──DRDY irq──► pool [■■■■■■■■□□□□] ──RNG_Get32()──► game
+ *                         head (ISR)   tail (main)
+ *  
+ * ============================================================================ */
+
+#define RNG_POOL_SIZE           32U     /* Words, power of 2 */
+
+volatile uint32_t rng_pool[RNG_POOL_SIZE];
+volatile uint32_t rng_head = 0;         /* Written by the ISR */
+volatile uint32_t rng_tail = 0;         /* Written by main */
+
+/* Error counters - watch them in the debugger */
+volatile uint32_t rng_clock_errors = 0;
+volatile uint32_t rng_seed_errors = 0;
+volatile uint32_t rng_resets = 0;
+
+/* ============================================================================
+ *  
+ *  STEP 4b: START THE RNG
+ *  =======================
+ *  
+ * ============================================================================ */
+
+void RNG_Init(void) {
+    /* Kernel clock: HSI48 (RNGSEL = 00, the reset value) */
+    RCC->CR |= RCC_CR_HSI48ON;
+    while (!(RCC->CR & RCC_CR_HSI48RDY));
+    RCC->D2CCIP2R &= ~RCC_D2CCIP2R_RNGSEL_Msk;
+
+    RCC->AHB2ENR |= RCC_AHB2ENR_RNGEN;
+    (void)RCC->AHB2ENR;
+
+    /* Clock error detection stays on (CED = 0) */
+    RNG->CR = RNG_CR_RNGEN | RNG_CR_IE;
+
+    NVIC_ISER[RNG_IRQn / 32] = (1U << (RNG_IRQn % 32));
+}
+
+/* Seed error: flush the conditioning pipeline, reset if it persists */
+void RNG_RecoverSeed(void) {
+    RNG->SR = ~RNG_SR_SEIS;
+    for (uint32_t i = 0; i < 12; i++) {
+        (void)RNG->DR;
+    }
+    if (RNG->SR & RNG_SR_SECS) {
+        RNG->CR &= ~RNG_CR_RNGEN;
+        RNG->CR |= RNG_CR_RNGEN;
+        rng_resets++;
+    }
+}
+
+void RNG_IRQHandler(void) {
+    uint32_t sr = RNG->SR;
+    uint32_t word;
+
+    if (sr & RNG_SR_CEIS) {
+        /* The RNG resumes by itself once its clock is fast enough again */
+        rng_clock_errors++;
+        RNG->SR = ~RNG_SR_CEIS;
+    }
+    if (sr & RNG_SR_SEIS) {
+        rng_seed_errors++;
+        RNG_RecoverSeed();
+        return;
+    }
+
+    while ((RNG->SR & RNG_SR_DRDY) && (rng_head - rng_tail) < RNG_POOL_SIZE) {
+        word = RNG->DR;
+
+        /* ✏️ YOUR TURN: A 0 may be a word cut short by a seed error - drop it */
+        if (word == ???) {              /* HINT: The value to reject */
+            continue;
+        }
+        rng_pool[rng_head % RNG_POOL_SIZE] = word;
+        rng_head++;
+    }
+
+    /* Pool full: stop interrupting until main takes a word */
+    if ((rng_head - rng_tail) >= RNG_POOL_SIZE) {
+        RNG->CR &= ~RNG_CR_IE;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ *  
+ * if (word == 0) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Take one word from the pool. Returns 0 on success, -1 if it is empty. */
+int RNG_Get32(uint32_t *out) {
+    if (rng_head == rng_tail) {
+        return -1;
+    }
+    *out = rng_pool[rng_tail % RNG_POOL_SIZE];
+    rng_tail++;
+
+    /* Room again - let the ISR refill */
+    RNG->CR |= RNG_CR_IE;
+    return 0;
+}
+
+/* Nonces, keys, IVs: fill a buffer. Returns bytes written. */
+uint32_t RNG_Fill(uint8_t *buf, uint32_t len) {
+    uint32_t done = 0;
+    uint32_t word;
+
+    while (done < len && RNG_Get32(&word) == 0) {
+        for (uint32_t i = 0; i < 4 && done < len; i++) {
+            buf[done++] = (uint8_t)(word >> (i * 8));
+        }
+    }
+    return done;
+}
+
+/* ============================================================================
+ *  
+ *  📚 QUICK LESSON: RANDOM IN A RANGE WITHOUT BIAS
+ *  ===============================================
+ *  
+ *  "x % n" is biased: 2^32 is not a multiple of n, so the low results
+ *  come up once more often than the high ones. It also costs a divide.
+ *  
+ *  Multiply-shift maps x onto [0, n) with a multiply instead:
+ *  
+ *      m = x × n   (64-bit)      result = m >> 32
+ *  
+ *  Still, 2^32 values of x do not split evenly into n results: 2^32 mod n
+ *  of the results get one x more than the rest. Those extra x's are
+ *  exactly the ones whose low 32 bits of m are < 2^32 mod n - drawing
+ *  again for them makes every result equally likely.
+ *  Since (2^32 mod n) < n, the division is only needed when low < n,
+ *  which happens with a probability of n / 2^32.
+ *  
  * ============================================================================ */
 
-static uint32_t random_seed = 12345;
+volatile uint32_t rng_failures = 0;
 
-void random_init(void) {
-    /* Seed with current timer value */
-    random_seed = TIM2->CNT;
-    if (random_seed == 0) random_seed = 12345;
+uint32_t RNG_Below(uint32_t n) {
+    uint32_t x;
+    uint64_t m;
+    uint32_t low;
+
+    if (RNG_Get32(&x) != 0) {
+        rng_failures++;             /* Pool empty: still play, just less random */
+        x = TIM2->CNT * 2654435761U;
+    }
+
+    /* ✏️ YOUR TURN: Scale x onto [0, n) */
+    m = (uint64_t)x * ???;          /* HINT: The range size */
+    low = (uint32_t)m;
+
+    if (low < n) {
+        uint32_t threshold = (0U - n) % n;     /* = 2^32 mod n */
+        while (low < threshold) {
+            if (RNG_Get32(&x) != 0) {
+                rng_failures++;
+                break;
+            }
+            m = (uint64_t)x * n;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
 }
 
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ *  
+ * m = (uint64_t)x * n;
+ * ───────────────────────────────────────────────────────────────────────────── */
+
 uint32_t random_range(uint32_t min, uint32_t max) {
-    /* LCG: seed = (a * seed + c) mod m */
-    random_seed = random_seed * 1103515245 + 12345;
-    return min + (random_seed % (max - min + 1));
+    return min + RNG_Below(max - min + 1);
+}
+
+/* ============================================================================
+ *  SELF-TEST: IS THE DISTRIBUTION FLAT?
+ *  =====================================
+ *  
+ *  Chi-square test over 16 buckets: 16,000 draws, 1,000 expected each.
+ *  
+ *      χ² = Σ (observed - 1000)² / 1000
+ *  
+ *  With 15 degrees of freedom a fair generator stays below 30.58 in 99%
+ *  of runs. Kept ×1000 to avoid floats. Runs once at boot, when waiting
+ *  for the RNG is acceptable.
+ * ============================================================================ */
+
+#define RNG_TEST_BUCKETS        16U
+#define RNG_TEST_PER_BUCKET     1000U
+#define RNG_TEST_LIMIT_X1000    30578U      /* χ²(15), p = 0.01 */
+
+volatile uint32_t rng_chi_square_x1000 = 0;
+volatile uint8_t rng_test_passed = 0;
+
+void RNG_SelfTest(void) {
+    uint32_t counts[RNG_TEST_BUCKETS] = {0};
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < RNG_TEST_BUCKETS * RNG_TEST_PER_BUCKET; i++) {
+        while (rng_head == rng_tail);   /* Boot only: wait for the pool */
+        counts[RNG_Below(RNG_TEST_BUCKETS)]++;
+    }
+    for (uint32_t b = 0; b < RNG_TEST_BUCKETS; b++) {
+        int32_t diff = (int32_t)counts[b] - (int32_t)RNG_TEST_PER_BUCKET;
+        sum += (uint32_t)(diff * diff);
+    }
+
+    /* Σ diff² / 1000, scaled ×1000 → just Σ diff² */
+    rng_chi_square_x1000 = sum;
+    rng_test_passed = (sum < RNG_TEST_LIMIT_X1000);
 }
 
 /* ============================================================================
@@ -594,7 +833,8 @@ typedef enum {
 volatile GameState game_state = STATE_WAITING;
 volatile uint32_t start_time = 0;
 volatile uint32_t reaction_time = 0;
-volatile uint8_t button_pressed = 0;
+volatile uint8_t button_edge_pending = 0;
+volatile uint32_t button_edge_time = 0;
 
 /* ============================================================================
  * 
@@ -617,12 +857,15 @@ void EXTI15_10_IRQHandler(void) {
         /* ✏️ YOUR TURN: Clear the pending bit */
         EXTI->PR1 = ???;        /* HINT: EXTI_LINE13 (write 1 to clear!) */
         
-        /* Record button press */
-        button_pressed = 1;
-        
-        /* Capture reaction time if in READY state */
-        if (game_state == STATE_READY) {
-            reaction_time = TIM2->CNT - start_time;
+        /* Record only the FIRST edge of a bounce burst */
+        if (!button_edge_pending) {
+            button_edge_time = TIM2->CNT;
+            button_edge_pending = 1;
+            
+            /* Capture reaction time if in READY state */
+            if (game_state == STATE_READY) {
+                reaction_time = button_edge_time - start_time;
+            }
         }
     }
 }
@@ -633,14 +876,50 @@ void EXTI15_10_IRQHandler(void) {
  * void EXTI15_10_IRQHandler(void) {
  *     if (EXTI->PR1 & EXTI_LINE13) {
  *         EXTI->PR1 = EXTI_LINE13;
- *         button_pressed = 1;
- *         if (game_state == STATE_READY) {
- *             reaction_time = TIM2->CNT - start_time;
+ *         if (!button_edge_pending) {
+ *             button_edge_time = TIM2->CNT;
+ *             button_edge_pending = 1;
+ *             if (game_state == STATE_READY) {
+ *                 reaction_time = button_edge_time - start_time;
+ *             }
  *         }
  *     }
  * }
  * ───────────────────────────────────────────────────────────────────────────── */
 
+/* ============================================================================
+ * 
+ *  STEP 6b: NON-BLOCKING DEBOUNCE
+ *  ================================
+ * 
+ *  📚 NEW CONCEPT: DEBOUNCE WINDOW
+ *  ─────────────────────────────────────────────────────────────────────────
+ *  
+ *  A button bounces for a few ms, so EXTI fires several times per press.
+ *  The ISR above keeps only the FIRST edge (that is the true reaction
+ *  time!). The main loop then waits for the contacts to settle:
+ *  
+ *  • Window not over yet      → "not yet", keep running the game loop
+ *  • Window over, pin LOW     → real press
+ *  • Window over, pin HIGH    → it was release bounce, ignore it
+ *  
+ *  No delay_ms() - the CPU is never blocked by the button.
+ * 
+ * ============================================================================ */
+
+#define BUTTON_DEBOUNCE_US      20000U      /* 20 ms settle window */
+
+uint8_t Button_Debounced(void) {
+    if (!button_edge_pending) {
+        return 0;
+    }
+    if ((TIM2->CNT - button_edge_time) < BUTTON_DEBOUNCE_US) {
+        return 0;
+    }
+    button_edge_pending = 0;
+    return !(GPIOC->IDR & (1U << BUTTON_PIN));
+}
+
 /* ============================================================================
  *  RESULT DISPLAY FUNCTIONS
  * ============================================================================ */
@@ -705,8 +984,9 @@ int main(void) {
     ConfigureTimer();
     ConfigureEXTI();
     
-    /* Seed random number generator */
-    random_init();
+    /* Hardware RNG, then check it before trusting it */
+    RNG_Init();
+    RNG_SelfTest();
     
     /* Start with all LEDs off */
     LED_AllOff();
@@ -720,7 +1000,7 @@ int main(void) {
                  * WAITING STATE: Random delay before showing green
                  * ═══════════════════════════════════════════════════════════ */
                 LED_AllOff();
-                button_pressed = 0;
+                button_edge_pending = 0;
                 
                 /* Generate random delay: 1000-5000 ms */
                 random_delay = random_range(1000, 5000);
@@ -728,7 +1008,7 @@ int main(void) {
                 
                 /* Wait for random time, checking for cheating */
                 while ((TIM2->CNT - wait_start) < (random_delay * 1000)) {
-                    if (button_pressed) {
+                    if (Button_Debounced()) {
                         /* Cheater! Pressed before green light */
                         game_state = STATE_CHEATED;
                         break;
@@ -745,15 +1025,18 @@ int main(void) {
                 /* ═══════════════════════════════════════════════════════════
                  * READY STATE: Green ON, measure reaction time
                  * ═══════════════════════════════════════════════════════════ */
-                button_pressed = 0;
                 reaction_time = 0;
                 
                 /* Turn on green LED and record start time */
                 LED_GreenOn();
                 start_time = TIM2->CNT;
                 
+                /* A press in the last 20 ms of WAITING is still settling -
+                 * it came before the light, so it must not count as 0 ms */
+                button_edge_pending = 0;
+
                 /* Wait for button press (interrupt will capture time) */
-                while (!button_pressed);
+                while (!Button_Debounced());
                 
                 LED_GreenOff();
                 game_state = STATE_RESULT;
@@ -776,10 +1059,9 @@ int main(void) {
                     ShowSlow();             /* > 400 ms = Slow */
                 }
                 
-                /* Wait for button to restart */
-                button_pressed = 0;
-                delay_ms(500);      /* Debounce delay */
-                while (!button_pressed);
+                /* Wait for a fresh press to restart */
+                button_edge_pending = 0;
+                while (!Button_Debounced());
                 
                 game_state = STATE_WAITING;
                 break;
@@ -790,10 +1072,9 @@ int main(void) {
                  * ═══════════════════════════════════════════════════════════ */
                 ShowCheated();
                 
-                /* Wait for button to restart */
-                button_pressed = 0;
-                delay_ms(500);      /* Debounce delay */
-                while (!button_pressed);
+                /* Wait for a fresh press to restart */
+                button_edge_pending = 0;
+                while (!Button_Debounced());
                 
                 game_state = STATE_WAITING;
                 break;
@@ -824,6 +1105,7 @@ int main(void) {
  *  ✅ EXTI: External interrupt configuration
  *  ✅ NVIC: Enabling interrupts and handler implementation
  *  ✅ State Machines: Managing complex program flow
+ *  ✅ RNG: Error recovery, an interrupt-fed pool, unbiased ranges
  *  ✅ Volatile: Proper use with interrupt-modified variables
  *  ✅ Bit Manipulation: All the |=, &=~, << operations
  *  
@@ -835,5 +1117,8 @@ int main(void) {
  *  • Make it harder by using shorter green light durations
  *  • Add a countdown (3-2-1) before the game starts
  *  • Make it multiplayer (first to press wins)
+ *  • Blink red at boot when rng_test_passed is 0
+ *  • Self-test "x % n" with n = 3 × 2^30 (bucket = result / (n / 16)):
+ *    results below 2^30 come up twice as often - watch χ² explode
  * 
  * ============================================================================ */
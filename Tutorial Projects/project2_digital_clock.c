@@ -39,6 +39,7 @@
  *  • Button short press: Show current time
  *  • Button long press (2s): Set alarm (current time + 10 seconds)
  *  • When alarm triggers: All LEDs flash rapidly!
+ *  • Event driven: the core SLEEPS until the RTC or the button wakes it
  *  
  *  
  *  CONCEPTS COMBINED IN THIS PROJECT:
@@ -50,9 +51,9 @@
  *  │ RCC             │ Enable clocks for RTC, GPIO, PWR, EXTI           │
  *  │ RTC             │ Keep real time, even during low power            │
  *  │ GPIO            │ LED outputs, button input                        │
- *  │ TIM             │ Debouncing, LED timing                           │
+ *  │ TIM             │ Edge timestamps, one-shot LED pulse              │
  *  │ PWR             │ Backup domain access for RTC                     │
- *  │ EXTI            │ Button interrupt, RTC alarm interrupt            │
+ *  │ EXTI            │ Button edges, RTC wakeup and alarm interrupts    │
  *  │ NVIC            │ Interrupt priorities and handling                │
  *  └─────────────────┴──────────────────────────────────────────────────┘
  *  
@@ -74,6 +75,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 
 /* ============================================================================
  *  PERIPHERAL BASE ADDRESSES
@@ -177,29 +179,33 @@ typedef struct {
 typedef struct {
     volatile uint32_t TR;
     volatile uint32_t DR;
-    volatile uint32_t SSR;
-    volatile uint32_t ICSR;
+    volatile uint32_t CR;
+    volatile uint32_t ISR;
     volatile uint32_t PRER;
     volatile uint32_t WUTR;
-    volatile uint32_t CR;
-    volatile uint32_t RESERVED1[2];
+    volatile uint32_t RESERVED0;
+    volatile uint32_t ALRMAR;
+    volatile uint32_t ALRMBR;
     volatile uint32_t WPR;
-    volatile uint32_t CALR;
+    volatile uint32_t SSR;
     volatile uint32_t SHIFTR;
     volatile uint32_t TSTR;
     volatile uint32_t TSDR;
     volatile uint32_t TSSSR;
-    volatile uint32_t RESERVED2;
-    volatile uint32_t ALRMAR;
+    volatile uint32_t CALR;
+    volatile uint32_t TAMPCR;
     volatile uint32_t ALRMASSR;
-    volatile uint32_t ALRMBR;
     volatile uint32_t ALRMBSSR;
-    volatile uint32_t SR;
-    volatile uint32_t MISR;
-    volatile uint32_t RESERVED3;
-    volatile uint32_t SCR;
+    volatile uint32_t OR;
+    volatile uint32_t BKPR[32];
 } RTC_TypeDef;
 
+/* Offsets from RM0433 - a miscounted RESERVED word fails the build */
+_Static_assert(offsetof(RTC_TypeDef, ISR) == 0x0C, "RTC_ISR offset");
+_Static_assert(offsetof(RTC_TypeDef, ALRMAR) == 0x1C, "RTC_ALRMAR offset");
+_Static_assert(offsetof(RTC_TypeDef, WPR) == 0x24, "RTC_WPR offset");
+_Static_assert(offsetof(RTC_TypeDef, BKPR) == 0x50, "RTC_BKP0R offset");
+
 typedef struct {
     volatile uint32_t RTSR1;
     volatile uint32_t FTSR1;
@@ -250,6 +256,8 @@ typedef struct {
     volatile uint32_t CNT;
     volatile uint32_t PSC;
     volatile uint32_t ARR;
+    volatile uint32_t RCR;
+    volatile uint32_t CCR1;
 } TIM_TypeDef;
 
 /* Peripheral Pointers */
@@ -288,13 +296,18 @@ typedef struct {
 /* RTC */
 #define RTC_WPR_KEY1            0xCA
 #define RTC_WPR_KEY2            0x53
-#define RTC_ICSR_INIT           (1U << 7)
-#define RTC_ICSR_INITF          (1U << 6)
-#define RTC_ICSR_RSF            (1U << 5)
+#define RTC_ISR_INIT            (1U << 7)
+#define RTC_ISR_INITF           (1U << 6)
+#define RTC_ISR_RSF             (1U << 5)
+#define RTC_ISR_WUTWF           (1U << 2)   /* Wakeup timer write allowed */
+#define RTC_CR_WUCKSEL_Msk      (7U << 0)   /* Wakeup clock select */
+#define RTC_CR_WUCKSEL_1HZ      (4U << 0)   /* ck_spre = 1 Hz */
 #define RTC_CR_ALRAE            (1U << 8)   /* Alarm A enable */
+#define RTC_CR_WUTE             (1U << 10)  /* Wakeup timer enable */
 #define RTC_CR_ALRAIE           (1U << 12)  /* Alarm A interrupt enable */
-#define RTC_SR_ALRAF            (1U << 0)   /* Alarm A flag */
-#define RTC_SCR_CALRAF          (1U << 0)   /* Clear alarm A flag */
+#define RTC_CR_WUTIE            (1U << 14)  /* Wakeup interrupt enable */
+#define RTC_ISR_ALRAF           (1U << 8)   /* Alarm A flag (write 0 to clear) */
+#define RTC_ISR_WUTF            (1U << 10)  /* Wakeup flag (write 0 to clear) */
 #define RTC_ALRMAR_MSK4         (1U << 31)  /* Mask day */
 #define RTC_ALRMAR_MSK3         (1U << 23)  /* Mask hours */
 #define RTC_ALRMAR_MSK2         (1U << 15)  /* Mask minutes */
@@ -302,13 +315,18 @@ typedef struct {
 
 /* TIM */
 #define TIM_CR1_CEN             (1U << 0)
+#define TIM_DIER_CC1IE          (1U << 1)
+#define TIM_SR_CC1IF            (1U << 1)
 #define TIM_EGR_UG              (1U << 0)
 
 /* EXTI */
 #define EXTI_LINE13             (1U << 13)  /* Button */
 #define EXTI_LINE17             (1U << 17)  /* RTC Alarm */
+#define EXTI_LINE19             (1U << 19)  /* RTC Wakeup */
 
 /* IRQ Numbers */
+#define RTC_WKUP_IRQn           3
+#define TIM2_IRQn               28
 #define EXTI15_10_IRQn          40
 #define RTC_Alarm_IRQn          41
 
@@ -407,7 +425,7 @@ void ConfigureGPIO(void) {
  *  
  *  Layer 1: PWR->CR1 |= PWR_CR1_DBP (Backup domain access)
  *  Layer 2: RTC->WPR = 0xCA, 0x53 (Write protection keys)
- *  Layer 3: RTC->ICSR |= INIT (Initialization mode)
+ *  Layer 3: RTC->ISR |= INIT (Initialization mode)
  *  
  *  All three must be unlocked before changing time!
  * 
@@ -448,8 +466,8 @@ void ConfigureRTC(void) {
      * ═══════════════════════════════════════════════════════════════════════ */
     
     /* ✏️ YOUR TURN: Enter init mode */
-    RTC->ICSR |= ???;           /* HINT: RTC_ICSR_INIT */
-    while (!(RTC->ICSR & RTC_ICSR_INITF));
+    RTC->ISR |= ???;            /* HINT: RTC_ISR_INIT */
+    while (!(RTC->ISR & RTC_ISR_INITF));
     
     /* Set prescaler for ~1 Hz from 32 kHz LSI
      * Async = 127 (divide by 128)
@@ -469,7 +487,7 @@ void ConfigureRTC(void) {
               (DecToBcd(1));             /* Day */
     
     /* Exit initialization mode */
-    RTC->ICSR &= ~RTC_ICSR_INIT;
+    RTC->ISR &= ~RTC_ISR_INIT;
     
     /* Enable write protection */
     RTC->WPR = 0xFF;
@@ -491,14 +509,14 @@ void ConfigureRTC(void) {
  *     RTC->WPR = RTC_WPR_KEY1;
  *     RTC->WPR = RTC_WPR_KEY2;
  *     
- *     RTC->ICSR |= RTC_ICSR_INIT;
- *     while (!(RTC->ICSR & RTC_ICSR_INITF));
+ *     RTC->ISR |= RTC_ISR_INIT;
+ *     while (!(RTC->ISR & RTC_ISR_INITF));
  *     
  *     RTC->PRER = (127U << 16) | 249U;
  *     RTC->TR = (DecToBcd(12) << 16) | (DecToBcd(0) << 8) | DecToBcd(0);
  *     RTC->DR = (DecToBcd(25) << 16) | (3U << 13) | (DecToBcd(1) << 8) | DecToBcd(1);
  *     
- *     RTC->ICSR &= ~RTC_ICSR_INIT;
+ *     RTC->ISR &= ~RTC_ISR_INIT;
  *     RTC->WPR = 0xFF;
  * }
  * ───────────────────────────────────────────────────────────────────────────── */
@@ -534,8 +552,9 @@ void ConfigureButtonEXTI(void) {
     SYSCFG->EXTICR[3] &= ~(0xFU << 4);
     SYSCFG->EXTICR[3] |= (0x02U << 4);      /* Port C */
     
-    /* Falling edge (button press) */
+    /* Both edges: falling = press, rising = release */
     EXTI->FTSR1 |= EXTI_LINE13;
+    EXTI->RTSR1 |= EXTI_LINE13;
     
     /* Unmask */
     EXTI->IMR1 |= EXTI_LINE13;
@@ -578,10 +597,18 @@ void LED_YellowBlink(uint8_t count) {
     }
 }
 
+/* Start a 50 ms pulse and return at once - TIM2 compare ends it */
+#define LED_PULSE_US            50000U
+
 void LED_RedPulse(void) {
     GPIOB->BSRR = (1U << LED_RED_PIN);
-    delay_ms(50);
-    GPIOB->BSRR = (1U << (LED_RED_PIN + 16));
+    TIM2->CCR1 = TIM2->CNT + LED_PULSE_US;
+    TIM2->SR = ~TIM_SR_CC1IF;
+    TIM2->DIER |= TIM_DIER_CC1IE;
+}
+
+void ConfigurePulseTimer(void) {
+    NVIC_ISER[0] = (1U << TIM2_IRQn);
 }
 
 /* ============================================================================
@@ -604,16 +631,23 @@ typedef struct {
     uint8_t seconds;
 } Time_t;
 
+/* Every RTC register read the program makes - watch it in the debugger */
+volatile uint32_t rtc_register_reads = 0;
+
 void GetTime(Time_t *time) {
     uint32_t tr;
     
     /* Wait for shadow registers to sync */
-    RTC->ICSR &= ~RTC_ICSR_RSF;
-    while (!(RTC->ICSR & RTC_ICSR_RSF));
+    RTC->ISR &= ~RTC_ISR_RSF;
+    rtc_register_reads++;
+    do {
+        rtc_register_reads++;
+    } while (!(RTC->ISR & RTC_ISR_RSF));
     
     /* ✏️ YOUR TURN: Read the time register */
     tr = ???;                   /* HINT: RTC->TR */
-    
+    rtc_register_reads++;
+
     /* Extract BCD values and convert */
     time->hours = BcdToDec((tr >> 16) & 0x3F);
     time->minutes = BcdToDec((tr >> 8) & 0x7F);
@@ -683,6 +717,78 @@ void SetAlarm(uint8_t hours, uint8_t minutes, uint8_t seconds) {
  * RTC->CR &= ~RTC_CR_ALRAE;
  * ───────────────────────────────────────────────────────────────────────────── */
 
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: LET THE RTC WAKE YOU UP
+ *  ==========================================
+ *  
+ *  The first version of this clock asked the RTC "what time is it?" in
+ *  a tight loop, only to notice when the seconds changed. Every GetTime()
+ *  clears RSF and waits for the next shadow sync (up to 2 RTCCLK periods,
+ *  ~62 µs at 32 kHz), polling RTC->ISR the whole time:
+ *  
+ *  ┌──────────────────────────┬───────────────────┬──────────────────┐
+ *  │ One hour, estimated      │ Polling GetTime() │ Wakeup interrupt │
+ *  ├──────────────────────────┼───────────────────┼──────────────────┤
+ *  │ RTC shadow resyncs       │ ~55 million       │ 0                │
+ *  │ RTC register reads       │ ~10 billion       │ ~3,600           │
+ *  │ Core                     │ 100 % busy        │ asleep (WFI)     │
+ *  └──────────────────────────┴───────────────────┴──────────────────┘
+ *  (the 50 ms LED pulse every second is subtracted from the polling time;
+ *   ~200 ISR polls per resync at 64 MHz. Button presses add a few reads.)
+ *  
+ *  The RTC already has a PERIODIC WAKEUP TIMER. Clocked from ck_spre
+ *  (the 1 Hz that drives the calendar) it fires once per second:
+ *  
+ *      period = (WUTR + 1) × 1 s       → WUTR = 0
+ *  
+ *  Like ALRAE, WUTR can only be written while the timer is stopped AND
+ *  the RTC says so: clear WUTE, then wait for WUTWF.
+ *  
+ *  rtc_register_reads counts what this program actually does - compare
+ *  it with uptime in the debugger.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ * 
+ *  STEP 8: CONFIGURE THE 1 Hz WAKEUP
+ *  ===================================
+ * 
+ * ============================================================================ */
+
+void ConfigureWakeup(void) {
+    RTC->WPR = RTC_WPR_KEY1;
+    RTC->WPR = RTC_WPR_KEY2;
+
+    /* Stop the timer and wait until WUTR may be written */
+    RTC->CR &= ~RTC_CR_WUTE;
+    while (!(RTC->ISR & RTC_ISR_WUTWF));
+
+    RTC->WUTR = 0;              /* (0 + 1) × 1 s */
+
+    /* ✏️ YOUR TURN: Clock the wakeup timer from the 1 Hz calendar clock */
+    RTC->CR &= ~RTC_CR_WUCKSEL_Msk;
+    RTC->CR |= ???;             /* HINT: RTC_CR_WUCKSEL_1HZ */
+
+    RTC->CR |= RTC_CR_WUTE | RTC_CR_WUTIE;
+    RTC->WPR = 0xFF;
+
+    /* RTC wakeup reaches the NVIC through EXTI line 19 */
+    EXTI->RTSR1 |= EXTI_LINE19;
+    EXTI->IMR1 |= EXTI_LINE19;
+    NVIC_ISER[0] = (1U << RTC_WKUP_IRQn);
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * RTC->CR |= RTC_CR_WUCKSEL_1HZ;
+ * 
+ * The other WUCKSEL values count RTCCLK/16..2 instead - useful for
+ * wakeups shorter than a second.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
 /* ============================================================================
  *  DISPLAY TIME ON LEDs
  * ============================================================================ */
@@ -718,19 +824,103 @@ void DisplayTime(Time_t *time) {
  *  GLOBAL VARIABLES
  * ============================================================================ */
 
-volatile uint8_t button_pressed = 0;
-volatile uint32_t button_press_time = 0;
+volatile uint8_t second_tick = 0;         /* Set by the RTC wakeup */
+volatile uint8_t button_released = 0;     /* Set on a debounced release */
+volatile uint32_t button_hold_us = 0;     /* How long it was held */
 volatile uint8_t alarm_triggered = 0;
 
+/* Debounce state, owned by the EXTI handler */
+volatile uint8_t button_down = 0;
+volatile uint32_t button_edge_time = 0;
+volatile uint32_t button_press_time = 0;
+
 /* ============================================================================
  *  INTERRUPT HANDLERS
  * ============================================================================ */
 
+/* ============================================================================
+ *  BUTTON EDGES WITH TIMESTAMPS
+ *  ============================
+ *  
+ *  Both edges interrupt. An edge counts only if the pin level CHANGED and
+ *  at least BUTTON_DEBOUNCE_US passed since the last accepted edge - the
+ *  bounce burst after each one is ignored. The hold time comes from the
+ *  two timestamps, so main never waits for the release.
+ *  
+ *      pin  ▔▔▔▔╲╱╲▁▁▁▁▁▁▁▁▁▁▁▁▁▁╱╲╱▔▔▔▔
+ *                ↑ press            ↑ release → button_released
+ *                └── hold_us ───────┘
+ * ============================================================================ */
+
+#define BUTTON_DEBOUNCE_US      20000U      /* 20 ms settle window */
+
 void EXTI15_10_IRQHandler(void) {
+    uint32_t now;
+    uint8_t down;
+
     if (EXTI->PR1 & EXTI_LINE13) {
         EXTI->PR1 = EXTI_LINE13;        /* Clear pending */
-        button_pressed = 1;
-        button_press_time = TIM2->CNT;
+
+        now = TIM2->CNT;
+        down = !(GPIOC->IDR & (1U << BUTTON_PIN));
+
+        /* ✏️ YOUR TURN: Drop bounce - same level, or too soon after the last edge */
+        if (down == button_down || ???) {   /* HINT: (now - button_edge_time) < BUTTON_DEBOUNCE_US */
+            return;
+        }
+
+        button_edge_time = now;
+        button_down = down;
+        if (down) {
+            button_press_time = now;
+        } else {
+            button_hold_us = now - button_press_time;
+            button_released = 1;
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ *  
+ * if (down == button_down || (now - button_edge_time) < BUTTON_DEBOUNCE_US) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* A tap shorter than the window loses its release edge. The next second
+ * tick notices the pin is back HIGH and closes the press. */
+void Button_CheckStuck(void) {
+    uint32_t now;
+
+    __asm volatile ("CPSID i" : : : "memory");
+    now = TIM2->CNT;
+    if (button_down && (GPIOC->IDR & (1U << BUTTON_PIN)) &&
+        (now - button_edge_time) >= BUTTON_DEBOUNCE_US) {
+        button_down = 0;
+        button_edge_time = now;
+        button_hold_us = now - button_press_time;
+        button_released = 1;
+    }
+    __asm volatile ("CPSIE i" : : : "memory");
+}
+
+void RTC_WKUP_IRQHandler(void) {
+    if (EXTI->PR1 & EXTI_LINE19) {
+        EXTI->PR1 = EXTI_LINE19;        /* Clear EXTI pending */
+    }
+
+    rtc_register_reads++;
+    if (RTC->ISR & RTC_ISR_WUTF) {
+        RTC->ISR = ~(RTC_ISR_WUTF | RTC_ISR_INIT);
+        second_tick = 1;
+    }
+}
+
+/* Ends the red heartbeat pulse */
+void TIM2_IRQHandler(void) {
+    if (TIM2->SR & TIM_SR_CC1IF) {
+        TIM2->SR = ~TIM_SR_CC1IF;
+        TIM2->DIER &= ~TIM_DIER_CC1IE;
+        GPIOB->BSRR = (1U << (LED_RED_PIN + 16));
     }
 }
 
@@ -739,9 +929,10 @@ void RTC_Alarm_IRQHandler(void) {
         EXTI->PR1 = EXTI_LINE17;        /* Clear EXTI pending */
     }
     
-    if (RTC->SR & RTC_SR_ALRAF) {
-        /* Clear alarm flag */
-        RTC->SCR = RTC_SCR_CALRAF;
+    rtc_register_reads++;
+    if (RTC->ISR & RTC_ISR_ALRAF) {
+        /* Clear alarm flag: ISR flags clear on 0, ignore 1 - keep INIT at 0 */
+        RTC->ISR = ~(RTC_ISR_ALRAF | RTC_ISR_INIT);
         alarm_triggered = 1;
     }
 }
@@ -768,6 +959,61 @@ void AlarmAnimation(void) {
     alarm_triggered = 0;
 }
 
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: SLEEPING WITHOUT MISSING AN EVENT
+ *  ====================================================
+ *  
+ *  WFI (Wait For Interrupt) stops the core clock until an interrupt is
+ *  pending. The naive version has a hole:
+ *  
+ *      if (!second_tick) {     ← tick arrives HERE...
+ *          WFI();              ← ...and we sleep until the NEXT one
+ *      }
+ *  
+ *  The fix: mask interrupts (PRIMASK) around the check. A pending
+ *  interrupt still WAKES the core from WFI even while masked - it just
+ *  isn't taken until CPSIE re-enables interrupts, right after:
+ *  
+ *      CPSID i → check flags → WFI → CPSIE i → handler runs → handle event
+ * 
+ * ============================================================================ */
+
+uint8_t EventPending(void) {
+    return second_tick || button_released || alarm_triggered;
+}
+
+/* ============================================================================
+ * 
+ *  STEP 9: SLEEP UNTIL THE NEXT EVENT
+ *  ====================================
+ * 
+ * ============================================================================ */
+
+volatile uint32_t wakeups = 0;
+
+void SleepUntilEvent(void) {
+    __asm volatile ("CPSID i" : : : "memory");
+
+    /* ✏️ YOUR TURN: Only sleep if nothing is waiting */
+    if (???) {                  /* HINT: !EventPending() */
+        __asm volatile ("DSB" : : : "memory");
+        __asm volatile ("WFI");
+    }
+
+    __asm volatile ("CPSIE i" : : : "memory");
+    wakeups++;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (!EventPending()) {
+ * 
+ * DSB makes sure every write before it (LED, flag clears) has completed
+ * before the clock stops.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
 /* ============================================================================
  * 
  *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
@@ -783,30 +1029,33 @@ void AlarmAnimation(void) {
 
 int main(void) {
     Time_t current_time;
-    uint32_t last_second = 0;
     uint32_t button_hold_time;
     
     /* Initialize */
     EnableClocks();
     ConfigureGPIO();
     ConfigureTimer();
+    ConfigurePulseTimer();
     ConfigureRTC();
+    ConfigureWakeup();
     ConfigureButtonEXTI();
     
     LED_AllOff();
     
     for (;;) {
-        /* Get current time */
-        GetTime(&current_time);
-        
+        /* Nothing to do until an interrupt says otherwise */
+        SleepUntilEvent();
+
         /* ═══════════════════════════════════════════════════════════════════
-         * HEARTBEAT: Red LED pulses every second
+         * HEARTBEAT: Red LED pulses on every RTC wakeup (1 Hz)
+         * No RTC read needed - the interrupt IS the new second
          * ═══════════════════════════════════════════════════════════════════ */
-        if (current_time.seconds != last_second) {
-            last_second = current_time.seconds;
+        if (second_tick) {
+            second_tick = 0;
             LED_RedPulse();
+            Button_CheckStuck();
         }
-        
+
         /* ═══════════════════════════════════════════════════════════════════
          * ALARM CHECK
          * ═══════════════════════════════════════════════════════════════════ */
@@ -819,14 +1068,10 @@ int main(void) {
          * Short press (< 2s) = Show time
          * Long press (>= 2s) = Set alarm for 10 seconds from now
          * ═══════════════════════════════════════════════════════════════════ */
-        if (button_pressed) {
-            button_pressed = 0;
-            
-            /* Wait for button release and measure hold time */
-            while (!(GPIOC->IDR & (1U << BUTTON_PIN)));     /* Wait for release */
-            button_hold_time = (TIM2->CNT - button_press_time) / 1000;  /* ms */
-            
-            delay_ms(50);       /* Debounce */
+        if (button_released) {
+            /* Hold time was measured between the two edge timestamps */
+            button_released = 0;
+            button_hold_time = button_hold_us / 1000;   /* ms */
             
             if (button_hold_time >= 2000) {
                 /* Long press: Set alarm for 10 seconds from now */
@@ -862,6 +1107,8 @@ int main(void) {
  *  
  *  1. Flash this code to your Nucleo board
  *  2. Watch the RED LED pulse every second (heartbeat)
+ *     • Between pulses the core is asleep - pause the debugger and it
+ *       sits on the WFI; rtc_register_reads grows by ~1 per second
  *  3. Short press button: Time is displayed
  *     • Green blinks = Hours (1-12)
  *     • Yellow blinks = Tens of minutes (0-5)
@@ -876,10 +1123,12 @@ int main(void) {
  *  ✅ PWR: Backup domain access
  *  ✅ RTC: Write protection, initialization, time format (BCD)
  *  ✅ RTC Alarms: Configuration and interrupt handling
+ *  ✅ RTC Wakeup Timer: A 1 Hz interrupt instead of polling the calendar
+ *  ✅ WFI: Sleeping between events without a lost-wakeup race
  *  ✅ GPIO: Both input and output configuration
  *  ✅ EXTI: Multiple interrupt sources (button + RTC alarm)
  *  ✅ NVIC: Multiple interrupt handlers
- *  ✅ TIM: Using timer for delays and measuring press duration
+ *  ✅ TIM: Edge timestamps and a one-shot compare interrupt
  *  ✅ State Management: Using volatile with interrupts
  *  
  *  
@@ -888,6 +1137,7 @@ int main(void) {
  *  • Add minutes display (single digits as well as tens)
  *  • Use PWM for LED breathing effect on heartbeat
  *  • Add snooze functionality (button during alarm delays it)
+ *  • Drop to STOP mode instead of WFI sleep - the RTC keeps running
  *  • Make time adjustable with button sequences
  *  • Display AM/PM differently (e.g., blink pattern)
  * 
@@ -10,7 +10,7 @@
  *  ██║╚██╔╝██║██╔══╝     ██║   ██╔══██╗██║   ██║██║╚██╗██║██║   ██║██║╚██╔╝██║██╔══╝  
  *  ██║ ╚═╝ ██║███████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║╚██████╔╝██║ ╚═╝ ██║███████╗
  *  ╚═╝     ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝ ╚═════╝ ╚═╝     ╚═╝╚══════╝
- *
+ * 
  *  PROJECT TUTORIAL 3: LED METRONOME WITH FLASH MEMORY
  * 
  *  ════════════════════════════════════════════════════════════════════════
@@ -20,8 +20,9 @@
  *  A visual metronome that:
  *  • Blinks LEDs at a steady beat (tempo)
  *  • Button cycles through 4 preset tempos
- *  • Current tempo is SAVED to flash memory
- *  • After power cycle, it resumes at the last saved tempo!
+ *  • Tempo and beat counters live in BACKUP SRAM - saved on every change
+ *  • When the supply starts to fail, they are copied to flash
+ *  • After reset or power cycle, it resumes at the last tempo!
  *  
  *  TEMPO PRESETS:
  *  ┌──────────┬──────────┬─────────────────┐
@@ -46,6 +47,9 @@
  *  │ EXTI            │ Button interrupt to change tempo                 │
  *  │ NVIC            │ Timer and button interrupts                      │
  *  │ FLASH           │ Save/load tempo setting to persist power cycles │
+ *  │ Backup SRAM     │ Double-buffered state, rewritten on every beat   │
+ *  │ PWR (PVD)       │ Power-fail interrupt copies state to flash       │
+ *  │ CRC + DMA       │ Check settings and the firmware image            │
  *  │ State Machine   │ Manage metronome state                           │
  *  └─────────────────┴──────────────────────────────────────────────────┘
  *  
@@ -67,6 +71,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 
 /* ============================================================================
  *  PERIPHERAL BASE ADDRESSES
@@ -77,10 +82,15 @@
 #define GPIOC_BASE      0x58020800UL
 #define GPIOE_BASE      0x58021000UL
 #define FLASH_BASE      0x52002000UL
+#define PWR_BASE        0x58024800UL
+#define BKPSRAM_BASE    0x38800000UL    /* 4 KB backup SRAM */
 #define TIM2_BASE       0x40000000UL
 #define TIM3_BASE       0x40000400UL
 #define EXTI_BASE       0x58000000UL
 #define SYSCFG_BASE     0x58000400UL
+#define CRC_BASE        0x58024C00UL
+#define DMA1_BASE       0x40020000UL
+#define DMA1_Stream0    (DMA1_BASE + 0x010)
 
 #define NVIC_ISER_BASE  0xE000E100UL
 
@@ -168,7 +178,7 @@ typedef struct {
     volatile uint32_t OPTSR_CUR;
     volatile uint32_t OPTSR_PRG;
     volatile uint32_t OPTCCR;
-    volatile uint32_t RESERVED1[6];
+    volatile uint32_t RESERVED1[55];
     volatile uint32_t KEYR2;
     volatile uint32_t RESERVED2;
     volatile uint32_t CR2;
@@ -176,6 +186,45 @@ typedef struct {
     volatile uint32_t CCR2;
 } FLASH_TypeDef;
 
+/* Offsets from RM0433 - a miscounted RESERVED array fails the build */
+_Static_assert(offsetof(FLASH_TypeDef, CCR1) == 0x014, "FLASH_CCR1 offset");
+_Static_assert(offsetof(FLASH_TypeDef, KEYR2) == 0x104, "FLASH_KEYR2 offset");
+_Static_assert(offsetof(FLASH_TypeDef, CCR2) == 0x114, "FLASH_CCR2 offset");
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CSR1;
+    volatile uint32_t CR2;
+    volatile uint32_t CR3;
+} PWR_TypeDef;
+
+typedef struct {
+    volatile uint32_t DR;
+    volatile uint32_t IDR;
+    volatile uint32_t CR;
+    volatile uint32_t RESERVED0;
+    volatile uint32_t INIT;
+    volatile uint32_t POL;
+} CRC_TypeDef;
+
+_Static_assert(offsetof(CRC_TypeDef, POL) == 0x14, "CRC_POL offset");
+
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t NDTR;
+    volatile uint32_t PAR;
+    volatile uint32_t M0AR;
+    volatile uint32_t M1AR;
+    volatile uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    volatile uint32_t LISR;
+    volatile uint32_t HISR;
+    volatile uint32_t LIFCR;
+    volatile uint32_t HIFCR;
+} DMA_TypeDef;
+
 typedef struct {
     volatile uint32_t CR1;
     volatile uint32_t CR2;
@@ -234,13 +283,29 @@ typedef struct {
 #define GPIOC   ((GPIO_TypeDef *) GPIOC_BASE)
 #define GPIOE   ((GPIO_TypeDef *) GPIOE_BASE)
 #define FLASH   ((FLASH_TypeDef *) FLASH_BASE)
+#define PWR     ((PWR_TypeDef *) PWR_BASE)
 #define TIM2    ((TIM_TypeDef *) TIM2_BASE)
 #define TIM3    ((TIM_TypeDef *) TIM3_BASE)
 #define EXTI    ((EXTI_TypeDef *) EXTI_BASE)
 #define SYSCFG  ((SYSCFG_TypeDef *) SYSCFG_BASE)
+#define CRC     ((CRC_TypeDef *) CRC_BASE)
+#define DMA1    ((DMA_TypeDef *) DMA1_BASE)
+#define DMA1_S0 ((DMA_Stream_TypeDef *) DMA1_Stream0)
 
 #define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
 
+/* SCB configuration - lets the flash log walk survive an ECC bus error */
+#define SCB_CCR                 (*(volatile uint32_t *) 0xE000ED14UL)
+#define SCB_CCR_BFHFNMIGN       (1U << 8)   /* Ignore data bus faults at priority -1 */
+
+/* DWT cycle counter, for the CRC benchmark */
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
 /* ============================================================================
  *  BIT DEFINITIONS
  * ============================================================================ */
@@ -252,6 +317,44 @@ typedef struct {
 #define RCC_APB4ENR_SYSCFGEN    (1U << 1)
 #define RCC_APB1LENR_TIM2EN     (1U << 0)
 #define RCC_APB1LENR_TIM3EN     (1U << 1)
+#define RCC_AHB4ENR_CRCEN       (1U << 19)
+#define RCC_AHB1ENR_DMA1EN      (1U << 0)
+#define RCC_AHB4ENR_BKPRAMEN    (1U << 28)
+
+/* RCC reset status: why did we boot? */
+#define RCC_RSR_RMVF            (1U << 16)  /* Write 1 to clear the flags */
+#define RCC_RSR_PINRSTF         (1U << 22)
+#define RCC_RSR_PORRSTF         (1U << 23)
+#define RCC_RSR_SFTRSTF         (1U << 24)
+#define RCC_RSR_IWDG1RSTF       (1U << 26)
+
+/* PWR */
+#define PWR_CR1_PVDE            (1U << 4)   /* Programmable voltage detector */
+#define PWR_CR1_PLS_Msk         (7U << 5)
+#define PWR_CR1_PLS_2V85        (6U << 5)   /* Trip level: VDD below 2.85 V */
+#define PWR_CR1_DBP             (1U << 8)   /* Backup domain write access */
+#define PWR_CSR1_PVDO           (1U << 4)   /* VDD is below the PVD level */
+#define PWR_CR2_BREN            (1U << 0)   /* Backup regulator enable */
+#define PWR_CR2_BRRDY           (1U << 16)  /* Backup regulator ready */
+
+/* CRC */
+#define CRC_CR_RESET            (1U << 0)   /* Load INIT into the calculator */
+#define CRC_CR_POLYSIZE_Pos     3U          /* 0 = 32, 1 = 16, 2 = 8 bit */
+#define CRC_CR_REV_IN_Msk       (3U << 5)
+#define CRC_CR_REV_IN_BYTE      (1U << 5)   /* Bit-reverse each byte */
+#define CRC_CR_REV_IN_WORD      (3U << 5)   /* Bit-reverse each 32-bit word */
+#define CRC_CR_REV_OUT          (1U << 7)   /* Bit-reverse the result */
+
+/* DMA (stream 0) */
+#define DMA_CR_EN               (1U << 0)
+#define DMA_CR_DIR_M2M          (2U << 6)
+#define DMA_CR_PINC             (1U << 9)
+#define DMA_CR_PSIZE_32         (2U << 11)
+#define DMA_CR_MSIZE_32         (2U << 13)
+#define DMA_FCR_FTH_FULL        (3U << 0)
+#define DMA_FCR_DMDIS           (1U << 2)   /* FIFO mode - required for M2M */
+#define DMA_LISR_TEIF0          (1U << 3)
+#define DMA_LISR_TCIF0          (1U << 5)
 
 /* TIM */
 #define TIM_CR1_CEN             (1U << 0)
@@ -263,6 +366,15 @@ typedef struct {
 #define FLASH_SR_BSY            (1U << 0)
 #define FLASH_SR_QW             (1U << 2)
 #define FLASH_SR_EOP            (1U << 16)
+#define FLASH_SR_WRPERR         (1U << 17)
+#define FLASH_SR_PGSERR         (1U << 18)
+#define FLASH_SR_STRBERR        (1U << 19)
+#define FLASH_SR_INCERR         (1U << 21)
+#define FLASH_SR_OPERR          (1U << 22)
+#define FLASH_SR_SNECCERR       (1U << 25)  /* Single-bit error, corrected */
+#define FLASH_SR_DBECCERR       (1U << 26)  /* Double-bit error, data lost */
+#define FLASH_SR_ERRORS         (FLASH_SR_WRPERR | FLASH_SR_PGSERR | \
+                                 FLASH_SR_STRBERR | FLASH_SR_INCERR | FLASH_SR_OPERR)
 #define FLASH_CR_LOCK           (1U << 0)
 #define FLASH_CR_PG             (1U << 1)
 #define FLASH_CR_SER            (1U << 2)
@@ -273,8 +385,10 @@ typedef struct {
 
 /* EXTI */
 #define EXTI_LINE13             (1U << 13)
+#define EXTI_LINE16             (1U << 16)  /* PVD output */
 
 /* IRQ Numbers */
+#define PVD_AVD_IRQn            1
 #define TIM3_IRQn               29
 #define EXTI15_10_IRQn          40
 
@@ -332,19 +446,28 @@ typedef enum {
 /* BPM values for each tempo */
 const uint16_t tempo_bpm[TEMPO_COUNT] = {60, 90, 120, 180};
 
-/* Settings structure (must be 32-byte aligned for flash writes) */
+/* Settings record: one flash word (32 bytes), stored in backup SRAM
+ * and appended to the flash log unchanged */
 typedef struct __attribute__((aligned(32))) {
     uint32_t magic;         /* 0xDEADBEEF if valid */
+    uint32_t sequence;      /* +1 per save - the highest one is the newest */
     uint32_t tempo_index;   /* 0-3 */
-    uint8_t padding[24];    /* Pad to 32 bytes */
+    uint32_t boot_count;
+    uint32_t tempo_changes;
+    uint32_t beats;         /* Every beat ever played */
+    uint32_t reset_flags;   /* RCC->RSR at the last boot */
+    uint32_t crc;           /* CRC-32 of the fields above */
 } Settings_t;
 
+_Static_assert(sizeof(Settings_t) == 32, "Settings_t must be one flash word");
+
 /* ============================================================================
  *  GLOBAL VARIABLES
  * ============================================================================ */
 
 volatile uint8_t beat_tick = 0;
-volatile uint8_t button_pressed = 0;
+volatile uint8_t button_edge_pending = 0;
+volatile uint32_t button_edge_time = 0;
 volatile Tempo_t current_tempo = TEMPO_ANDANTE;
 
 /* ============================================================================
@@ -366,6 +489,10 @@ void EnableClocks(void) {
     /* Enable TIM2 for delays, TIM3 for metronome beat */
     RCC->APB1LENR |= RCC_APB1LENR_TIM2EN;
     RCC->APB1LENR |= RCC_APB1LENR_TIM3EN;
+
+    /* CRC unit, and DMA1 to feed it */
+    RCC->AHB4ENR |= RCC_AHB4ENR_CRCEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
     
     (void)RCC->APB4ENR;
 }
@@ -428,6 +555,29 @@ void delay_ms(uint32_t ms) {
     while ((TIM2->CNT - start) < (ms * 1000));
 }
 
+/* ============================================================================
+ *  NON-BLOCKING BUTTON DEBOUNCE
+ *  ============================
+ *  
+ *  A delay_ms(50) after every press would make the next beat late.
+ *  The EXTI handler stamps the first edge of a bounce burst with TIM2;
+ *  the main loop accepts the press only after the contacts have settled
+ *  and the pin still reads LOW. Release bounce reads HIGH and is dropped.
+ * ============================================================================ */
+
+#define BUTTON_DEBOUNCE_US      20000U      /* 20 ms settle window */
+
+uint8_t Button_Debounced(void) {
+    if (!button_edge_pending) {
+        return 0;
+    }
+    if ((TIM2->CNT - button_edge_time) < BUTTON_DEBOUNCE_US) {
+        return 0;
+    }
+    button_edge_pending = 0;
+    return !(GPIOC->IDR & (1U << BUTTON_PIN));
+}
+
 /* ============================================================================
  * 
  *  STEP 4: CONFIGURE METRONOME TIMER (TIM3)
@@ -564,8 +714,8 @@ void Flash_EraseSector(uint32_t sector) {
     Flash_Unlock();
     Flash_WaitBusy();
     
-    /* Clear any previous errors */
-    FLASH->CCR1 = 0x1EFF0000;
+    /* Clear any previous errors (CCR1 bits mirror SR1) */
+    FLASH->CCR1 = FLASH_SR_ERRORS | FLASH_SR_EOP;
     
     /* Set sector erase and sector number */
     FLASH->CR1 &= ~(7U << 8);           /* Clear SNB bits */
@@ -588,8 +738,8 @@ void Flash_Program256Bits(uint32_t address, uint32_t *data) {
     Flash_Unlock();
     Flash_WaitBusy();
     
-    /* Clear any previous errors */
-    FLASH->CCR1 = 0x1EFF0000;
+    /* Clear any previous errors (CCR1 bits mirror SR1) */
+    FLASH->CCR1 = FLASH_SR_ERRORS | FLASH_SR_EOP;
     
     /* Enable programming */
     FLASH->CR1 |= FLASH_CR_PG;
@@ -612,6 +762,320 @@ void Flash_Program256Bits(uint32_t address, uint32_t *data) {
     Flash_Lock();
 }
 
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: CRC - IS THIS DATA STILL WHAT I WROTE?
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  A magic word only says "someone wrote here once". A half-finished
+ *  write, a worn-out cell or a flipped bit keep the magic and break the
+ *  data. A CRC is a checksum over EVERY byte.
+ * 
+ *  A CRC variant is 5 numbers:
+ * 
+ *  ┌──────────────────┬───────┬──────────┬────────┬─────────┬─────────┐
+ *  │ Name             │ Width │ Poly     │ Init   │ Reflect │ XorOut  │
+ *  ├──────────────────┼───────┼──────────┼────────┼─────────┼─────────┤
+ *  │ CRC-32 (zlib)    │ 32    │ 04C11DB7 │ all 1s │ yes     │ all 1s  │
+ *  │ CRC-16/CCITT     │ 16    │ 1021     │ FFFF   │ no      │ 0       │
+ *  │ CRC-8/SMBUS      │ 8     │ 07       │ 00     │ no      │ 0       │
+ *  └──────────────────┴───────┴──────────┴────────┴─────────┴─────────┘
+ * 
+ *  "Reflect" means bytes go in LSB first. The CRC unit does that with
+ *  REV_IN/REV_OUT, and it has no XorOut - software applies that last.
+ * 
+ *  Three ways to compute it:
+ *  • Software, 256-entry table: one lookup per byte, works anywhere
+ *    (and on the PC that builds the firmware image)
+ *  • CRC unit fed by the CPU: one 32-bit write per 4 bytes
+ *  • CRC unit fed by DMA: the CPU is free while a whole flash bank
+ *    streams through
+ * 
+ *  CRC_Benchmark() measures all three on your board and checks they agree.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    uint8_t width;          /* 8, 16 or 32 */
+    uint8_t reflect;        /* 1 = LSB first, in and out */
+    uint32_t poly;
+    uint32_t init;
+    uint32_t xorout;
+} CrcConfig_t;
+
+const CrcConfig_t CRC_32       = { 32, 1, 0x04C11DB7U, 0xFFFFFFFFU, 0xFFFFFFFFU };
+const CrcConfig_t CRC_16_CCITT = { 16, 0, 0x1021U,     0xFFFFU,     0x0000U };
+const CrcConfig_t CRC_8_SMBUS  = { 8,  0, 0x07U,       0x00U,       0x00U };
+
+uint32_t Crc_Mask(const CrcConfig_t *cfg) {
+    return (cfg->width == 32) ? 0xFFFFFFFFU : ((1U << cfg->width) - 1U);
+}
+
+/* ============================================================================
+ * 
+ *  STEP 6b: THE CRC UNIT
+ *  ======================
+ * 
+ *  Begin → Update (as often as you like) → Final. The unit holds one
+ *  calculation at a time.
+ * 
+ * ============================================================================ */
+
+const CrcConfig_t *crc_active = NULL;
+
+void CRC_Begin(const CrcConfig_t *cfg) {
+    uint32_t cr;
+
+    cr = ((cfg->width == 32) ? 0U : (cfg->width == 16) ? 1U : 2U) << CRC_CR_POLYSIZE_Pos;
+    if (cfg->reflect) {
+        cr |= CRC_CR_REV_IN_WORD | CRC_CR_REV_OUT;
+    }
+
+    CRC->POL = cfg->poly;
+    CRC->INIT = cfg->init;
+
+    /* ✏️ YOUR TURN: Apply the settings and load INIT in one write */
+    CRC->CR = cr | ???;             /* HINT: CRC_CR_RESET */
+
+    crc_active = cfg;
+}
+
+/* Single bytes: 8-bit writes to DR, reflected byte by byte */
+void CRC_WriteBytes(const uint8_t *data, uint32_t len) {
+    uint32_t cr = CRC->CR;
+
+    if (len == 0) {
+        return;
+    }
+    if (crc_active->reflect) {
+        CRC->CR = (cr & ~CRC_CR_REV_IN_Msk) | CRC_CR_REV_IN_BYTE;
+    }
+    while (len--) {
+        *(volatile uint8_t *)&CRC->DR = *data++;
+    }
+    CRC->CR = cr & ~CRC_CR_RESET;
+}
+
+void CRC_Update(const uint8_t *data, uint32_t len) {
+    uint32_t head = (4U - ((uint32_t)data & 3U)) & 3U;
+
+    if (head > len) {
+        head = len;
+    }
+    CRC_WriteBytes(data, head);
+    data += head;
+    len -= head;
+
+    /* Aligned middle: 4 bytes per write. Memory is little-endian, so a
+     * non-reflected CRC (MSB of the FIRST byte first) needs the bytes
+     * swapped; a reflected one gets it right from REV_IN = word. */
+    while (len >= 4) {
+        uint32_t word = *(const uint32_t *)data;
+        CRC->DR = crc_active->reflect ? word : __builtin_bswap32(word);
+        data += 4;
+        len -= 4;
+    }
+
+    CRC_WriteBytes(data, len);
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * CRC->CR = cr | CRC_CR_RESET;
+ * 
+ * RESET clears itself once INIT is loaded.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+uint32_t CRC_Final(void) {
+    return (CRC->DR ^ crc_active->xorout) & Crc_Mask(crc_active);
+}
+
+/* Large regions: DMA1 stream 0 copies words from memory into CRC->DR.
+ * Reflected CRCs only (no byte swap in DMA). Source must be DMA
+ * reachable - flash, AXI SRAM or SRAM1-3, not DTCM. Returns 0 or -1. */
+#define CRC_DMA_MAX_WORDS       65535U      /* NDTR is 16 bits */
+
+int CRC_UpdateDMA(const uint32_t *words, uint32_t count) {
+    if (!crc_active->reflect) {
+        CRC_Update((const uint8_t *)words, count * 4U);
+        return 0;
+    }
+
+    while (count > 0) {
+        uint32_t chunk = (count > CRC_DMA_MAX_WORDS) ? CRC_DMA_MAX_WORDS : count;
+
+        DMA1_S0->CR &= ~DMA_CR_EN;
+        while (DMA1_S0->CR & DMA_CR_EN);
+        DMA1->LIFCR = DMA_LISR_TCIF0 | DMA_LISR_TEIF0;
+
+        /* Memory-to-memory: PAR is the source, M0AR the (fixed) target */
+        DMA1_S0->PAR = (uint32_t)words;
+        DMA1_S0->M0AR = (uint32_t)&CRC->DR;
+        DMA1_S0->NDTR = chunk;
+        DMA1_S0->FCR = DMA_FCR_DMDIS | DMA_FCR_FTH_FULL;
+        DMA1_S0->CR = DMA_CR_DIR_M2M | DMA_CR_PINC | DMA_CR_PSIZE_32 | DMA_CR_MSIZE_32;
+        DMA1_S0->CR |= DMA_CR_EN;
+
+        /* The CPU is free here - we simply wait */
+        while (!(DMA1->LISR & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0)));
+        if (DMA1->LISR & DMA_LISR_TEIF0) {
+            return -1;
+        }
+
+        words += chunk;
+        count -= chunk;
+    }
+    return 0;
+}
+
+/* ============================================================================
+ *  SOFTWARE CRC (TABLE DRIVEN)
+ *  Same numbers as the CRC unit for every config - and plain C, so the
+ *  PC tool that stamps the firmware image can use the same code.
+ * ============================================================================ */
+
+uint32_t crc_table[256];
+const CrcConfig_t *crc_table_config = NULL;
+
+uint32_t Crc_Reflect(uint32_t value, uint32_t bits) {
+    uint32_t result = 0;
+
+    for (uint32_t i = 0; i < bits; i++) {
+        result = (result << 1) | ((value >> i) & 1U);
+    }
+    return result;
+}
+
+void CrcSoft_BuildTable(const CrcConfig_t *cfg) {
+    uint32_t mask = Crc_Mask(cfg);
+    uint32_t top = 1U << (cfg->width - 1);
+    uint32_t rpoly = Crc_Reflect(cfg->poly, cfg->width);
+
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c;
+
+        if (cfg->reflect) {
+            c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1U) ? (c >> 1) ^ rpoly : (c >> 1);
+            }
+        } else {
+            c = i << (cfg->width - 8);
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & top) ? (c << 1) ^ cfg->poly : (c << 1);
+            }
+        }
+        crc_table[i] = c & mask;
+    }
+    crc_table_config = cfg;
+}
+
+uint32_t CrcSoft_Begin(const CrcConfig_t *cfg) {
+    if (crc_table_config != cfg) {
+        CrcSoft_BuildTable(cfg);
+    }
+    return cfg->reflect ? Crc_Reflect(cfg->init, cfg->width) : cfg->init;
+}
+
+uint32_t CrcSoft_Update(const CrcConfig_t *cfg, uint32_t crc,
+                        const uint8_t *data, uint32_t len) {
+    while (len--) {
+        if (cfg->reflect) {
+            crc = crc_table[(crc ^ *data++) & 0xFFU] ^ (crc >> 8);
+        } else {
+            crc = crc_table[((crc >> (cfg->width - 8)) ^ *data++) & 0xFFU] ^ (crc << 8);
+        }
+    }
+    return crc & Crc_Mask(cfg);
+}
+
+uint32_t CrcSoft_Final(const CrcConfig_t *cfg, uint32_t crc) {
+    return (crc ^ cfg->xorout) & Crc_Mask(cfg);
+}
+
+/* ============================================================================
+ *  SELF-TEST AND BENCHMARK
+ *  The standard check: the CRC of the 9 bytes "123456789".
+ * ============================================================================ */
+
+volatile uint8_t crc_self_test_ok = 0;
+
+/* Results - watch them in the debugger (cycles per KB) */
+volatile uint32_t crc_bench_soft = 0;
+volatile uint32_t crc_bench_hw_cpu = 0;
+volatile uint32_t crc_bench_hw_dma = 0;
+volatile uint8_t crc_bench_match = 0;
+
+uint8_t CRC_CheckConfig(const CrcConfig_t *cfg, uint32_t expected) {
+    static const uint8_t check[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    uint32_t soft;
+
+    soft = CrcSoft_Final(cfg, CrcSoft_Update(cfg, CrcSoft_Begin(cfg), check, 9));
+    CRC_Begin(cfg);
+    CRC_Update(check, 9);
+
+    return (soft == expected) && (CRC_Final() == expected);
+}
+
+#define CRC_BENCH_ADDR          0x08000000UL    /* Our own code */
+#define CRC_BENCH_BYTES         (64U * 1024U)
+
+void CRC_Benchmark(void) {
+    const uint8_t *data = (const uint8_t *)CRC_BENCH_ADDR;
+    uint32_t start, soft, cpu, dma;
+
+    crc_self_test_ok = CRC_CheckConfig(&CRC_32, 0xCBF43926U) &&
+                       CRC_CheckConfig(&CRC_16_CCITT, 0x29B1U) &&
+                       CRC_CheckConfig(&CRC_8_SMBUS, 0xF4U);
+
+    DEMCR |= DEMCR_TRCENA;
+    DWT_LAR = 0xC5ACCE55;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    start = DWT_CYCCNT;
+    soft = CrcSoft_Final(&CRC_32, CrcSoft_Update(&CRC_32, CrcSoft_Begin(&CRC_32),
+                                                 data, CRC_BENCH_BYTES));
+    crc_bench_soft = (DWT_CYCCNT - start) / 64U;
+
+    start = DWT_CYCCNT;
+    CRC_Begin(&CRC_32);
+    CRC_Update(data, CRC_BENCH_BYTES);
+    cpu = CRC_Final();
+    crc_bench_hw_cpu = (DWT_CYCCNT - start) / 64U;
+
+    start = DWT_CYCCNT;
+    CRC_Begin(&CRC_32);
+    CRC_UpdateDMA((const uint32_t *)data, CRC_BENCH_BYTES / 4U);
+    dma = CRC_Final();
+    crc_bench_hw_dma = (DWT_CYCCNT - start) / 64U;
+
+    crc_bench_match = (soft == cpu) && (cpu == dma);
+}
+
+/* ============================================================================
+ *  FIRMWARE IMAGE CHECK
+ * 
+ *  The build appends the CRC-32 of the image as its last word, e.g.
+ *      srec_cat app.bin -binary -crc32-l-e <size> -o app_crc.bin -binary
+ *  A bootloader checks it before jumping; here we just report it.
+ * ============================================================================ */
+
+#define FLASH_IMAGE_ADDR        0x08000000UL
+#define FLASH_IMAGE_SIZE        0x000E0000UL    /* Sectors 0-6 */
+
+volatile uint8_t image_crc_ok = 0;
+
+uint8_t Image_Verify(uint32_t addr, uint32_t size) {
+    uint32_t stored = *(volatile uint32_t *)(addr + size - 4U);
+
+    CRC_Begin(&CRC_32);
+    if (CRC_UpdateDMA((const uint32_t *)addr, (size - 4U) / 4U) != 0) {
+        return 0;
+    }
+    return CRC_Final() == stored;
+}
+
 /* ============================================================================
  * 
  *  STEP 7: SAVE AND LOAD SETTINGS
@@ -619,37 +1083,77 @@ void Flash_Program256Bits(uint32_t address, uint32_t *data) {
  * 
  * ============================================================================ */
 
-void SaveSettings(Tempo_t tempo) {
-    Settings_t settings;
-    
-    /* Prepare settings structure */
-    settings.magic = SETTINGS_MAGIC;
-    settings.tempo_index = tempo;
-    
-    /* Fill padding with zeros */
-    for (int i = 0; i < 24; i++) {
-        settings.padding[i] = 0;
-    }
-    
-    /* Erase sector first (required before writing) */
-    Flash_EraseSector(FLASH_SETTINGS_SECTOR);
-    
-    /* Write settings */
-    Flash_Program256Bits(FLASH_SETTINGS_ADDR, (uint32_t *)&settings);
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: BACKUP SRAM INSTEAD OF FLASH WEAR
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  Erasing a flash sector takes about a second and wears it out after
+ *  ~10,000 cycles - far too slow and too costly to save on every beat.
+ *  The 4 KB backup SRAM at 0x38800000 keeps its contents through every
+ *  reset (and, with the backup regulator on, on the VBAT pin alone).
+ *  A write takes nanoseconds and never wears out.
+ * 
+ *  It is still lost when ALL power goes, so the PVD (programmable
+ *  voltage detector) raises an interrupt when VDD sags below 2.85 V.
+ *  The decoupling capacitors hold the MCU up for a few milliseconds -
+ *  enough to program one 32-byte flash word (~50 µs), never enough
+ *  to erase a sector. So the flash sector is a LOG of records,
+ *  appended in order, and erased only at boot when it is full:
+ * 
+ *     every change                     power failing (PVD)
+ *          │                                   │
+ *          ▼                                   ▼
+ *    ┌──────────────────┐  latest slot   ┌──────────────────────────┐
+ *    │ BACKUP SRAM      │ ─────────────► │ FLASH LOG (sector 7)     │
+ *    │ slot 0 │ slot 1  │                │ rec 0 │ rec 1 │ ... │ FF │
+ *    └──────────────────┘                └──────────────────────────┘
+ * 
+ *  Two slots make every save atomic: the new record goes into the slot
+ *  NOT holding the current one. A reset halfway through a write leaves
+ *  a bad CRC in that slot, and the other one is still intact. At boot,
+ *  the valid record with the highest sequence wins - backup SRAM or
+ *  flash log, whichever is newer.
+ * 
+ *  A power cut in the middle of those 50 µs leaves a half-programmed
+ *  flash word whose ECC bits do not match its data. Reading it is a
+ *  DOUBLE ECC error: the flash sets DBECCERR and answers with a bus
+ *  error, so a plain read would HardFault on every boot from then on.
+ *  The boot walk therefore copies each record with data bus faults
+ *  ignored (FAULTMASK + BFHFNMIGN), checks DBECCERR, and skips the
+ *  damaged record. A single-bit error (SNECCERR) is already corrected
+ *  in the data we read.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    Settings_t slot[2];
+} BackupSram_t;
+
+#define BACKUP_SRAM             ((BackupSram_t *) BKPSRAM_BASE)
+#define FLASH_LOG               ((const Settings_t *) FLASH_SETTINGS_ADDR)
+#define FLASH_LOG_SLOTS         (128U * 1024U / sizeof(Settings_t))
+
+Settings_t persist;                     /* Working copy */
+volatile uint32_t persist_active = 0;   /* Slot holding the newest record */
+uint32_t flash_log_next = 0;            /* First erased record in the log */
+uint32_t flash_log_sequence = 0;        /* Newest sequence already in flash */
+
+/* CRC-32 over everything before the crc field */
+uint32_t Settings_Crc(const Settings_t *settings) {
+    CRC_Begin(&CRC_32);
+    CRC_Update((const uint8_t *)settings, offsetof(Settings_t, crc));
+    return CRC_Final();
 }
 
-Tempo_t LoadSettings(void) {
-    volatile Settings_t *stored = (volatile Settings_t *)FLASH_SETTINGS_ADDR;
-    
+uint8_t Settings_Valid(const Settings_t *stored) {
     /* ✏️ YOUR TURN: Check if settings are valid */
     if (stored->magic == ???) {     /* HINT: SETTINGS_MAGIC */
-        if (stored->tempo_index < TEMPO_COUNT) {
-            return (Tempo_t)stored->tempo_index;
-        }
+        /* The magic says "written once" - the CRC says "still intact" */
+        return stored->crc == Settings_Crc(stored) &&
+               stored->tempo_index < TEMPO_COUNT;
     }
-    
-    /* Default to Andante if no valid settings */
-    return TEMPO_ANDANTE;
+    return 0;
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
@@ -658,6 +1162,165 @@ Tempo_t LoadSettings(void) {
  * if (stored->magic == SETTINGS_MAGIC) {
  * ───────────────────────────────────────────────────────────────────────────── */
 
+uint8_t Settings_Erased(const Settings_t *stored) {
+    const uint32_t *word = (const uint32_t *)stored;
+
+    for (uint32_t i = 0; i < sizeof(Settings_t) / 4U; i++) {
+        if (word[i] != 0xFFFFFFFFU) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Copy one flash log record. 0 = double ECC error, the copy is garbage */
+uint8_t Flash_ReadRecord(const Settings_t *record, Settings_t *copy) {
+    const volatile uint32_t *src = (const volatile uint32_t *)record;
+    uint32_t *dst = (uint32_t *)copy;
+    uint32_t sr;
+
+    FLASH->CCR1 = FLASH_SR_SNECCERR | FLASH_SR_DBECCERR;
+
+    /* At priority -1 with BFHFNMIGN set, the bus error of a damaged word
+     * is ignored instead of escalating to HardFault */
+    __asm volatile ("CPSID f" : : : "memory");
+    SCB_CCR |= SCB_CCR_BFHFNMIGN;
+    __asm volatile ("DSB\n\tISB" : : : "memory");
+
+    for (uint32_t i = 0; i < sizeof(Settings_t) / 4U; i++) {
+        dst[i] = src[i];
+    }
+
+    __asm volatile ("DSB" : : : "memory");
+    SCB_CCR &= ~SCB_CCR_BFHFNMIGN;
+    __asm volatile ("ISB" : : : "memory");
+    __asm volatile ("CPSIE f" : : : "memory");
+
+    sr = FLASH->SR1;
+    FLASH->CCR1 = FLASH_SR_SNECCERR | FLASH_SR_DBECCERR;
+    return !(sr & FLASH_SR_DBECCERR);
+}
+
+/* Save the working copy - about a microsecond, safe to call on every beat */
+void Persist_Commit(void) {
+    /* ✏️ YOUR TURN: Write into the slot that is NOT the newest one */
+    uint32_t next = ???;                /* HINT: persist_active with bit 0 flipped */
+    volatile uint32_t *dst = (volatile uint32_t *)&BACKUP_SRAM->slot[next];
+    const uint32_t *src = (const uint32_t *)&persist;
+
+    persist.sequence++;
+    persist.crc = Settings_Crc(&persist);
+
+    for (uint32_t i = 0; i < sizeof(Settings_t) / 4U; i++) {
+        dst[i] = src[i];
+    }
+    __asm("DSB");
+
+    /* Only a complete record becomes the newest one */
+    persist_active = next;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * uint32_t next = persist_active ^ 1U;
+ * 
+ * If the PVD interrupt arrives in the middle of the copy, it saves
+ * persist_active - the previous record, which is still whole.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Append the newest record to the flash log - no erase, ~50 µs */
+void Persist_SaveToFlash(void) {
+    const Settings_t *latest = &BACKUP_SRAM->slot[persist_active];
+
+    if (flash_log_next < FLASH_LOG_SLOTS && latest->sequence != flash_log_sequence) {
+        Flash_Program256Bits(FLASH_SETTINGS_ADDR + flash_log_next * sizeof(Settings_t),
+                             (uint32_t *)latest);
+        flash_log_next++;
+        flash_log_sequence = latest->sequence;
+    }
+}
+
+void ConfigurePVD(void) {
+    PWR->CR1 = (PWR->CR1 & ~PWR_CR1_PLS_Msk) | PWR_CR1_PLS_2V85;
+    PWR->CR1 |= PWR_CR1_PVDE;
+
+    /* The PVD output goes HIGH when VDD drops below the level */
+    EXTI->RTSR1 |= EXTI_LINE16;
+    EXTI->IMR1 |= EXTI_LINE16;
+    NVIC_ISER[0] = (1U << PVD_AVD_IRQn);
+}
+
+void Persist_Init(void) {
+    const Settings_t *best = 0;
+    Settings_t record;
+    uint32_t reset_flags = RCC->RSR;
+
+    /* Why did we boot? Clear the flags so the next reset starts fresh */
+    RCC->RSR |= RCC_RSR_RMVF;
+
+    /* Backup SRAM: clock, write access, and the regulator that keeps it
+     * alive on VBAT */
+    RCC->AHB4ENR |= RCC_AHB4ENR_BKPRAMEN;
+    (void)RCC->AHB4ENR;
+    PWR->CR1 |= PWR_CR1_DBP;
+    while (!(PWR->CR1 & PWR_CR1_DBP));
+    PWR->CR2 |= PWR_CR2_BREN;
+    while (!(PWR->CR2 & PWR_CR2_BRRDY));
+
+    /* Newest valid slot in backup SRAM (random garbage after power-up) */
+    for (uint32_t i = 0; i < 2; i++) {
+        const Settings_t *slot = &BACKUP_SRAM->slot[i];
+        if (Settings_Valid(slot) && (best == 0 || slot->sequence > best->sequence)) {
+            best = slot;
+            persist_active = i;
+        }
+    }
+
+    /* Walk the flash log up to its first erased record */
+    flash_log_next = FLASH_LOG_SLOTS;
+    for (uint32_t i = 0; i < FLASH_LOG_SLOTS; i++) {
+        if (!Flash_ReadRecord(&FLASH_LOG[i], &record)) {
+            continue;                   /* Power died while programming it */
+        }
+        if (Settings_Erased(&record)) {
+            flash_log_next = i;
+            break;
+        }
+        if (Settings_Valid(&record)) {
+            flash_log_sequence = record.sequence;
+            if (best == 0 || record.sequence > best->sequence) {
+                best = &FLASH_LOG[i];   /* Read cleanly once, safe to read again */
+            }
+        }
+    }
+
+    if (best != 0) {
+        persist = *best;
+    } else {
+        /* First boot ever: defaults */
+        persist.magic = SETTINGS_MAGIC;
+        persist.sequence = 0;
+        persist.tempo_index = TEMPO_ANDANTE;
+        persist.boot_count = 0;
+        persist.tempo_changes = 0;
+        persist.beats = 0;
+    }
+    persist.boot_count++;
+    persist.reset_flags = reset_flags;
+    Persist_Commit();
+
+    /* Log full: erase it NOW, while the supply is good, and start over */
+    if (flash_log_next == FLASH_LOG_SLOTS) {
+        Flash_EraseSector(FLASH_SETTINGS_SECTOR);
+        flash_log_next = 0;
+        flash_log_sequence = 0;
+        Persist_SaveToFlash();
+    }
+
+    ConfigurePVD();
+}
+
 /* ============================================================================
  *  LED CONTROL
  * ============================================================================ */
@@ -706,10 +1369,27 @@ void TIM3_IRQHandler(void) {
     }
 }
 
+/* VDD is falling: milliseconds left - lights out, then one flash write */
+void PVD_AVD_IRQHandler(void) {
+    if (EXTI->PR1 & EXTI_LINE16) {
+        EXTI->PR1 = EXTI_LINE16;    /* Clear pending */
+
+        if (PWR->CSR1 & PWR_CSR1_PVDO) {
+            LED_AllOff();
+            Persist_SaveToFlash();
+        }
+    }
+}
+
 void EXTI15_10_IRQHandler(void) {
     if (EXTI->PR1 & EXTI_LINE13) {
         EXTI->PR1 = EXTI_LINE13;    /* Clear pending */
-        button_pressed = 1;
+        
+        /* Only the first edge of a bounce burst starts the window */
+        if (!button_edge_pending) {
+            button_edge_time = TIM2->CNT;
+            button_edge_pending = 1;
+        }
     }
 }
 
@@ -735,10 +1415,15 @@ int main(void) {
     ConfigureDelayTimer();
     ConfigureButtonEXTI();
     
+    /* Check the CRC paths agree, time them, then check our own image */
+    CRC_Benchmark();
+    image_crc_ok = Image_Verify(FLASH_IMAGE_ADDR, FLASH_IMAGE_SIZE);
+    
     /* ═══════════════════════════════════════════════════════════════════════
-     * LOAD SAVED TEMPO (persists across power cycles!)
+     * RESTORE STATE (backup SRAM after a reset, flash log after power-off)
      * ═══════════════════════════════════════════════════════════════════════ */
-    current_tempo = LoadSettings();
+    Persist_Init();
+    current_tempo = (Tempo_t)persist.tempo_index;
     
     /* Show startup animation */
     for (int i = 0; i < TEMPO_COUNT; i++) {
@@ -764,18 +1449,17 @@ int main(void) {
             } else {
                 LED_ShowTempo(current_tempo);
                 led_on = 1;
+
+                /* A flash save per beat would wear the sector out in days */
+                persist.beats++;
+                Persist_Commit();
             }
         }
         
         /* ═══════════════════════════════════════════════════════════════════
          * HANDLE BUTTON: CYCLE TEMPO
          * ═══════════════════════════════════════════════════════════════════ */
-        if (button_pressed) {
-            button_pressed = 0;
-            
-            /* Simple debounce */
-            delay_ms(50);
-            
+        if (Button_Debounced()) {
             /* Cycle to next tempo */
             current_tempo = (Tempo_t)((current_tempo + 1) % TEMPO_COUNT);
             
@@ -783,10 +1467,13 @@ int main(void) {
             UpdateMetronomeTempo(tempo_bpm[current_tempo]);
             
             /* ═══════════════════════════════════════════════════════════════
-             * SAVE TO FLASH
-             * This takes ~1 second but tempo survives power loss!
+             * SAVE TO BACKUP SRAM
+             * Microseconds instead of a one-second flash erase - the PVD
+             * interrupt moves it to flash if the power goes
              * ═══════════════════════════════════════════════════════════════ */
-            SaveSettings(current_tempo);
+            persist.tempo_index = current_tempo;
+            persist.tempo_changes++;
+            Persist_Commit();
             
             /* Show new tempo briefly */
             LED_ShowTempo(current_tempo);
@@ -808,6 +1495,7 @@ int main(void) {
  *     • Red = 120 BPM (Allegro - fast)
  *     • All = 180 BPM (Presto - very fast)
  *  5. Turn off power, wait, turn back on - TEMPO IS PRESERVED!
+ *  6. Press RESET instead - nothing touches flash, backup SRAM has it
  *  
  *  
  *  🎓 WHAT YOU LEARNED:
@@ -816,10 +1504,13 @@ int main(void) {
  *  ✅ TIM: Generating precise periodic interrupts
  *  ✅ TIM: Calculating ARR from BPM (musical timing)
  *  ✅ GPIO: Multiple LED patterns for different states
- *  ✅ EXTI: Button handling with debouncing
+ *  ✅ EXTI: Non-blocking button debouncing
  *  ✅ NVIC: Multiple interrupt sources (timer + button)
  *  ✅ Data Structures: Aligned structures for flash storage
  *  ✅ Magic Numbers: Using signature bytes to validate stored data
+ *  ✅ CRC: Hardware unit, DMA feed and a matching table-driven fallback
+ *  ✅ Backup SRAM: double-buffered records, saved on every beat
+ *  ✅ PVD: a power-fail interrupt that appends state to a flash log
  *  
  *  
  *  📚 FLASH PROGRAMMING KEY POINTS:
@@ -835,8 +1526,11 @@ int main(void) {
  *  
  *  • Add more tempo presets
  *  • Add a "tap tempo" feature (tap button rhythmically to set BPM)
- *  • Reduce flash wear by only saving if tempo actually changed
+ *  • Watch persist.beats and persist.reset_flags in the debugger across
+ *    resets - IWDG or software resets show up in reset_flags
  *  • Add visual accent on first beat of measure (flash brighter)
  *  • Store multiple settings (tempo + other preferences)
+ *  • Flip one bit of the saved settings with the debugger - the CRC
+ *    check rejects them and the metronome falls back to 60 BPM
  * 
  * ============================================================================ */
@@ -10,7 +10,7 @@
  *  ██║     ██║   ██║██║╚██╗██║╚════██║██║   ██║██║     ██╔══╝  
  *  ╚██████╗╚██████╔╝██║ ╚████║███████║╚██████╔╝███████╗███████╗
  *   ╚═════╝ ╚═════╝ ╚═╝  ╚═══╝╚══════╝ ╚═════╝ ╚══════╝╚══════╝
- *
+ * 
  *  PROJECT TUTORIAL 4: UART COMMAND CONSOLE
  * 
  *  ════════════════════════════════════════════════════════════════════════
@@ -33,12 +33,23 @@
  *  │ S or s         │ Show STATUS (which LEDs are on)                   │
  *  │ H or h or ?    │ Show HELP menu                                    │
  *  │ P or p         │ Run PARTY mode (LED animation)                    │
+ *  │ T or t         │ Dump the event TRACE (Chrome trace JSON)          │
+ *  │ L or l         │ CPU LOAD per interrupt and handler ("top")        │
+ *  │ B or b         │ Send the load figures as a BINARY telemetry record│
+ *  │ C or c         │ Peripheral CLOCKS: users and on-time              │
+ *  │ U or u         │ UPTIME over all boots and the RESET history       │
  *  └────────────────┴───────────────────────────────────────────────────┘
  *  
  *  ADDITIONAL FEATURES:
  *  • Button press sends "BUTTON PRESSED!" over UART
  *  • Periodic heartbeat message every 5 seconds
  *  • Echo received characters back to terminal
+ *  • Event trace of every interrupt and main-loop handler, frozen on a
+ *    trigger and exported for chrome://tracing / ui.perfetto.dev
+ *  • CPU load over 1 s / 10 s / 60 s, time and worst case per handler
+ *  • Reference-counted peripheral clocks, switched off when unused
+ *  • Total uptime and boot count that survive resets (backup SRAM),
+ *    and the reasons for the last 8 resets (RTC backup registers)
  *  
  *  
  *  CONCEPTS COMBINED IN THIS PROJECT:
@@ -55,6 +66,7 @@
  *  │ NVIC            │ UART RX and button interrupts                    │
  *  │ Circular Buffer │ Software pattern for buffering received data     │
  *  │ Command Parser  │ String processing for commands                   │
+ *  │ Backup domain   │ Backup SRAM and RTC registers keep state on reset│
  *  └─────────────────┴──────────────────────────────────────────────────┘
  *  
  *  
@@ -79,6 +91,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
 /* ============================================================================
@@ -95,6 +108,9 @@
 #define TIM7_BASE       0x40001400UL
 #define EXTI_BASE       0x58000000UL
 #define SYSCFG_BASE     0x58000400UL
+#define PWR_BASE        0x58024800UL
+#define RTC_BASE        0x58004000UL
+#define BKPSRAM_BASE    0x38800000UL    /* 4 KB backup SRAM */
 
 #define NVIC_ISER_BASE  0xE000E100UL
 
@@ -186,6 +202,21 @@ typedef struct {
     volatile uint32_t PRESC;
 } USART_TypeDef;
 
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CSR1;
+    volatile uint32_t CR2;
+    volatile uint32_t CR3;
+} PWR_TypeDef;
+
+/* Only the backup registers - the clock itself is project 2's job */
+typedef struct {
+    volatile uint32_t RESERVED[20];
+    volatile uint32_t BKPR[32];     /* 0x50 - kept through every reset */
+} RTC_TypeDef;
+
+_Static_assert(offsetof(RTC_TypeDef, BKPR) == 0x50, "RTC_BKP0R offset");
+
 typedef struct {
     volatile uint32_t CR1;
     volatile uint32_t CR2;
@@ -249,9 +280,20 @@ typedef struct {
 #define TIM7    ((TIM_TypeDef *) TIM7_BASE)
 #define EXTI    ((EXTI_TypeDef *) EXTI_BASE)
 #define SYSCFG  ((SYSCFG_TypeDef *) SYSCFG_BASE)
+#define PWR     ((PWR_TypeDef *) PWR_BASE)
+#define RTC     ((RTC_TypeDef *) RTC_BASE)
 
 #define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
 
+/* DWT cycle counter (64 MHz → 15.6 ns per count) */
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+#define CPU_CYCLES_PER_US       64U
+
 /* ============================================================================
  *  BIT DEFINITIONS
  * ============================================================================ */
@@ -265,6 +307,23 @@ typedef struct {
 #define RCC_APB1LENR_TIM2EN     (1U << 0)
 #define RCC_APB1LENR_TIM7EN     (1U << 5)
 #define RCC_APB1LENR_USART3EN   (1U << 18)
+#define RCC_AHB4ENR_BKPRAMEN    (1U << 28)
+#define RCC_APB4ENR_RTCAPBEN    (1U << 16)
+
+/* RCC reset status flags */
+#define RCC_RSR_RMVF            (1U << 16)  /* Write 1 to clear the flags */
+#define RCC_RSR_BORRSTF         (1U << 21)
+#define RCC_RSR_PINRSTF         (1U << 22)
+#define RCC_RSR_PORRSTF         (1U << 23)
+#define RCC_RSR_SFTRSTF         (1U << 24)
+#define RCC_RSR_IWDG1RSTF       (1U << 26)
+#define RCC_RSR_WWDG1RSTF       (1U << 28)
+#define RCC_RSR_LPWRRSTF        (1U << 30)
+
+/* PWR */
+#define PWR_CR1_DBP             (1U << 8)   /* Backup domain write access */
+#define PWR_CR2_BREN            (1U << 0)   /* Backup regulator enable */
+#define PWR_CR2_BRRDY           (1U << 16)  /* Backup regulator ready */
 
 /* USART */
 #define USART_CR1_UE            (1U << 0)   /* USART Enable */
@@ -388,7 +447,8 @@ char Buffer_Get(CircularBuffer_t *buf) {
  *  GLOBAL STATE
  * ============================================================================ */
 
-volatile uint8_t button_pressed = 0;
+volatile uint8_t button_edge_pending = 0;
+volatile uint32_t button_edge_time = 0;
 volatile uint8_t heartbeat_tick = 0;
 volatile uint32_t uptime_seconds = 0;
 
@@ -397,6 +457,95 @@ uint8_t led_green_on = 0;
 uint8_t led_yellow_on = 0;
 uint8_t led_red_on = 0;
 
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: CLOCK GATING WITH REFERENCE COUNTS
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  Every enabled peripheral clock burns dynamic power, used or not. But
+ *  turning one off is only safe when NOBODY needs it any more - and two
+ *  drivers can share a clock (GPIOB drives the green AND the red LED).
+ * 
+ *  So each clock gets a reference count:
+ * 
+ *      Clock_Request(GPIOB)   refs 0 → 1   bit set in RCC
+ *      Clock_Request(GPIOB)   refs 1 → 2   (already on)
+ *      Clock_Release(GPIOB)   refs 2 → 1   (still needed)
+ *      Clock_Release(GPIOB)   refs 1 → 0   bit cleared in RCC
+ * 
+ *  A request names several clocks at once. They are grouped by RCC
+ *  register, so each register sees ONE read-modify-write, followed by a
+ *  read-back: the write must reach RCC before the first access to the
+ *  peripheral.
+ * 
+ *  The manager also remembers how long every clock has been on, in CPU
+ *  cycles extended to 64 bits (DWT_CYCCNT alone wraps every 67 s).
+ * 
+ * ============================================================================ */
+
+typedef enum {
+    CLOCK_BUS_AHB4,
+    CLOCK_BUS_APB1L,
+    CLOCK_BUS_APB4,
+    CLOCK_BUS_COUNT
+} ClockBus_t;
+
+typedef enum {
+    CLOCK_GPIOB,
+    CLOCK_GPIOC,
+    CLOCK_GPIOD,
+    CLOCK_GPIOE,
+    CLOCK_SYSCFG,
+    CLOCK_TIM2,
+    CLOCK_TIM7,
+    CLOCK_USART3,
+    CLOCK_BKPRAM,
+    CLOCK_RTC,
+    CLOCK_COUNT
+} ClockId_t;
+
+#define CLOCK(id)               (1U << (id))
+
+typedef struct {
+    const char *name;
+    uint8_t bus;
+    uint32_t bit;
+} ClockInfo_t;
+
+uint8_t clock_refs[CLOCK_COUNT];
+uint64_t clock_since[CLOCK_COUNT];      /* When it last turned on */
+uint64_t clock_on_cycles[CLOCK_COUNT];  /* Finished on-periods */
+
+/* DWT_CYCCNT extended to 64 bits - call at least once per 67 s */
+uint32_t cycles_last = 0;
+uint64_t cycles_high = 0;
+
+uint64_t Cycles_Now(void) {
+    uint32_t primask;
+    uint32_t now;
+    uint64_t result;
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+    now = DWT_CYCCNT;
+    if (now < cycles_last) {
+        cycles_high += 1ULL << 32;
+    }
+    cycles_last = now;
+    result = cycles_high | now;
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+
+    return result;
+}
+
+volatile uint32_t *Clock_Register(uint32_t bus) {
+    switch (bus) {
+        case CLOCK_BUS_AHB4:    return &RCC->AHB4ENR;
+        case CLOCK_BUS_APB1L:   return &RCC->APB1LENR;
+        default:                return &RCC->APB4ENR;
+    }
+}
+
 /* ============================================================================
  * 
  *  STEP 1: ENABLE CLOCKS
@@ -404,32 +553,86 @@ uint8_t led_red_on = 0;
  * 
  * ============================================================================ */
 
+const ClockInfo_t clock_info[CLOCK_COUNT] = {
+    [CLOCK_GPIOB]  = { "GPIOB",  CLOCK_BUS_AHB4,  RCC_AHB4ENR_GPIOBEN },
+    [CLOCK_GPIOC]  = { "GPIOC",  CLOCK_BUS_AHB4,  RCC_AHB4ENR_GPIOCEN },
+    [CLOCK_GPIOD]  = { "GPIOD",  CLOCK_BUS_AHB4,  RCC_AHB4ENR_GPIODEN },    /* UART pins */
+    [CLOCK_GPIOE]  = { "GPIOE",  CLOCK_BUS_AHB4,  RCC_AHB4ENR_GPIOEEN },
+    [CLOCK_SYSCFG] = { "SYSCFG", CLOCK_BUS_APB4,  RCC_APB4ENR_SYSCFGEN },   /* EXTI mapping */
+    [CLOCK_TIM2]   = { "TIM2",   CLOCK_BUS_APB1L, RCC_APB1LENR_TIM2EN },    /* Delays */
+    [CLOCK_TIM7]   = { "TIM7",   CLOCK_BUS_APB1L, RCC_APB1LENR_TIM7EN },    /* Heartbeat */
+    [CLOCK_BKPRAM] = { "BKPRAM", CLOCK_BUS_AHB4,  RCC_AHB4ENR_BKPRAMEN },   /* Saved uptime */
+    [CLOCK_RTC]    = { "RTC",    CLOCK_BUS_APB4,  RCC_APB4ENR_RTCAPBEN },   /* Reset history */
+
+    /* ✏️ YOUR TURN: Which APB1L bit clocks USART3? */
+    [CLOCK_USART3] = { "USART3", CLOCK_BUS_APB1L, ??? },    /* HINT: RCC_APB1LENR_USART3EN */
+};
+
+void Clock_Request(uint32_t clocks) {
+    uint32_t set[CLOCK_BUS_COUNT] = {0};
+    uint64_t now = Cycles_Now();
+    uint32_t primask;
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+
+    for (uint32_t id = 0; id < CLOCK_COUNT; id++) {
+        if ((clocks & CLOCK(id)) && clock_refs[id]++ == 0) {
+            set[clock_info[id].bus] |= clock_info[id].bit;
+            clock_since[id] = now;
+        }
+    }
+
+    /* One RMW per register, then read back before anyone touches the peripheral */
+    for (uint32_t bus = 0; bus < CLOCK_BUS_COUNT; bus++) {
+        if (set[bus]) {
+            volatile uint32_t *reg = Clock_Register(bus);
+            *reg |= set[bus];
+            (void)*reg;
+        }
+    }
+
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+}
+
+void Clock_Release(uint32_t clocks) {
+    uint32_t clear[CLOCK_BUS_COUNT] = {0};
+    uint64_t now = Cycles_Now();
+    uint32_t primask;
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+
+    for (uint32_t id = 0; id < CLOCK_COUNT; id++) {
+        if ((clocks & CLOCK(id)) && clock_refs[id] > 0 && --clock_refs[id] == 0) {
+            clear[clock_info[id].bus] |= clock_info[id].bit;
+            clock_on_cycles[id] += now - clock_since[id];
+        }
+    }
+
+    for (uint32_t bus = 0; bus < CLOCK_BUS_COUNT; bus++) {
+        if (clear[bus]) {
+            *Clock_Register(bus) &= ~clear[bus];
+        }
+    }
+
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+}
+
 void EnableClocks(void) {
-    /* Enable GPIO clocks */
-    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOBEN;
-    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOCEN;
-    RCC->AHB4ENR |= RCC_AHB4ENR_GPIODEN;    /* For UART pins */
-    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOEEN;
-    
-    /* Enable SYSCFG for EXTI */
-    RCC->APB4ENR |= RCC_APB4ENR_SYSCFGEN;
-    
-    /* Enable TIM2 for delays */
-    RCC->APB1LENR |= RCC_APB1LENR_TIM2EN;
-    
-    /* Enable TIM7 for heartbeat */
-    RCC->APB1LENR |= RCC_APB1LENR_TIM7EN;
-    
-    /* ✏️ YOUR TURN: Enable USART3 clock */
-    RCC->APB1LENR |= ???;       /* HINT: RCC_APB1LENR_USART3EN */
-    
-    (void)RCC->APB4ENR;
+    /* Everything the console needs, in three register writes */
+    Clock_Request(CLOCK(CLOCK_GPIOB) | CLOCK(CLOCK_GPIOC) | CLOCK(CLOCK_GPIOD) |
+                  CLOCK(CLOCK_GPIOE) | CLOCK(CLOCK_TIM2) | CLOCK(CLOCK_TIM7) |
+                  CLOCK(CLOCK_USART3));
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
  * 💡 SOLUTION:
  * 
- * RCC->APB1LENR |= RCC_APB1LENR_USART3EN;
+ * [CLOCK_USART3] = { "USART3", CLOCK_BUS_APB1L, RCC_APB1LENR_USART3EN },
+ * 
+ * SYSCFG is missing from EnableClocks() on purpose: only the EXTI setup
+ * needs it, so ConfigureButtonEXTI() requests it and releases it again.
  * ───────────────────────────────────────────────────────────────────────────── */
 
 /* ============================================================================
@@ -653,6 +856,36 @@ void delay_ms(uint32_t ms) {
     while ((TIM2->CNT - start) < (ms * 1000));
 }
 
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: NON-BLOCKING DEBOUNCE
+ *  ════════════════════════════════════════════════════════════════════════
+ *  
+ *  The button bounces for a few ms, so EXTI fires several times per press.
+ *  Instead of delay_ms(50) (which stalls the console and drops RX bytes),
+ *  the ISR only stamps the FIRST edge with TIM2. The main loop checks back
+ *  later: once BUTTON_DEBOUNCE_US has passed, a still-low pin is a real
+ *  press; a high pin was release bounce and is ignored.
+ *  
+ *  See Tutorials/button_tutorial.c for click / double-click / long-press.
+ * 
+ * ============================================================================ */
+
+#define BUTTON_DEBOUNCE_US      20000U      /* 20 ms settle window */
+
+uint8_t Button_Debounced(void) {
+    if (!button_edge_pending) {
+        return 0;
+    }
+    if ((TIM2->CNT - button_edge_time) < BUTTON_DEBOUNCE_US) {
+        return 0;       /* Still settling - come back next loop */
+    }
+    button_edge_pending = 0;
+    
+    /* Active LOW: still pressed after the window = real press */
+    return !(GPIOC->IDR & (1U << BUTTON_PIN));
+}
+
 /* ============================================================================
  * 
  *  STEP 7: CONFIGURE HEARTBEAT TIMER (TIM7)
@@ -701,10 +934,16 @@ void ConfigureHeartbeatTimer(void) {
  * ============================================================================ */
 
 void ConfigureButtonEXTI(void) {
+    /* SYSCFG is only needed while the mapping is written */
+    Clock_Request(CLOCK(CLOCK_SYSCFG));
+
     /* ✏️ YOUR TURN: Select Port C for EXTI13 (PC13) */
     /* EXTICR[3] handles lines 12-15, line 13 is at bits 4-7 */
     SYSCFG->EXTICR[3] &= ~(0xFU << 4);   /* Clear */
     SYSCFG->EXTICR[3] |= (??? << 4);     /* HINT: 0x02 = Port C */
+
+    /* EXTICR keeps its value with the clock off */
+    Clock_Release(CLOCK(CLOCK_SYSCFG));
     
     /* ✏️ YOUR TURN: Configure falling edge trigger (button press) */
     EXTI->??? |= EXTI_LINE13;            /* HINT: FTSR1 for Falling edge */
@@ -772,11 +1011,822 @@ void LED_ToggleRed(void) {
     }
 }
 
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: EVENT TRACING
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  Which ran first - the button ISR or the heartbeat? How long did the
+ *  echo in USART3_IRQHandler keep the main loop waiting? printf cannot
+ *  tell you: it is far too slow and it changes the timing it reports.
+ * 
+ *  Instead every interesting moment writes ONE 8-byte record into a RAM
+ *  ring (~20 cycles):
+ * 
+ *      ┌───────────────┬──────┬────┬───────┐
+ *      │ DWT_CYCCNT    │ type │ id │ arg   │
+ *      │ 32 bits       │ 8    │ 8  │ 16    │
+ *      └───────────────┴──────┴────┴───────┘
+ * 
+ *  type: ISR enter / ISR exit     - first and last line of each handler
+ *        POST                     - an ISR hands work to the main loop
+ *        SPAN begin / SPAN end    - a main-loop handler runs
+ * 
+ *  The ring is a flight recorder: it always holds the LAST 256 records.
+ *  When something goes wrong, a TRIGGER lets a few more records in (to
+ *  show what happened next) and then FREEZES the ring, so the moment of
+ *  the bug is preserved until you type T.
+ * 
+ *  T prints the ring as Chrome trace JSON. Save the output to a file and
+ *  open it in chrome://tracing or ui.perfetto.dev: interrupts and the
+ *  main loop appear as two timelines, µs accurate.
+ * 
+ *  The STM32H753 has one core, so there is one ring. On a dual-core part
+ *  (H755) each core would get its own ring and its own "pid" in the JSON.
+ * 
+ * ============================================================================ */
+
+#define TRACE_RING_SIZE         256U        /* Records, must be a power of 2 */
+#define TRACE_LINE_BUDGET_US    10000U      /* One-line reply (~40 chars at 115200) */
+#define TRACE_REPORT_BUDGET_US  500000U     /* Multi-line report (~5 KB) */
+
+typedef enum {
+    TRACE_ISR_ENTER,
+    TRACE_ISR_EXIT,
+    TRACE_POST,
+    TRACE_SPAN_BEGIN,
+    TRACE_SPAN_END
+} TraceType_t;
+
+/* One id space for everything that can appear in the trace */
+typedef enum {
+    TRACE_ID_USART3,                /* ISRs */
+    TRACE_ID_EXTI15_10,
+    TRACE_ID_TIM7,
+    TRACE_ID_RX_CHAR,               /* Posted events */
+    TRACE_ID_BUTTON_EDGE,
+    TRACE_ID_HEARTBEAT_TICK,
+    TRACE_ID_COMMAND,               /* Main-loop handlers */
+    TRACE_ID_BUTTON,
+    TRACE_ID_HEARTBEAT,
+    TRACE_ID_COUNT
+} TraceId_t;
+
+const char *const trace_names[TRACE_ID_COUNT] = {
+    "USART3_IRQHandler", "EXTI15_10_IRQHandler", "TIM7_IRQHandler",
+    "rx_char", "button_edge", "heartbeat_tick",
+    "ProcessCommand", "Button", "Heartbeat"
+};
+
+typedef struct {
+    uint32_t stamp;                 /* DWT_CYCCNT */
+    uint8_t type;                   /* TraceType_t */
+    uint8_t id;                     /* TraceId_t */
+    uint16_t arg;                   /* Character, counter... */
+} TraceRecord_t;
+
+TraceRecord_t trace_ring[TRACE_RING_SIZE];
+volatile uint32_t trace_count = 0;          /* Records written since reset */
+volatile uint8_t trace_frozen = 0;          /* 1 = ring keeps its contents */
+volatile uint8_t trace_triggered = 0;       /* Counting down to the freeze */
+volatile uint32_t trace_after_left = 0;     /* Records still to capture */
+volatile uint8_t trace_trigger_id = TRACE_ID_COUNT; /* What fired the trigger */
+
+#define TRACE_ISR_ENTER(id)         Trace_Record(TRACE_ISR_ENTER, (id), 0)
+#define TRACE_ISR_EXIT(id)          Trace_Record(TRACE_ISR_EXIT, (id), 0)
+#define TRACE_POST(id, arg)         Trace_Record(TRACE_POST, (id), (arg))
+#define TRACE_SPAN_BEGIN(id, arg)   Trace_Record(TRACE_SPAN_BEGIN, (id), (arg))
+#define TRACE_SPAN_END(id)          Trace_Record(TRACE_SPAN_END, (id), 0)
+
+/* Freeze the ring after 'keep_after' more records once cond is true */
+#define TRACE_TRIGGER_IF(cond, id, keep_after) \
+    do { if (cond) { Trace_Trigger((id), (keep_after)); } } while (0)
+
+void Load_Account(uint8_t type, uint8_t id, uint32_t stamp);
+
+void Trace_Init(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_LAR = 0xC5ACCE55;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/* ============================================================================
+ * 
+ *  STEP 9: RECORD AN EVENT
+ *  =========================
+ * 
+ *  Called from the main loop AND from all three ISRs. Taking the slot and
+ *  reading the timestamp inside one short critical section keeps the
+ *  records in time order - an ISR can never slip in between.
+ * 
+ *  The same timestamps feed the CPU load accounting (STEP 11), which
+ *  keeps counting while the trace is frozen.
+ * 
+ * ============================================================================ */
+
+void Trace_Record(uint8_t type, uint8_t id, uint16_t arg) {
+    uint32_t primask;
+    uint32_t stamp;
+    TraceRecord_t *rec;
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+
+    stamp = DWT_CYCCNT;
+    Load_Account(type, id, stamp);
+
+    if (!trace_frozen) {
+        /* ✏️ YOUR TURN: Pick the slot - the counter wraps around the ring */
+        rec = &trace_ring[???];             /* HINT: trace_count masked with TRACE_RING_SIZE - 1 */
+        rec->stamp = stamp;
+        rec->type = type;
+        rec->id = id;
+        rec->arg = arg;
+        trace_count++;
+
+        if (trace_triggered && --trace_after_left == 0) {
+            trace_frozen = 1;
+        }
+    }
+
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * rec = &trace_ring[trace_count & (TRACE_RING_SIZE - 1)];
+ * 
+ * Once trace_count passes 256 the oldest record is overwritten - exactly
+ * what a flight recorder should do.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Only the FIRST trigger counts - later ones would hide the original bug */
+void Trace_Trigger(uint8_t id, uint32_t keep_after) {
+    if (trace_triggered || trace_frozen) {
+        return;
+    }
+    trace_trigger_id = id;
+    if (keep_after == 0) {
+        trace_frozen = 1;
+    } else {
+        trace_after_left = keep_after;
+        trace_triggered = 1;
+    }
+}
+
+/* ============================================================================
+ * 
+ *  STEP 10: EXPORT AS CHROME TRACE JSON
+ *  ======================================
+ * 
+ *  One JSON object per record:
+ * 
+ *    {"name":"TIM7_IRQHandler","ph":"B","ts":1234.500,"pid":1,"tid":1},
+ * 
+ *    ph  B / E = begin / end of a slice,  i = instant (a POST)
+ *    ts  microseconds since the oldest record in the ring
+ *    tid 1 = interrupts, 0 = main loop
+ * 
+ *  All three interrupts have the same priority, so they never nest and
+ *  one "interrupts" timeline is enough.
+ * 
+ * ============================================================================ */
+
+void Trace_SendMicros(uint64_t cycles) {
+    uint32_t frac = (uint32_t)(cycles % CPU_CYCLES_PER_US) * 1000U / CPU_CYCLES_PER_US;
+
+    UART_SendNumber((uint32_t)(cycles / CPU_CYCLES_PER_US));
+    UART_SendChar('.');
+    UART_SendChar('0' + (frac / 100));
+    UART_SendChar('0' + (frac / 10) % 10);
+    UART_SendChar('0' + (frac % 10));
+}
+
+void Trace_Dump(void) {
+    uint32_t count, first, prev_stamp;
+    uint64_t elapsed = 0;
+    uint8_t comma = 0;
+    static const char phase[] = { 'B', 'E', 'i', 'B', 'E' };   /* By TraceType_t */
+
+    trace_frozen = 1;                       /* Stop recording while we read */
+    count = trace_count;
+    first = (count > TRACE_RING_SIZE) ? (count - TRACE_RING_SIZE) : 0;
+    prev_stamp = trace_ring[first & (TRACE_RING_SIZE - 1)].stamp;
+
+    UART_SendLine("");
+    UART_SendLine("[");
+    for (uint32_t n = first; n != count; n++) {
+        TraceRecord_t *rec = &trace_ring[n & (TRACE_RING_SIZE - 1)];
+
+        /* Unsigned difference survives the 67 s CYCCNT wrap */
+        elapsed += (uint32_t)(rec->stamp - prev_stamp);
+        prev_stamp = rec->stamp;
+
+        if (rec->id >= TRACE_ID_COUNT || rec->type > TRACE_SPAN_END) {
+            continue;
+        }
+        if (comma) {
+            UART_SendLine(",");
+        }
+        comma = 1;
+
+        UART_SendString("{\"name\":\"");
+        UART_SendString(trace_names[rec->id]);
+        UART_SendString("\",\"ph\":\"");
+        UART_SendChar(phase[rec->type]);
+        UART_SendString("\",\"ts\":");
+        Trace_SendMicros(elapsed);
+        UART_SendString(",\"pid\":1,\"tid\":");
+        UART_SendChar(rec->type <= TRACE_POST ? '1' : '0');
+        if (rec->type == TRACE_POST) {
+            UART_SendString(",\"s\":\"t\"");
+        }
+        if (rec->type == TRACE_POST || rec->type == TRACE_SPAN_BEGIN) {
+            UART_SendString(",\"args\":{\"arg\":");
+            UART_SendNumber(rec->arg);
+            UART_SendChar('}');
+        }
+        UART_SendChar('}');
+    }
+    UART_SendLine("");
+    UART_SendLine("]");
+
+    UART_SendString("Trace: ");
+    UART_SendNumber(count - first);
+    UART_SendString(" records, trigger: ");
+    UART_SendLine(trace_trigger_id < TRACE_ID_COUNT ? trace_names[trace_trigger_id] : "manual (T)");
+
+    /* Re-arm: empty ring, no trigger pending */
+    trace_triggered = 0;
+    trace_trigger_id = TRACE_ID_COUNT;
+    trace_count = 0;
+    trace_frozen = 0;
+}
+
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: HOW BUSY IS THE CPU?
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  Every ISR and every main-loop handler already reports when it starts
+ *  and ends (the trace hooks). Subtracting the two timestamps gives its
+ *  run time. Everything else is idle - the main loop polling for work.
+ * 
+ *      1 second = 64,000,000 cycles
+ * 
+ *      USART3_IRQHandler   ██                         0.4 %
+ *      ProcessCommand      ████████                   1.6 %
+ *      idle                ██████████████████████... 97.9 %
+ * 
+ *  A main-loop handler can be interrupted. Its time must not include the
+ *  ISRs that ran in the middle, or they would be counted twice:
+ * 
+ *      handler time = (end - begin) - (ISR cycles during the span)
+ * 
+ *  Once per second the main loop closes a window: the per-handler sums
+ *  become "last second" figures and the total goes into a 60-entry
+ *  history. The 10 s and 60 s loads are sums over that history - busy
+ *  cycles divided by elapsed cycles, so a late sample (for example after
+ *  1.5 s of party mode) is still weighted correctly.
+ * 
+ * ============================================================================ */
+
+#define CPU_CYCLES_PER_SECOND   64000000U
+#define LOAD_HISTORY            60U         /* 1 s windows */
+
+/* Per id - only ISR and handler ids are filled */
+volatile uint32_t load_cycles[TRACE_ID_COUNT];      /* Current window */
+volatile uint32_t load_start[TRACE_ID_COUNT];       /* Stamp of the run in progress */
+volatile uint32_t load_isr_mark[TRACE_ID_COUNT];    /* load_isr_total at span begin */
+volatile uint32_t load_max[TRACE_ID_COUNT];         /* Longest single run, cycles */
+volatile uint32_t load_runs[TRACE_ID_COUNT];        /* Completed runs since reset */
+volatile uint32_t load_isr_total = 0;               /* All ISR cycles, free running */
+
+/* Results of the last closed window */
+uint32_t load_last_permille[TRACE_ID_COUNT];
+uint32_t load_window_start = 0;
+uint32_t load_hist_busy[LOAD_HISTORY];
+uint32_t load_hist_elapsed[LOAD_HISTORY];
+uint32_t load_hist_next = 0;
+uint32_t load_hist_count = 0;
+
+/* ============================================================================
+ * 
+ *  STEP 11: ACCOUNT FOR EVERY RUN
+ *  ================================
+ * 
+ *  Called by Trace_Record() with interrupts already disabled.
+ * 
+ * ============================================================================ */
+
+void Load_Account(uint8_t type, uint8_t id, uint32_t stamp) {
+    uint32_t run;
+
+    switch (type) {
+        case TRACE_ISR_ENTER:
+        case TRACE_SPAN_BEGIN:
+            load_start[id] = stamp;
+            load_isr_mark[id] = load_isr_total;
+            return;
+
+        case TRACE_ISR_EXIT:
+            run = stamp - load_start[id];
+            load_isr_total += run;
+            break;
+
+        case TRACE_SPAN_END:
+            /* ✏️ YOUR TURN: Remove the ISR time that happened inside the span */
+            run = (stamp - load_start[id]) - ???;   /* HINT: How much did load_isr_total grow since begin? */
+            break;
+
+        default:
+            return;                     /* POST: an instant, takes no time */
+    }
+
+    load_cycles[id] += run;
+    load_runs[id]++;
+    if (run > load_max[id]) {
+        load_max[id] = run;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * run = (stamp - load_start[id]) - (load_isr_total - load_isr_mark[id]);
+ * 
+ * All three ISRs share one priority, so they never interrupt each other
+ * and need no such correction.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Close a window once per second - call from the main loop */
+void Load_Sample(void) {
+    uint32_t now = DWT_CYCCNT;
+    uint32_t elapsed = now - load_window_start;
+    uint32_t busy = 0;
+    uint32_t primask;
+
+    if (elapsed < CPU_CYCLES_PER_SECOND) {
+        return;
+    }
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+    for (uint32_t id = 0; id < TRACE_ID_COUNT; id++) {
+        uint32_t cycles = load_cycles[id];
+        load_cycles[id] = 0;
+        load_last_permille[id] = (uint32_t)(((uint64_t)cycles * 1000U) / elapsed);
+        busy += cycles;
+    }
+    load_window_start = now;
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+
+    load_hist_busy[load_hist_next] = busy;
+    load_hist_elapsed[load_hist_next] = elapsed;
+    load_hist_next = (load_hist_next + 1) % LOAD_HISTORY;
+    if (load_hist_count < LOAD_HISTORY) {
+        load_hist_count++;
+    }
+}
+
+/* Busy permille over the last 'seconds' windows (1, 10 or 60) */
+uint32_t Load_Permille(uint32_t seconds) {
+    uint64_t busy = 0, elapsed = 0;
+
+    if (seconds > load_hist_count) {
+        seconds = load_hist_count;
+    }
+    for (uint32_t n = 1; n <= seconds; n++) {
+        uint32_t slot = (load_hist_next + LOAD_HISTORY - n) % LOAD_HISTORY;
+        busy += load_hist_busy[slot];
+        elapsed += load_hist_elapsed[slot];
+    }
+    return elapsed ? (uint32_t)((busy * 1000U) / elapsed) : 0;
+}
+
+/* 123 → "12.3" */
+void UART_SendPermille(uint32_t permille) {
+    UART_SendNumber(permille / 10);
+    UART_SendChar('.');
+    UART_SendChar('0' + (permille % 10));
+}
+
+/* Right-align a number in a column */
+void UART_SendPadded(uint32_t num, uint32_t width) {
+    uint32_t digits = 1;
+
+    for (uint32_t n = num; n >= 10; n /= 10) {
+        digits++;
+    }
+    while (digits++ < width) {
+        UART_SendChar(' ');
+    }
+    UART_SendNumber(num);
+}
+
+/* Which peripherals are clocked, by how many users, and for how long */
+void Clock_ShowStatus(void) {
+    uint64_t now = Cycles_Now();
+
+    UART_SendLine("");
+    UART_SendLine("CLOCK     REFS  STATE     ON TIME ms");
+    for (uint32_t id = 0; id < CLOCK_COUNT; id++) {
+        const char *name = clock_info[id].name;
+        uint32_t len = strlen(name);
+        uint64_t on = clock_on_cycles[id];
+
+        if (clock_refs[id] > 0) {
+            on += now - clock_since[id];
+        }
+        UART_SendString(name);
+        while (len++ < 8) {
+            UART_SendChar(' ');
+        }
+        UART_SendPadded(clock_refs[id], 5);
+        UART_SendString(clock_refs[id] > 0 ? "  on    " : "  off   ");
+        UART_SendPadded((uint32_t)(on / (CPU_CYCLES_PER_US * 1000U)), 12);
+        UART_SendLine("");
+    }
+}
+
+void Load_ShowSummary(void) {
+    UART_SendString("CPU load: 1s ");
+    UART_SendPermille(Load_Permille(1));
+    UART_SendString("%  10s ");
+    UART_SendPermille(Load_Permille(10));
+    UART_SendString("%  60s ");
+    UART_SendPermille(Load_Permille(60));
+    UART_SendLine("%");
+}
+
+/* The "top" view: one line per ISR / handler, idle last */
+void Load_ShowTop(void) {
+    uint32_t busy = 0;
+
+    UART_SendLine("");
+    Load_ShowSummary();
+    UART_SendLine("NAME                    1s %   max us      runs");
+    for (uint32_t id = 0; id < TRACE_ID_COUNT; id++) {
+        const char *name = trace_names[id];
+        uint32_t len = strlen(name);
+
+        if (id >= TRACE_ID_RX_CHAR && id <= TRACE_ID_HEARTBEAT_TICK) {
+            continue;                   /* Posted events take no time */
+        }
+        UART_SendString(name);
+        while (len++ < 22) {
+            UART_SendChar(' ');
+        }
+        UART_SendPadded(load_last_permille[id] / 10, 4);
+        UART_SendChar('.');
+        UART_SendChar('0' + (load_last_permille[id] % 10));
+        UART_SendPadded(load_max[id] / CPU_CYCLES_PER_US, 9);
+        UART_SendPadded(load_runs[id], 10);
+        UART_SendLine("");
+        busy += load_last_permille[id];
+    }
+    UART_SendString("idle                  ");
+    UART_SendPermille(busy < 1000 ? 1000 - busy : 0);
+    UART_SendLine("");
+}
+
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: BINARY TELEMETRY
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  The same figures as one fixed-layout record for a PC tool to parse -
+ *  no text, no column guessing. All fields little-endian:
+ * 
+ *    0xA5 0x5A                  sync
+ *    u8  version (1)            u8  n = number of ids
+ *    u16 load 1s ‰  u16 10s ‰   u16 60s ‰      u32 uptime seconds
+ *    n × { u16 last-second ‰, u32 max cycles, u32 runs }
+ *    u8  checksum = sum of every byte after the sync, modulo 256
+ * 
+ * ============================================================================ */
+
+#define TELEMETRY_VERSION       1U
+
+uint8_t telemetry_sum = 0;
+
+void Telemetry_Put8(uint8_t value) {
+    UART_SendChar((char)value);
+    telemetry_sum += value;
+}
+
+void Telemetry_Put16(uint16_t value) {
+    Telemetry_Put8(value & 0xFF);
+    Telemetry_Put8(value >> 8);
+}
+
+void Telemetry_Put32(uint32_t value) {
+    Telemetry_Put16(value & 0xFFFF);
+    Telemetry_Put16(value >> 16);
+}
+
+void Load_SendTelemetry(void) {
+    UART_SendChar((char)0xA5);
+    UART_SendChar((char)0x5A);
+    telemetry_sum = 0;
+
+    Telemetry_Put8(TELEMETRY_VERSION);
+    Telemetry_Put8(TRACE_ID_COUNT);
+    Telemetry_Put16(Load_Permille(1));
+    Telemetry_Put16(Load_Permille(10));
+    Telemetry_Put16(Load_Permille(60));
+    Telemetry_Put32(uptime_seconds);
+    for (uint32_t id = 0; id < TRACE_ID_COUNT; id++) {
+        Telemetry_Put16(load_last_permille[id]);
+        Telemetry_Put32(load_max[id]);
+        Telemetry_Put32(load_runs[id]);
+    }
+    UART_SendChar((char)telemetry_sum);
+}
+
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: WHERE DOES BOOT TIME GO?
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  Every init function waits for something - a clock to be ready, a
+ *  peripheral to reset. Wrapping each call in BOOT_PHASE() stamps it with
+ *  the cycle counter, and the console prints the breakdown once the UART
+ *  works:
+ * 
+ *      BOOT_PHASE(EnableClocks());
+ *          │  t0 = DWT_CYCCNT
+ *          │  EnableClocks();
+ *          └► boot_phases[n] = { "EnableClocks()", DWT_CYCCNT - t0 }
+ * 
+ *  A phase that takes milliseconds is a spin loop worth a second look.
+ *  (Time before main() - the startup code copying .data and clearing
+ *  .bss - happens before the counter starts and is not included.)
+ * 
+ * ============================================================================ */
+
+#define BOOT_MAX_PHASES         12U
+
+typedef struct {
+    const char *name;
+    uint32_t cycles;
+} BootPhase_t;
+
+BootPhase_t boot_phases[BOOT_MAX_PHASES];
+uint32_t boot_phase_count = 0;
+uint32_t boot_total_cycles = 0;
+
+void Boot_Record(const char *name, uint32_t cycles) {
+    if (boot_phase_count < BOOT_MAX_PHASES) {
+        boot_phases[boot_phase_count].name = name;
+        boot_phases[boot_phase_count].cycles = cycles;
+        boot_phase_count++;
+    }
+    boot_total_cycles += cycles;
+}
+
+#define BOOT_PHASE(call) \
+    do { \
+        uint32_t boot_t0 = DWT_CYCCNT; \
+        call; \
+        Boot_Record(#call, DWT_CYCCNT - boot_t0); \
+    } while (0)
+
+void Boot_ShowReport(void) {
+    UART_SendLine("Boot time (from main):");
+    for (uint32_t i = 0; i < boot_phase_count; i++) {
+        const char *name = boot_phases[i].name;
+        uint32_t len = strlen(name);
+
+        UART_SendString("  ");
+        UART_SendString(name);
+        while (len++ < 26) {
+            UART_SendChar(' ');
+        }
+        UART_SendPadded(boot_phases[i].cycles / CPU_CYCLES_PER_US, 8);
+        UART_SendLine(" us");
+    }
+    UART_SendString("  total                     ");
+    UART_SendPadded(boot_total_cycles / CPU_CYCLES_PER_US, 8);
+    UART_SendLine(" us");
+}
+
+/* ============================================================================
+ * 
+ *  📚 QUICK LESSON: STATE THAT SURVIVES A RESET
+ *  ════════════════════════════════════════════════════════════════════════
+ * 
+ *  Normal RAM is cleared by the startup code on every boot, so uptime
+ *  starts again at zero. The backup domain is not:
+ * 
+ *  ┌──────────────────┬──────────┬────────────────────────────────────┐
+ *  │ Store            │ Size     │ Used here for                      │
+ *  ├──────────────────┼──────────┼────────────────────────────────────┤
+ *  │ Backup SRAM      │ 4 KB     │ Boot count, uptime over all boots  │
+ *  │ RTC BKP0R-31R    │ 32 words │ Reasons for the last 8 resets      │
+ *  └──────────────────┴──────────┴────────────────────────────────────┘
+ * 
+ *  Both keep their contents through resets and watchdog bites, cost
+ *  nanoseconds to write, and never wear out - unlike flash. Both are
+ *  write-protected until PWR_CR1.DBP is set. With no battery on VBAT
+ *  a full power-off loses them, so every record carries a CRC: after
+ *  power-up it fails, and the console starts from zero.
+ * 
+ *  The uptime record is written every heartbeat. A reset in the middle
+ *  of that write must not lose the old value, so there are TWO slots
+ *  and each save goes to the older one:
+ * 
+ *      slot 0: seq 41 ✓   slot 1: seq 42 ✓    ← newest valid wins
+ *      slot 0: seq 43 ✗   slot 1: seq 42 ✓    ← reset mid-write: 42
+ * 
+ *  The backup SRAM clock is only requested around each access.
+ * 
+ * ============================================================================ */
+
+#define PERSIST_MAGIC           0x55505431U     /* "UPT1" */
+#define RESET_HISTORY           8U              /* BKP0R-BKP7R */
+#define RESET_BKP_COUNT         RESET_HISTORY   /* BKP8R: resets logged */
+#define RESET_BKP_CRC           (RESET_HISTORY + 1U)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;          /* +1 per save - the highest one is newest */
+    uint32_t boot_count;
+    uint32_t uptime_total;      /* Seconds, summed over every boot */
+    uint32_t crc;               /* CRC-32 of the fields above */
+} Persist_t;
+
+typedef struct {
+    Persist_t slot[2];
+} BackupSram_t;
+
+#define BACKUP_SRAM             ((BackupSram_t *) BKPSRAM_BASE)
+
+Persist_t persist;                      /* Working copy */
+uint32_t persist_active = 0;            /* Slot holding the newest record */
+uint32_t uptime_before_boot = 0;        /* uptime_total when we started */
+uint32_t reset_flags = 0;               /* RCC->RSR of this boot */
+
+/* CRC-32 (zlib), bit by bit - a few words every 5 s needs no table */
+uint32_t Crc32(const void *data, uint32_t len) {
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (len--) {
+        crc ^= *bytes++;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+uint8_t Persist_Valid(const Persist_t *record) {
+    return record->magic == PERSIST_MAGIC &&
+           record->crc == Crc32(record, offsetof(Persist_t, crc));
+}
+
+void Persist_Commit(void) {
+    uint32_t next = persist_active ^ 1U;
+    volatile uint32_t *dst = (volatile uint32_t *)&BACKUP_SRAM->slot[next];
+    const uint32_t *src = (const uint32_t *)&persist;
+
+    persist.sequence++;
+    persist.crc = Crc32(&persist, offsetof(Persist_t, crc));
+
+    Clock_Request(CLOCK(CLOCK_BKPRAM));
+    for (uint32_t i = 0; i < sizeof(Persist_t) / 4U; i++) {
+        dst[i] = src[i];
+    }
+    __asm volatile ("DSB" : : : "memory");
+    Clock_Release(CLOCK(CLOCK_BKPRAM));
+
+    persist_active = next;
+}
+
+/* Called every heartbeat: bank this boot's uptime */
+void Persist_SaveUptime(void) {
+    persist.uptime_total = uptime_before_boot + uptime_seconds;
+    Persist_Commit();
+}
+
+uint32_t Reset_HistoryCrc(void) {
+    uint32_t words[RESET_HISTORY + 1];
+
+    for (uint32_t i = 0; i <= RESET_HISTORY; i++) {
+        words[i] = RTC->BKPR[i];
+    }
+    return Crc32(words, sizeof(words));
+}
+
+/* Add this boot's reset flags to the ring in BKP0R-BKP7R */
+void Reset_Log(uint32_t flags) {
+    uint32_t count = RTC->BKPR[RESET_BKP_COUNT];
+
+    if (RTC->BKPR[RESET_BKP_CRC] != Reset_HistoryCrc()) {
+        count = 0;                      /* Lost power, or never written */
+        for (uint32_t i = 0; i < RESET_HISTORY; i++) {
+            RTC->BKPR[i] = 0;
+        }
+    }
+
+    RTC->BKPR[count % RESET_HISTORY] = flags;
+    RTC->BKPR[RESET_BKP_COUNT] = count + 1U;
+    RTC->BKPR[RESET_BKP_CRC] = Reset_HistoryCrc();
+}
+
+void Persist_Init(void) {
+    const Persist_t *best = 0;
+
+    /* ✏️ YOUR TURN: Read why we reset, then clear the flags for next time */
+    reset_flags = RCC->RSR;
+    RCC->RSR |= ???;                    /* HINT: RCC_RSR_RMVF */
+
+    /* Backup domain: write access, and the regulator that keeps backup
+     * SRAM alive on VBAT */
+    Clock_Request(CLOCK(CLOCK_BKPRAM) | CLOCK(CLOCK_RTC));
+    PWR->CR1 |= PWR_CR1_DBP;
+    while (!(PWR->CR1 & PWR_CR1_DBP));
+    PWR->CR2 |= PWR_CR2_BREN;
+    while (!(PWR->CR2 & PWR_CR2_BRRDY));
+
+    Reset_Log(reset_flags);
+
+    for (uint32_t i = 0; i < 2; i++) {
+        const Persist_t *slot = &BACKUP_SRAM->slot[i];
+        if (Persist_Valid(slot) && (best == 0 || slot->sequence > best->sequence)) {
+            best = slot;
+            persist_active = i;
+        }
+    }
+
+    if (best != 0) {
+        persist = *best;
+    } else {
+        persist.magic = PERSIST_MAGIC;
+        persist.sequence = 0;
+        persist.boot_count = 0;
+        persist.uptime_total = 0;
+    }
+    Clock_Release(CLOCK(CLOCK_BKPRAM));
+
+    persist.boot_count++;
+    uptime_before_boot = persist.uptime_total;
+    Persist_Commit();
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * RCC->RSR |= RCC_RSR_RMVF;
+ * 
+ * Without it the flags pile up: after a watchdog reset you would still
+ * see the power-on flag from the morning.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Several flags are set at once (power-on also sets BOR and PIN) -
+ * report the most fundamental cause */
+const char *Reset_Name(uint32_t flags) {
+    if (flags & RCC_RSR_PORRSTF)    return "power-on";
+    if (flags & RCC_RSR_BORRSTF)    return "brown-out";
+    if (flags & RCC_RSR_IWDG1RSTF)  return "independent watchdog";
+    if (flags & RCC_RSR_WWDG1RSTF)  return "window watchdog";
+    if (flags & RCC_RSR_LPWRRSTF)   return "low-power";
+    if (flags & RCC_RSR_SFTRSTF)    return "software";
+    if (flags & RCC_RSR_PINRSTF)    return "reset pin";
+    return "unknown";
+}
+
+void Persist_ShowReport(void) {
+    uint32_t count = RTC->BKPR[RESET_BKP_COUNT];
+    uint32_t shown = count < RESET_HISTORY ? count : RESET_HISTORY;
+
+    UART_SendLine("");
+    UART_SendString("This boot: ");
+    UART_SendNumber(uptime_seconds);
+    UART_SendString(" s, all boots: ");
+    UART_SendNumber(uptime_before_boot + uptime_seconds);
+    UART_SendString(" s, boots: ");
+    UART_SendNumber(persist.boot_count);
+    UART_SendLine("");
+
+    UART_SendLine("Last resets (newest first):");
+    for (uint32_t i = 0; i < shown; i++) {
+        UART_SendString("  ");
+        UART_SendString(Reset_Name(RTC->BKPR[(count - 1U - i) % RESET_HISTORY]));
+        UART_SendLine("");
+    }
+}
+
 /* ============================================================================
  *  INTERRUPT HANDLERS
  * ============================================================================ */
 
 void USART3_IRQHandler(void) {
+    TRACE_ISR_ENTER(TRACE_ID_USART3);
+
     /* ✏️ YOUR TURN: Check if receive buffer not empty (data available) */
     if (USART3->ISR & ???) {             /* HINT: USART_ISR_RXNE */
         /* ✏️ YOUR TURN: Read received character from data register */
@@ -784,6 +1834,7 @@ void USART3_IRQHandler(void) {
         
         /* Store in buffer for processing in main loop */
         Buffer_Put(&rx_buffer, c);
+        TRACE_POST(TRACE_ID_RX_CHAR, (uint8_t)c);
         
         /* Echo back to terminal */
         UART_SendChar(c);
@@ -792,7 +1843,12 @@ void USART3_IRQHandler(void) {
     /* Clear overrun error if it occurred */
     if (USART3->ISR & USART_ISR_ORE) {
         USART3->ICR = USART_ICR_ORECF;
+
+        /* A byte was lost - keep 32 more records, then freeze */
+        Trace_Trigger(TRACE_ID_USART3, 32);
     }
+
+    TRACE_ISR_EXIT(TRACE_ID_USART3);
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
@@ -803,12 +1859,22 @@ void USART3_IRQHandler(void) {
  * ───────────────────────────────────────────────────────────────────────────── */
 
 void EXTI15_10_IRQHandler(void) {
+    TRACE_ISR_ENTER(TRACE_ID_EXTI15_10);
+
     /* ✏️ YOUR TURN: Check if line 13 triggered the interrupt */
     if (EXTI->??? & EXTI_LINE13) {       /* HINT: PR1 = Pending Register */
         /* ✏️ YOUR TURN: Clear the pending flag (write 1 to clear) */
         EXTI->??? = EXTI_LINE13;         /* HINT: PR1 */
-        button_pressed = 1;
+        
+        /* First edge of a bounce burst opens the debounce window */
+        if (!button_edge_pending) {
+            button_edge_time = TIM2->CNT;
+            button_edge_pending = 1;
+            TRACE_POST(TRACE_ID_BUTTON_EDGE, 0);
+        }
     }
+
+    TRACE_ISR_EXIT(TRACE_ID_EXTI15_10);
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
@@ -819,13 +1885,19 @@ void EXTI15_10_IRQHandler(void) {
  * ───────────────────────────────────────────────────────────────────────────── */
 
 void TIM7_IRQHandler(void) {
+    TRACE_ISR_ENTER(TRACE_ID_TIM7);
+
     /* ✏️ YOUR TURN: Check if update interrupt flag is set */
     if (TIM7->??? & ???) {               /* HINT: SR register, TIM_SR_UIF flag */
         /* ✏️ YOUR TURN: Clear the flag */
         TIM7->??? &= ~???;               /* HINT: SR, TIM_SR_UIF */
         heartbeat_tick = 1;
         uptime_seconds += 5;
+        Cycles_Now();                   /* Keeps the 64-bit clock from missing a wrap */
+        TRACE_POST(TRACE_ID_HEARTBEAT_TICK, (uint16_t)uptime_seconds);
     }
+
+    TRACE_ISR_EXIT(TRACE_ID_TIM7);
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
@@ -851,6 +1923,11 @@ void ShowHelp(void) {
     UART_SendLine("║  O - All LEDs OFF                     ║");
     UART_SendLine("║  S - Show status                      ║");
     UART_SendLine("║  P - Party mode!                      ║");
+    UART_SendLine("║  T - Dump event trace (JSON)          ║");
+    UART_SendLine("║  L - CPU load per handler (top)       ║");
+    UART_SendLine("║  B - Binary load telemetry record     ║");
+    UART_SendLine("║  C - Peripheral clock status          ║");
+    UART_SendLine("║  U - Uptime and reset history         ║");
     UART_SendLine("║  H - Show this help                   ║");
     UART_SendLine("╚═══════════════════════════════════════╝");
     UART_SendLine("");
@@ -867,7 +1944,15 @@ void ShowStatus(void) {
     
     UART_SendString("Uptime: ");
     UART_SendNumber(uptime_seconds);
-    UART_SendLine(" seconds");
+    UART_SendString(" seconds (");
+    UART_SendNumber(uptime_before_boot + uptime_seconds);
+    UART_SendLine(" over all boots)");
+
+    UART_SendString("Boot: ");
+    UART_SendNumber(boot_total_cycles / CPU_CYCLES_PER_US);
+    UART_SendLine(" us");
+
+    Load_ShowSummary();
 }
 
 void PartyMode(void) {
@@ -949,6 +2034,31 @@ void ProcessCommand(char cmd) {
         case 'p':
             PartyMode();
             break;
+
+        case 'T':
+        case 't':
+            Trace_Dump();
+            break;
+
+        case 'L':
+        case 'l':
+            Load_ShowTop();
+            break;
+
+        case 'B':
+        case 'b':
+            Load_SendTelemetry();
+            break;
+
+        case 'C':
+        case 'c':
+            Clock_ShowStatus();
+            break;
+
+        case 'U':
+        case 'u':
+            Persist_ShowReport();
+            break;
             
         case '\r':
         case '\n':
@@ -963,6 +2073,37 @@ void ProcessCommand(char cmd) {
     }
 }
 
+/* How long a command may take before the trace freezes. Replies go out
+ * at ~87 µs per character, so the budget follows the reply length.
+ * 0 = blocks on purpose: never an anomaly. */
+uint32_t Command_BudgetUs(char cmd) {
+    switch (cmd) {
+        case 'P':
+        case 'p':                       /* 1.5 s of delay_ms() */
+        case 'T':
+        case 't':                       /* The dump itself */
+            return 0;
+
+        case 'S':
+        case 's':
+        case 'H':
+        case 'h':
+        case '?':
+        case 'L':
+        case 'l':
+        case 'B':
+        case 'b':
+        case 'C':
+        case 'c':
+        case 'U':
+        case 'u':
+            return TRACE_REPORT_BUDGET_US;
+
+        default:
+            return TRACE_LINE_BUDGET_US;
+    }
+}
+
 /* ============================================================================
  * 
  *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
@@ -977,14 +2118,19 @@ void ProcessCommand(char cmd) {
  * ============================================================================ */
 
 int main(void) {
+    /* The cycle counter first - it times everything after it */
+    Trace_Init();
+    
     /* Initialize all peripherals */
-    EnableClocks();
-    ConfigureGPIO();
-    ConfigureUARTGPIO();
-    ConfigureUSART3();
-    ConfigureDelayTimer();
-    ConfigureHeartbeatTimer();
-    ConfigureButtonEXTI();
+    BOOT_PHASE(EnableClocks());
+    BOOT_PHASE(ConfigureGPIO());
+    BOOT_PHASE(ConfigureUARTGPIO());
+    BOOT_PHASE(ConfigureUSART3());
+    BOOT_PHASE(ConfigureDelayTimer());
+    BOOT_PHASE(ConfigureHeartbeatTimer());
+    BOOT_PHASE(ConfigureButtonEXTI());
+    BOOT_PHASE(Persist_Init());
+    load_window_start = DWT_CYCCNT;
     
     LED_AllOff();
     
@@ -995,6 +2141,12 @@ int main(void) {
     UART_SendLine("║    Press H for help                   ║");
     UART_SendLine("╚═══════════════════════════════════════╝");
     UART_SendLine("");
+    Boot_ShowReport();
+    UART_SendString("Boot #");
+    UART_SendNumber(persist.boot_count);
+    UART_SendString(", reset cause: ");
+    UART_SendLine(Reset_Name(reset_flags));
+    UART_SendLine("");
     UART_SendString("> ");
     
     for (;;) {
@@ -1003,20 +2155,29 @@ int main(void) {
          * ═══════════════════════════════════════════════════════════════════ */
         while (!Buffer_IsEmpty(&rx_buffer)) {
             char c = Buffer_Get(&rx_buffer);
+            uint32_t budget_us = Command_BudgetUs(c);
+            uint32_t start = DWT_CYCCNT;
+
+            TRACE_SPAN_BEGIN(TRACE_ID_COMMAND, (uint8_t)c);
             ProcessCommand(c);
+            TRACE_SPAN_END(TRACE_ID_COMMAND);
+
+            /* Over its own budget: something starved this command */
+            TRACE_TRIGGER_IF(budget_us != 0 &&
+                             (DWT_CYCCNT - start) / CPU_CYCLES_PER_US > budget_us,
+                             TRACE_ID_COMMAND, TRACE_RING_SIZE / 4);
             UART_SendString("> ");
         }
         
         /* ═══════════════════════════════════════════════════════════════════
          * HANDLE BUTTON PRESS
          * ═══════════════════════════════════════════════════════════════════ */
-        if (button_pressed) {
-            button_pressed = 0;
-            delay_ms(50);   /* Debounce */
-            
+        if (Button_Debounced()) {
+            TRACE_SPAN_BEGIN(TRACE_ID_BUTTON, 0);
             UART_SendLine("\r\n*** BUTTON PRESSED! ***");
             LED_ToggleGreen();
             UART_SendString("> ");
+            TRACE_SPAN_END(TRACE_ID_BUTTON);
         }
         
         /* ═══════════════════════════════════════════════════════════════════
@@ -1025,11 +2186,19 @@ int main(void) {
         if (heartbeat_tick) {
             heartbeat_tick = 0;
             
+            TRACE_SPAN_BEGIN(TRACE_ID_HEARTBEAT, 0);
+            Persist_SaveUptime();
             UART_SendString("\r\n[Heartbeat] Uptime: ");
             UART_SendNumber(uptime_seconds);
             UART_SendLine(" seconds");
             UART_SendString("> ");
+            TRACE_SPAN_END(TRACE_ID_HEARTBEAT);
         }
+
+        /* ═══════════════════════════════════════════════════════════════════
+         * CPU LOAD WINDOW (every second)
+         * ═══════════════════════════════════════════════════════════════════ */
+        Load_Sample();
     }
 }
 
@@ -1049,6 +2218,8 @@ int main(void) {
  *  • Characters echo as you type
  *  • Heartbeat message appears every 5 seconds
  *  • Press button on board to see message
+ *  • Press T, copy everything between [ and ] into trace.json and open
+ *    it in chrome://tracing or ui.perfetto.dev
  *  
  *  
  *  🎓 WHAT YOU LEARNED:
@@ -1060,6 +2231,12 @@ int main(void) {
  *  ✅ Multiple NVIC Sources: Timer, UART, and EXTI interrupts together
  *  ✅ TIM: Using one timer for delays, another for periodic events
  *  ✅ String Handling: Sending strings over UART
+ *  ✅ Event Tracing: ISR/handler timelines with trigger-and-freeze
+ *  ✅ CPU Load: cycle-accurate time per ISR and handler, 1/10/60 s
+ *  ✅ Boot Profiling: a cycle-counted breakdown of every init step
+ *  ✅ Clock Gating: reference counts, one RMW per RCC register
+ *  ✅ Backup Domain: double-buffered, CRC-checked state across resets
+ *  ✅ Reset Causes: decoding RCC_RSR and keeping a history
  *  
  *  
  *  📚 UART KEY CONCEPTS:
@@ -1078,5 +2255,7 @@ int main(void) {
  *  • Add ADC reading command to show voltage
  *  • Create macros (e.g., "BLINK 5" = blink LED 5 times)
  *  • Log events with RTC timestamps
+ *  • Release GPIOE between yellow LED writes - outputs hold their level
+ *    with the clock off - and watch its on-time in the C report
  * 
  * ============================================================================ */
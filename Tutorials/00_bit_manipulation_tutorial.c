@@ -25,6 +25,7 @@
  *  5. Bit fields and masks
  *  6. The (pin × bits_per_pin) formula
  *  7. Common patterns used in ALL tutorials
+ *  8. Describing each register field ONCE (and letting the compiler check it)
  * 
  *  DIFFICULTY: ⭐ (Beginner - REQUIRED FOUNDATION!)
  * 
@@ -854,6 +855,134 @@ typedef struct {
  * 
  * ============================================================================ */
 
+/* ============================================================================
+ * 
+ *  LESSON 7: DESCRIBE EACH FIELD ONCE
+ *  ===================================
+ * 
+ *  Look at PATTERN 2 again:
+ * 
+ *      GPIOB->MODER &= ~(3U << (PIN * 2));
+ *      GPIOB->MODER |= (1U << (PIN * 2));
+ * 
+ *  The field (position PIN*2, width 2) is written out TWICE, and nothing
+ *  stops you from writing 4U into a 2-bit field - it silently spills into
+ *  the next pin. It also costs TWO read-modify-writes on a volatile
+ *  register, and for a moment the pin is an input.
+ * 
+ *  Better: describe a field once, as "position, width":
+ * 
+ *      #define GPIO_MODER_MODE(pin)    ((pin) * 2U), 2U
+ * 
+ *  and derive everything from it:
+ * 
+ *      FIELD_MASK(f)       → the bits the field covers     (3U << 10)
+ *      FIELD_VAL(f, v)     → v shifted into place          (1U << 10)
+ *      FIELD_GET(reg, f)   → the field's current value
+ * 
+ *  write_fields() updates SEVERAL fields of one register with a SINGLE
+ *  read-modify-write. The masks and values are constants, so the compiler
+ *  folds them into one AND and one OR:
+ * 
+ *      write_fields(GPIOB->MODER, FV(GPIO_MODER_MODE(5), 1),
+ *                                 FV(GPIO_MODER_MODE(6), 2));
+ * 
+ *      →   tmp = GPIOB->MODER;             1 read
+ *          tmp &= ~0x00003C00;             both masks combined
+ *          tmp |=  0x00002400;             both values combined
+ *          GPIOB->MODER = tmp;             1 write
+ * 
+ *  And it is checked at COMPILE time (_Static_assert, C11):
+ *  • FV(GPIO_MODER_MODE(5), 4)  → error: value does not fit its field
+ *  • the same field twice       → error: fields overlap
+ * 
+ *  FIELD_VAL needs a constant value. For values only known at run time
+ *  use FIELD_PREP, which masks instead of checking.
+ * 
+ * ============================================================================ */
+
+/* Largest value a field of this width can hold (width 1..32) */
+#define FIELD_MAX_(width)               (0xFFFFFFFFUL >> (32U - (width)))
+
+/* Compile-time check usable INSIDE an expression: adds 0, costs nothing */
+#define FIELD_ASSERT(cond, msg)         ((uint32_t)(0U * sizeof(struct { _Static_assert(cond, msg); int ok; })))
+
+/* The extra macro level lets "f" expand to "pos, width" first */
+#define FIELD_MASK(...)                 FIELD_MASK_(__VA_ARGS__)
+#define FIELD_MASK_(pos, width)         ((uint32_t)(FIELD_MAX_(width) << (pos)))
+
+#define FIELD_VAL(...)                  FIELD_VAL_(__VA_ARGS__)
+#define FIELD_VAL_(pos, width, v)       (((uint32_t)(v) << (pos)) | \
+                                         FIELD_ASSERT((v) <= FIELD_MAX_(width), "value does not fit its field"))
+
+#define FIELD_PREP(...)                 FIELD_PREP_(__VA_ARGS__)
+#define FIELD_PREP_(pos, width, v)      (((uint32_t)(v) << (pos)) & FIELD_MASK_(pos, width))
+
+#define FIELD_GET(reg, ...)             FIELD_GET_(reg, __VA_ARGS__)
+#define FIELD_GET_(reg, pos, width)     ((uint32_t)(((reg) >> (pos)) & FIELD_MAX_(width)))
+
+/* One field setting = its mask and its value */
+#define FV(f, v)                        FIELD_MASK(f), FIELD_VAL(f, v)
+
+/* Up to 4 settings, one read-modify-write. The argument count picks WFn_. */
+#define write_fields(reg, ...)          WF_PICK_(__VA_ARGS__, WF4_, _, WF3_, _, WF2_, _, WF1_, _)(reg, __VA_ARGS__)
+#define WF_PICK_(a1, a2, a3, a4, a5, a6, a7, a8, name, ...) name
+
+#define WF1_(r, m1, v1)                 ((r) = ((r) & ~(m1)) | (v1))
+#define WF2_(r, m1, v1, m2, v2)         WF1_(r, (m1) | (m2) | WF_DISJOINT_(m1, m2), (v1) | (v2))
+#define WF3_(r, m1, v1, m2, v2, ...)    WF2_(r, (m1) | (m2) | WF_DISJOINT_(m1, m2), (v1) | (v2), __VA_ARGS__)
+#define WF4_(r, m1, v1, m2, v2, ...)    WF3_(r, (m1) | (m2) | WF_DISJOINT_(m1, m2), (v1) | (v2), __VA_ARGS__)
+#define WF_DISJOINT_(m1, m2)            FIELD_ASSERT(((m1) & (m2)) == 0U, "fields overlap")
+
+/* Field descriptions: position, width - written exactly once */
+#define GPIO_MODER_MODE(pin)            ((pin) * 2U), 2U
+#define GPIO_OSPEEDR_OSPEED(pin)        ((pin) * 2U), 2U
+#define GPIO_PUPDR_PUPD(pin)            ((pin) * 2U), 2U
+#define GPIO_AFR_AFSEL(pin)             (((pin) & 7U) * 4U), 4U     /* AFR[pin / 8] */
+
+#define SPI_CFG_DSIZE                   3U, 3U                      /* bits 5:3  */
+#define SPI_CFG_BR                      8U, 3U                      /* bits 10:8 */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 8: ONE WRITE, SEVERAL FIELDS
+ *  ==========================================
+ * 
+ *  Redo EXERCISE 7 with field descriptions, then make PB5 an output and
+ *  PB6 an alternate function with ONE access to MODER.
+ * 
+ * ============================================================================ */
+
+void Exercise8_WriteFields(void) {
+    /* Data size 4, prescaler 5 - same result as EXERCISE 7 */
+    write_fields(FAKE_SPI_CFG, FV(SPI_CFG_DSIZE, 4), FV(SPI_CFG_BR, 5));
+
+    /* ✏️ YOUR TURN: PB5 = output (01), PB6 = alternate function (10) */
+    write_fields(FAKE_GPIOB->MODER, FV(GPIO_MODER_MODE(5), ???),    /* HINT: Output mode value */
+                                    FV(GPIO_MODER_MODE(6), ???));   /* HINT: AF mode value */
+
+    /* PB6 → AF7, very high speed: two registers, one RMW each */
+    write_fields(FAKE_GPIOB->AFR[0], FV(GPIO_AFR_AFSEL(6), 7));
+    write_fields(FAKE_GPIOB->OSPEEDR, FV(GPIO_OSPEEDR_OSPEED(6), 3));
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * write_fields(FAKE_GPIOB->MODER, FV(GPIO_MODER_MODE(5), 1),
+ *                                 FV(GPIO_MODER_MODE(6), 2));
+ * 
+ * EXPLANATION:
+ * 
+ *   FIELD_MASK: (3U << 10) | (3U << 12) = 0x00003C00
+ *   FIELD_VAL:  (1U << 10) | (2U << 12) = 0x00002400
+ * 
+ *   MODER = (MODER & ~0x00003C00) | 0x00002400;   ← one read, one write
+ * 
+ *   Now try FV(GPIO_MODER_MODE(5), 4) - the build stops with
+ *   "value does not fit its field" instead of breaking pin 6.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
 /* ============================================================================
  * 
  *  🎉 CONGRATULATIONS!
@@ -867,6 +996,7 @@ typedef struct {
  *  ✅ Multi-bit fields (2-bit, 4-bit)
  *  ✅ The (pin × bits_per_setting) formula
  *  ✅ Common STM32 programming patterns
+ *  ✅ Field descriptions with compile-time checks and single-RMW writes
  *  
  *  YOU'RE READY FOR THE GPIO TUTORIAL!
  *  
@@ -904,6 +1034,10 @@ int main(void)
     if (example_register & (1U << 7)) {
         /* Yes, bit 7 is set! */
     }
+
+    /* Two fields, one read-modify-write: bits 5:3 = 2, bits 10:8 = 1 */
+    write_fields(example_register, FV(SPI_CFG_DSIZE, 2), FV(SPI_CFG_BR, 1));
+    /* Result: 0b110010001 = 0x191 = 401 */
     
     for(;;) {
         /* Your practice code here */
@@ -296,6 +296,47 @@ void ADC_ConfigureGPIO(void) {
  * GPIOA->MODER |= (3U << (3 * 2));
  * ───────────────────────────────────────────────────────────────────────────── */
 
+/* ============================================================================
+ *  CALIBRATED DELAY
+ *  The regulator wait below is a datasheet number in microseconds. A
+ *  counted CPU-cycle wait (DWT) hits it at any clock and any -O level.
+ * ============================================================================ */
+
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* Counter is off after reset, and the ADC regulator wait is often
+     * the very first delay - start it now. DWT ignores writes until the
+     * M7's LAR is unlocked. */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
+}
+
 /* ============================================================================
  * 
  *  ✏️  EXERCISE 3: INITIALIZE ADC
@@ -313,6 +354,8 @@ void ADC_ConfigureGPIO(void) {
  * 
  * ============================================================================ */
 
+#define ADC_TADCVREG_STUP_US    10U
+
 void ADC_Init(void) {
     /* Step 1: Exit deep power down mode */
     ADC1->CR &= ~ADC_CR_DEEPPWD;
@@ -320,8 +363,8 @@ void ADC_Init(void) {
     /* Step 2: Enable voltage regulator */
     ADC1->CR |= ADC_CR_ADVREGEN;
     
-    /* Wait for voltage regulator startup (~10µs) */
-    for (volatile int i = 0; i < 10000; i++);
+    /* Wait for voltage regulator startup (tADCVREG_STUP, 10 µs max) */
+    delay_us(ADC_TADCVREG_STUP_US);
     
     /* Step 3: Start calibration */
     ADC1->CR |= ADC_CR_ADCAL;
@@ -570,8 +613,8 @@ int main(void)
         /* voltage now contains the analog input in volts (0.0 - 3.3) */
         /* You can send this over UART or use it for control */
         
-        /* Simple delay */
-        for (volatile int i = 0; i < 100000; i++);
+        /* 10 samples per second */
+        delay_ms(100);
     }
 }
 
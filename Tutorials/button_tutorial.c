@@ -0,0 +1,845 @@
+/**
+ ******************************************************************************
+ * @file           : button_tutorial.c
+ * @brief          : Learning non-blocking button debouncing without HAL
+ ******************************************************************************
+ * 
+ *  ██████╗ ████████╗███╗   ██╗    ████████╗██╗   ██╗████████╗ ██████╗ ██████╗ 
+ *  ██╔══██╗╚══██╔══╝████╗  ██║    ╚══██╔══╝██║   ██║╚══██╔══╝██╔═══██╗██╔══██╗
+ *  ██████╔╝   ██║   ██╔██╗ ██║       ██║   ██║   ██║   ██║   ██║   ██║██████╔╝
+ *  ██╔══██╗   ██║   ██║╚██╗██║       ██║   ██║   ██║   ██║   ██║   ██║██╔══██╗
+ *  ██████╔╝   ██║   ██║ ╚████║       ██║   ╚██████╔╝   ██║   ╚██████╔╝██║  ██║
+ *  ╚═════╝    ╚═╝   ╚═╝  ╚═══╝       ╚═╝    ╚═════╝    ╚═╝    ╚═════╝ ╚═╝  ╚═╝
+ * 
+ *  INTERACTIVE LEARNING: BUTTON EVENTS (Debounce, Click, Double-Click, Hold)
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. Why mechanical buttons bounce and why delay_ms(50) is a bad fix
+ *  2. How to debounce with a periodic timer and a shift-register filter
+ *  3. How to let EXTI edges start the sampling timer (no polling when idle)
+ *  4. How to turn clean edges into PRESS / RELEASE / CLICK / DOUBLE-CLICK /
+ *     LONG-PRESS events with timestamps
+ *  5. How to handle MANY inputs with one table and one timer interrupt
+ * 
+ *  PREREQUISITES:
+ *  - Complete the EXTI tutorial first!
+ *  - Complete the TIM tutorial (prescaler, ARR, update interrupt)
+ * 
+ *  HARDWARE:
+ *  - PC13 = USER button on Nucleo-H753ZI (active LOW)
+ *  - PD0, PD1 = optional extra buttons to GND (internal pull-ups enabled)
+ *  - PB0 / PE1 / PB14 = Green / Yellow / Red LEDs
+ * 
+ *  DIFFICULTY: ⭐⭐⭐ (Intermediate)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: WHAT IS CONTACT BOUNCE?
+ *  ==================================
+ * 
+ *  A mechanical switch does NOT close cleanly. The metal contacts hit,
+ *  spring apart and hit again for a few milliseconds:
+ * 
+ *  What you think happens:     What really happens:
+ * 
+ *  ────┐                       ────┐ ┌┐ ┌┐┌─┐
+ *      │                           │ ││ │││ │
+ *      └──────────                 └─┘└─┘└┘ └──────────
+ *                                  ◄── 1-10 ms ──►
+ * 
+ *  Every little spike is an EDGE, so EXTI fires 3, 5, 10 times per press!
+ * 
+ *  THE USUAL "FIX" (used in all four Tutorial Projects until now):
+ * 
+ *      if (button_pressed) {
+ *          button_pressed = 0;
+ *          delay_ms(50);          ← CPU does NOTHING for 50 ms
+ *          ...
+ *      }
+ * 
+ *  Problems:
+ *  ✗ 50 ms of blocked CPU per press: UART bytes are dropped, metronome
+ *    beats are late, the clock display stalls
+ *  ✗ Bounces on RELEASE still set button_pressed again → double triggers
+ *  ✗ Does not scale: 8 buttons = 8 × 50 ms of blocking
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ * 
+ *  LESSON 1: THE SHIFT-REGISTER FILTER
+ *  ====================================
+ * 
+ *  Sample the pin every 1 ms from a timer interrupt and shift the sample
+ *  into an 8-bit history byte:
+ * 
+ *      history = (history << 1) | sample;
+ * 
+ *  ┌───────────────┬──────────────────────────────────────────────┐
+ *  │ history       │ Meaning                                      │
+ *  ├───────────────┼──────────────────────────────────────────────┤
+ *  │ 0b00000000    │ Released for 8 ms in a row → STABLE RELEASED │
+ *  │ 0b11111111    │ Pressed for 8 ms in a row  → STABLE PRESSED  │
+ *  │ 0b01101100    │ Bouncing! → keep the previous stable state   │
+ *  └───────────────┴──────────────────────────────────────────────┘
+ * 
+ *  ✓ Costs a few cycles per button per millisecond
+ *  ✓ Never blocks
+ *  ✓ One timer serves every button (just loop over a table)
+ * 
+ *  LESSON 1b: LET EXTI WAKE THE FILTER
+ *  ────────────────────────────────────
+ * 
+ *  Sampling every 1 ms forever wastes power. Instead:
+ * 
+ *  EXTI edge ──► start TIM6 (1 ms tick) ──► filter + event logic
+ *                      ▲                            │
+ *                      └──── stop TIM6 when every ──┘
+ *                            button is idle again
+ * 
+ *  The edge interrupt does only ONE thing: start the timer.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOB_BASE      0x58020400UL
+#define GPIOC_BASE      0x58020800UL
+#define GPIOD_BASE      0x58020C00UL
+#define GPIOE_BASE      0x58021000UL
+#define EXTI_BASE       0x58000000UL
+#define SYSCFG_BASE     0x58000400UL
+#define TIM2_BASE       0x40000000UL
+#define TIM6_BASE       0x40001000UL
+
+#define NVIC_ISER_BASE  0xE000E100UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t RESERVED1;
+    volatile uint32_t PMCR;
+    volatile uint32_t EXTICR[4];
+} SYSCFG_TypeDef;
+
+typedef struct {
+    volatile uint32_t RTSR1;    /* 0x00 - Rising trigger selection */
+    volatile uint32_t FTSR1;    /* 0x04 - Falling trigger selection */
+    volatile uint32_t SWIER1;   /* 0x08 - Software interrupt event */
+    volatile uint32_t D3PMR1;   /* 0x0C */
+    volatile uint32_t D3PCR1L;  /* 0x10 */
+    volatile uint32_t D3PCR1H;  /* 0x14 */
+    volatile uint32_t RESERVED1[2];
+    volatile uint32_t RTSR2;    /* 0x20 */
+    volatile uint32_t FTSR2;    /* 0x24 */
+    volatile uint32_t SWIER2;   /* 0x28 */
+    volatile uint32_t D3PMR2;   /* 0x2C */
+    volatile uint32_t D3PCR2L;  /* 0x30 */
+    volatile uint32_t D3PCR2H;  /* 0x34 */
+    volatile uint32_t RESERVED2[2];
+    volatile uint32_t RTSR3;    /* 0x40 */
+    volatile uint32_t FTSR3;    /* 0x44 */
+    volatile uint32_t SWIER3;   /* 0x48 */
+    volatile uint32_t D3PMR3;   /* 0x4C */
+    volatile uint32_t D3PCR3L;  /* 0x50 */
+    volatile uint32_t D3PCR3H;  /* 0x54 */
+    volatile uint32_t RESERVED3[10];
+    volatile uint32_t IMR1;     /* 0x80 - CPU interrupt mask */
+    volatile uint32_t EMR1;     /* 0x84 - CPU event mask */
+    volatile uint32_t PR1;      /* 0x88 - Pending register */
+} EXTI_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+} TIM_TypeDef;
+
+#define RCC     ((RCC_TypeDef *) RCC_BASE)
+#define GPIOB   ((GPIO_TypeDef *) GPIOB_BASE)
+#define GPIOC   ((GPIO_TypeDef *) GPIOC_BASE)
+#define GPIOD   ((GPIO_TypeDef *) GPIOD_BASE)
+#define GPIOE   ((GPIO_TypeDef *) GPIOE_BASE)
+#define SYSCFG  ((SYSCFG_TypeDef *) SYSCFG_BASE)
+#define EXTI    ((EXTI_TypeDef *) EXTI_BASE)
+#define TIM2    ((TIM_TypeDef *) TIM2_BASE)
+#define TIM6    ((TIM_TypeDef *) TIM6_BASE)
+
+#define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB4ENR_GPIOBEN     (1U << 1)
+#define RCC_AHB4ENR_GPIOCEN     (1U << 2)
+#define RCC_AHB4ENR_GPIODEN     (1U << 3)
+#define RCC_AHB4ENR_GPIOEEN     (1U << 4)
+#define RCC_APB4ENR_SYSCFGEN    (1U << 1)
+#define RCC_APB1LENR_TIM2EN     (1U << 0)
+#define RCC_APB1LENR_TIM6EN     (1U << 4)
+
+/* TIM */
+#define TIM_CR1_CEN             (1U << 0)
+#define TIM_DIER_UIE            (1U << 0)
+#define TIM_SR_UIF              (1U << 0)
+#define TIM_EGR_UG              (1U << 0)
+
+/* NVIC IRQ numbers */
+#define EXTI0_IRQn              6
+#define EXTI1_IRQn              7
+#define EXTI15_10_IRQn          40
+#define TIM6_DAC_IRQn           54
+
+/* SYSCFG EXTICR port codes */
+#define SYSCFG_EXTICR_PC        2U
+#define SYSCFG_EXTICR_PD        3U
+
+/* LED Pins */
+#define LED_GREEN_PIN           0       /* PB0 */
+#define LED_YELLOW_PIN          1       /* PE1 */
+#define LED_RED_PIN             14      /* PB14 */
+
+/* ============================================================================
+ * 
+ *  LESSON 2: TUNING CONSTANTS
+ *  ===========================
+ * 
+ *  ┌──────────────────────┬────────┬───────────────────────────────────┐
+ *  │ Constant             │ Value  │ Meaning                           │
+ *  ├──────────────────────┼────────┼───────────────────────────────────┤
+ *  │ BTN_SAMPLE_MS        │ 1 ms   │ TIM6 tick (filter sample period)  │
+ *  │ BTN_FILTER_MASK      │ 0xFF   │ 8 equal samples = 8 ms debounce   │
+ *  │ BTN_LONG_PRESS_MS    │ 800 ms │ Held this long → LONG_PRESS       │
+ *  │ BTN_DOUBLE_CLICK_MS  │ 300 ms │ Max gap between two clicks        │
+ *  └──────────────────────┴────────┴───────────────────────────────────┘
+ * 
+ * ============================================================================ */
+
+#define BTN_SAMPLE_MS           1U
+#define BTN_FILTER_MASK         0xFFU
+#define BTN_LONG_PRESS_MS       800U
+#define BTN_DOUBLE_CLICK_MS     300U
+
+/* Event queue length (must be a power of 2) */
+#define BTN_EVENT_QUEUE_SIZE    16U
+
+/* ============================================================================
+ * 
+ *  LESSON 3: ONE TABLE FOR ALL INPUTS
+ *  ===================================
+ * 
+ *  Each input is a row in a table. The timer ISR loops over the table,
+ *  so adding the 9th button is one more line - not one more ISR.
+ * 
+ *  Per input we keep:
+ *  • where it is (port, pin, active level)
+ *  • the filter history byte and the last STABLE level
+ *  • a small click state machine with two timestamps
+ * 
+ *  CLICK STATE MACHINE:
+ * 
+ *            press                release (short)
+ *   IDLE ───────────► DOWN ─────────────────────► WAIT_2ND
+ *    ▲                 │                             │    │
+ *    │    held ≥ 800 ms│ → LONG_PRESS                │    │ press
+ *    │                 ▼                   gap ≥ 300 │    ▼
+ *    │◄── release ── LONG_HELD        ms → CLICK     │  DOWN_2ND
+ *    │◄──────────────────────────────────────────────┘    │
+ *    │◄────────────── release → DOUBLE_CLICK ─────────────┘
+ * 
+ * ============================================================================ */
+
+typedef enum {
+    BTN_EVT_PRESS,          /* Stable press detected */
+    BTN_EVT_RELEASE,        /* Stable release detected */
+    BTN_EVT_CLICK,          /* Short press, no second press followed */
+    BTN_EVT_DOUBLE_CLICK,   /* Two short presses within BTN_DOUBLE_CLICK_MS */
+    BTN_EVT_LONG_PRESS      /* Held for BTN_LONG_PRESS_MS */
+} ButtonEventType_t;
+
+typedef enum {
+    BTN_STATE_IDLE,
+    BTN_STATE_DOWN,
+    BTN_STATE_WAIT_2ND,
+    BTN_STATE_DOWN_2ND,
+    BTN_STATE_LONG_HELD
+} ButtonState_t;
+
+typedef struct {
+    GPIO_TypeDef *port;         /* GPIO port of the input */
+    uint8_t pin;                /* Pin number = EXTI line */
+    uint8_t active_low;         /* 1 = pressed reads as 0 */
+    uint8_t history;            /* Shift-register filter */
+    uint8_t stable;             /* Last debounced level (1 = pressed) */
+    ButtonState_t state;        /* Click state machine */
+    uint32_t press_ms;          /* Timestamp of last stable press */
+    uint32_t release_ms;        /* Timestamp of last stable release */
+} Button_t;
+
+typedef struct {
+    uint8_t button;             /* Index into button table */
+    ButtonEventType_t type;     /* What happened */
+    uint32_t timestamp_ms;      /* When it happened (ms since boot) */
+} ButtonEvent_t;
+
+/* ────────────────────────────────────────────────────────────────────────────
+ * The input table - add a line here for every new button
+ * ──────────────────────────────────────────────────────────────────────────── */
+#define BTN_USER    0
+#define BTN_EXT1    1
+#define BTN_EXT2    2
+
+Button_t buttons[] = {
+    { .port = GPIOC, .pin = 13, .active_low = 1 },     /* USER button PC13 */
+    { .port = GPIOD, .pin = 0,  .active_low = 1 },     /* External PD0 */
+    { .port = GPIOD, .pin = 1,  .active_low = 1 },     /* External PD1 */
+};
+
+#define BTN_COUNT   (sizeof(buttons) / sizeof(buttons[0]))
+
+/* ============================================================================
+ *  GLOBAL STATE
+ * ============================================================================ */
+
+/* Millisecond time base, advanced by TIM6 while it runs */
+volatile uint32_t btn_time_ms = 0;
+
+/* Event queue: TIM6 ISR writes (head), main loop reads (tail) */
+ButtonEvent_t btn_events[BTN_EVENT_QUEUE_SIZE];
+volatile uint8_t btn_event_head = 0;
+volatile uint8_t btn_event_tail = 0;
+volatile uint32_t btn_events_dropped = 0;
+
+/* ============================================================================
+ * 
+ *  STEP 1: ENABLE CLOCKS AND CONFIGURE PINS
+ *  ==========================================
+ * 
+ * ============================================================================ */
+
+void Button_EnableClocks(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOBEN | RCC_AHB4ENR_GPIOCEN
+                  | RCC_AHB4ENR_GPIODEN | RCC_AHB4ENR_GPIOEEN;
+    RCC->APB4ENR |= RCC_APB4ENR_SYSCFGEN;
+    RCC->APB1LENR |= RCC_APB1LENR_TIM2EN | RCC_APB1LENR_TIM6EN;
+    (void)RCC->APB1LENR;
+}
+
+void Button_ConfigureGPIO(void) {
+    /* LEDs as outputs */
+    GPIOB->MODER &= ~(3U << (LED_GREEN_PIN * 2));
+    GPIOB->MODER |= (1U << (LED_GREEN_PIN * 2));
+    GPIOE->MODER &= ~(3U << (LED_YELLOW_PIN * 2));
+    GPIOE->MODER |= (1U << (LED_YELLOW_PIN * 2));
+    GPIOB->MODER &= ~(3U << (LED_RED_PIN * 2));
+    GPIOB->MODER |= (1U << (LED_RED_PIN * 2));
+
+    /* Every button: input mode, pull-up on the external ones */
+    for (uint32_t i = 0; i < BTN_COUNT; i++) {
+        Button_t *b = &buttons[i];
+        b->port->MODER &= ~(3U << (b->pin * 2));
+        if (b->port != GPIOC) {
+            /* PC13 has an external pull-up on the Nucleo board */
+            b->port->PUPDR &= ~(3U << (b->pin * 2));
+            b->port->PUPDR |= (1U << (b->pin * 2));
+        }
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: CONFIGURE THE 1 ms SAMPLING TIMER (TIM6)
+ *  =========================================================
+ * 
+ *  TIM6 is a basic timer: no pins, just a counter and an update interrupt.
+ * 
+ *  64 MHz / (PSC + 1) = 1 MHz       → PSC = 63
+ *  1 MHz  / (ARR + 1) = 1 kHz (1 ms) → ARR = 999
+ * 
+ *  We also start TIM2 as a free-running 1 MHz counter for µs timestamps.
+ *  TIM6 is NOT started here - the first EXTI edge starts it.
+ * 
+ * ============================================================================ */
+
+void Button_ConfigureTimers(void) {
+    /* TIM2: free-running 1 µs counter */
+    TIM2->PSC = 63;
+    TIM2->ARR = 0xFFFFFFFF;
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->SR = 0;
+    TIM2->CR1 |= TIM_CR1_CEN;
+
+    /* ✏️ YOUR TURN: TIM6 prescaler for a 1 MHz count rate */
+    TIM6->PSC = ???;            /* HINT: 64 MHz divided by (PSC + 1) */
+
+    /* ✏️ YOUR TURN: TIM6 auto-reload for a 1 ms update period */
+    TIM6->ARR = ???;            /* HINT: How many 1 µs ticks in 1 ms, minus one? */
+
+    /* Load PSC/ARR, then clear the UIF that UG just set */
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->SR = 0;
+
+    /* ✏️ YOUR TURN: Enable the update interrupt */
+    TIM6->DIER |= ???;          /* HINT: Update Interrupt Enable bit */
+
+    NVIC_ISER[TIM6_DAC_IRQn / 32] = (1U << (TIM6_DAC_IRQn % 32));
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * TIM6->PSC = 63;              // 64 MHz / 64 = 1 MHz
+ * TIM6->ARR = 999;             // 1000 ticks = 1 ms
+ * TIM6->DIER |= TIM_DIER_UIE;
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 2: EXTI - EDGES ONLY START THE TIMER
+ *  ===========================================
+ * 
+ *  Both edges are enabled: a bounce on release must also wake the filter.
+ *  The EXTI handler never decides "pressed" or "released" - it cannot,
+ *  because it only sees bounces. The filter decides.
+ * 
+ * ============================================================================ */
+
+void Button_ConfigureEXTI(void) {
+    for (uint32_t i = 0; i < BTN_COUNT; i++) {
+        Button_t *b = &buttons[i];
+        uint32_t port_code = (b->port == GPIOC) ? SYSCFG_EXTICR_PC : SYSCFG_EXTICR_PD;
+
+        SYSCFG->EXTICR[b->pin / 4] &= ~(0xFU << ((b->pin % 4) * 4));
+        SYSCFG->EXTICR[b->pin / 4] |= (port_code << ((b->pin % 4) * 4));
+
+        EXTI->RTSR1 |= (1U << b->pin);      /* Rising edge */
+        EXTI->FTSR1 |= (1U << b->pin);      /* Falling edge */
+        EXTI->PR1 = (1U << b->pin);         /* Clear stale pending */
+        EXTI->IMR1 |= (1U << b->pin);       /* Unmask */
+    }
+
+    NVIC_ISER[EXTI0_IRQn / 32] = (1U << (EXTI0_IRQn % 32));
+    NVIC_ISER[EXTI1_IRQn / 32] = (1U << (EXTI1_IRQn % 32));
+    NVIC_ISER[EXTI15_10_IRQn / 32] = (1U << (EXTI15_10_IRQn % 32));
+}
+
+/* Start the sampling timer if it is not already running */
+void Button_Kick(void) {
+    if (!(TIM6->CR1 & TIM_CR1_CEN)) {
+        TIM6->CNT = 0;
+        TIM6->CR1 |= TIM_CR1_CEN;
+    }
+}
+
+void EXTI0_IRQHandler(void) {
+    EXTI->PR1 = (1U << 0);
+    Button_Kick();
+}
+
+void EXTI1_IRQHandler(void) {
+    EXTI->PR1 = (1U << 1);
+    Button_Kick();
+}
+
+void EXTI15_10_IRQHandler(void) {
+    if (EXTI->PR1 & (1U << 13)) {
+        EXTI->PR1 = (1U << 13);
+        Button_Kick();
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: THE EVENT QUEUE
+ *  ================================
+ * 
+ *  Same idea as the UART circular buffer in Project 4, but the size is a
+ *  power of 2 so the wrap is a cheap AND instead of a division:
+ * 
+ *      next = (head + 1) & (SIZE - 1);
+ * 
+ *  One writer (TIM6 ISR) and one reader (main loop) → no locking needed.
+ *  When the queue is full we COUNT the loss instead of overwriting.
+ * 
+ * ============================================================================ */
+
+void Button_PostEvent(uint8_t button, ButtonEventType_t type, uint32_t timestamp_ms) {
+    uint8_t next = (btn_event_head + 1) & (BTN_EVENT_QUEUE_SIZE - 1);
+
+    /* ✏️ YOUR TURN: Detect a full queue */
+    if (next == ???) {          /* HINT: Full when the writer would catch the reader */
+        btn_events_dropped++;
+        return;
+    }
+
+    btn_events[btn_event_head].button = button;
+    btn_events[btn_event_head].type = type;
+    btn_events[btn_event_head].timestamp_ms = timestamp_ms;
+    btn_event_head = next;
+}
+
+/* Returns 1 and fills *evt if an event was waiting */
+uint8_t Button_GetEvent(ButtonEvent_t *evt) {
+    if (btn_event_tail == btn_event_head) {
+        return 0;
+    }
+    *evt = btn_events[btn_event_tail];
+    btn_event_tail = (btn_event_tail + 1) & (BTN_EVENT_QUEUE_SIZE - 1);
+    return 1;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (next == btn_event_tail) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: THE SHIFT-REGISTER FILTER
+ *  ==========================================
+ * 
+ *  Read the raw pin, convert to "1 = pressed", shift it into history.
+ *  Return the NEW stable level only when all 8 samples agree.
+ * 
+ * ============================================================================ */
+
+/* Returns 1 if the stable level changed */
+uint8_t Button_Filter(Button_t *b) {
+    uint8_t raw = (b->port->IDR >> b->pin) & 1U;
+    uint8_t sample = b->active_low ? !raw : raw;
+
+    /* ✏️ YOUR TURN: Shift the new sample into the history byte */
+    b->history = (uint8_t)((b->history << 1) | ???);   /* HINT: The normalised pin level */
+
+    /* ✏️ YOUR TURN: 8 pressed samples in a row? */
+    if ((b->history & BTN_FILTER_MASK) == ??? && !b->stable) {  /* HINT: All ones */
+        b->stable = 1;
+        return 1;
+    }
+
+    if ((b->history & BTN_FILTER_MASK) == 0x00 && b->stable) {
+        b->stable = 0;
+        return 1;
+    }
+
+    return 0;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * b->history = (uint8_t)((b->history << 1) | sample);
+ * if ((b->history & BTN_FILTER_MASK) == BTN_FILTER_MASK && !b->stable) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 3: CLICK / DOUBLE-CLICK / LONG-PRESS STATE MACHINE
+ *  =========================================================
+ * 
+ *  Timestamps are taken at the FIRST sample of the stable run, i.e. the
+ *  filter delay (7 ms) is subtracted so the event time matches the moment
+ *  the finger actually moved.
+ * 
+ * ============================================================================ */
+
+#define BTN_FILTER_DELAY_MS     7U
+
+void Button_Update(uint8_t id, uint32_t now) {
+    Button_t *b = &buttons[id];
+
+    if (Button_Filter(b)) {
+        uint32_t t = now - BTN_FILTER_DELAY_MS * BTN_SAMPLE_MS;
+
+        if (b->stable) {
+            /* ─── Stable PRESS ─── */
+            Button_PostEvent(id, BTN_EVT_PRESS, t);
+            b->press_ms = t;
+
+            if (b->state == BTN_STATE_WAIT_2ND) {
+                b->state = BTN_STATE_DOWN_2ND;
+            } else {
+                b->state = BTN_STATE_DOWN;
+            }
+        } else {
+            /* ─── Stable RELEASE ─── */
+            Button_PostEvent(id, BTN_EVT_RELEASE, t);
+            b->release_ms = t;
+
+            switch (b->state) {
+                case BTN_STATE_DOWN:
+                    b->state = BTN_STATE_WAIT_2ND;
+                    break;
+                case BTN_STATE_DOWN_2ND:
+                    Button_PostEvent(id, BTN_EVT_DOUBLE_CLICK, t);
+                    b->state = BTN_STATE_IDLE;
+                    break;
+                default:
+                    b->state = BTN_STATE_IDLE;
+                    break;
+            }
+        }
+        return;
+    }
+
+    /* ─── No edge: check the time-based transitions ─── */
+    switch (b->state) {
+        case BTN_STATE_DOWN:
+            if ((now - b->press_ms) >= BTN_LONG_PRESS_MS) {
+                Button_PostEvent(id, BTN_EVT_LONG_PRESS, now);
+                b->state = BTN_STATE_LONG_HELD;
+            }
+            break;
+        case BTN_STATE_DOWN_2ND:
+            if ((now - b->press_ms) >= BTN_LONG_PRESS_MS) {
+                /* First press was a click, second one became a hold */
+                Button_PostEvent(id, BTN_EVT_CLICK, b->release_ms);
+                Button_PostEvent(id, BTN_EVT_LONG_PRESS, now);
+                b->state = BTN_STATE_LONG_HELD;
+            }
+            break;
+        case BTN_STATE_WAIT_2ND:
+            if ((now - b->release_ms) >= BTN_DOUBLE_CLICK_MS) {
+                Button_PostEvent(id, BTN_EVT_CLICK, b->release_ms);
+                b->state = BTN_STATE_IDLE;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* An input needs no more sampling once it is idle AND settled released */
+uint8_t Button_IsQuiet(const Button_t *b) {
+    return (b->state == BTN_STATE_IDLE) && (b->history == 0x00) && !b->stable;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: THE TIM6 INTERRUPT HANDLER
+ *  ===========================================
+ * 
+ *  Every 1 ms: advance time, update every button, and stop the timer when
+ *  nothing is happening any more. The next EXTI edge restarts it.
+ * 
+ * ============================================================================ */
+
+void TIM6_DAC_IRQHandler(void) {
+    if (TIM6->SR & TIM_SR_UIF) {
+        /* ✏️ YOUR TURN: Clear the update flag */
+        TIM6->SR &= ???;        /* HINT: Clear only UIF (rc_w0 bit) */
+
+        uint32_t now = btn_time_ms += BTN_SAMPLE_MS;
+        uint8_t quiet = 1;
+
+        for (uint8_t i = 0; i < BTN_COUNT; i++) {
+            Button_Update(i, now);
+            if (!Button_IsQuiet(&buttons[i])) {
+                quiet = 0;
+            }
+        }
+
+        /* ✏️ YOUR TURN: Stop sampling when every input is quiet */
+        if (quiet) {
+            TIM6->CR1 &= ???;   /* HINT: Clear the counter enable bit */
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * TIM6->SR &= ~TIM_SR_UIF;
+ * TIM6->CR1 &= ~TIM_CR1_CEN;
+ * 
+ * WHY DOES btn_time_ms ONLY ADVANCE WHILE TIM6 RUNS?
+ *   While TIM6 is stopped no button is busy, so no timeout is pending.
+ *   For a wall-clock timestamp use TIM2->CNT (µs) or the RTC instead.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Seed the filter with the current pin level so boot does not post events */
+void Button_Init(void) {
+    for (uint32_t i = 0; i < BTN_COUNT; i++) {
+        Button_t *b = &buttons[i];
+        uint8_t raw = (b->port->IDR >> b->pin) & 1U;
+        b->stable = b->active_low ? !raw : raw;
+        b->history = b->stable ? 0xFF : 0x00;
+        b->state = b->stable ? BTN_STATE_LONG_HELD : BTN_STATE_IDLE;
+    }
+
+    /* A button held during boot still needs sampling until it is released */
+    for (uint32_t i = 0; i < BTN_COUNT; i++) {
+        if (!Button_IsQuiet(&buttons[i])) {
+            Button_Kick();
+        }
+    }
+}
+
+/* ============================================================================
+ *  LED HELPERS
+ * ============================================================================ */
+
+void LED_ToggleGreen(void)  { GPIOB->ODR ^= (1U << LED_GREEN_PIN); }
+void LED_ToggleYellow(void) { GPIOE->ODR ^= (1U << LED_YELLOW_PIN); }
+void LED_ToggleRed(void)    { GPIOB->ODR ^= (1U << LED_RED_PIN); }
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Click = Green, Double-click = Yellow, Hold = Red
+ * 
+ * ============================================================================ */
+
+/* Press-to-event latency of the last click, in ms (watch it in the debugger) */
+volatile uint32_t last_click_latency_ms = 0;
+
+int main(void)
+{
+    ButtonEvent_t evt;
+
+    Button_EnableClocks();
+    Button_ConfigureGPIO();
+    Button_ConfigureTimers();
+    Button_Init();
+    Button_ConfigureEXTI();
+
+    for (;;) {
+        while (Button_GetEvent(&evt)) {
+            switch (evt.type) {
+                case BTN_EVT_CLICK:
+                    last_click_latency_ms = btn_time_ms - evt.timestamp_ms;
+                    LED_ToggleGreen();
+                    break;
+                case BTN_EVT_DOUBLE_CLICK:
+                    LED_ToggleYellow();
+                    break;
+                case BTN_EVT_LONG_PRESS:
+                    LED_ToggleRed();
+                    break;
+                default:
+                    /* PRESS / RELEASE: raw edges, useful for "hold to repeat" */
+                    break;
+            }
+        }
+
+        /* Nothing to do: sleep until TIM6 or EXTI wakes us up */
+        __asm("wfi");
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've learned non-blocking button handling without HAL:
+ * 
+ *  ✅ Why contacts bounce and why delay_ms() debouncing hurts
+ *  ✅ Shift-register (integrator) filtering from a timer interrupt
+ *  ✅ Using EXTI only to WAKE the filter, then stopping it when idle
+ *  ✅ Click / double-click / long-press detection with a state machine
+ *  ✅ Timestamped events in a lock-free single-producer queue
+ *  ✅ One table + one ISR for any number of inputs
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Add a 4th button: one line in buttons[] and one EXTI vector
+ *  • Add "hold to repeat" (post PRESS again every 100 ms while held)
+ *  • Count btn_events_dropped while mashing all buttons at once
+ *  • Replace delay_ms(50) in the Tutorial Projects with this module
+ * 
+ * ============================================================================ */
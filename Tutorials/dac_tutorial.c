@@ -257,6 +257,46 @@ void DAC_ConfigureGPIO(void) {
  * GPIOA->MODER |= (3U << (4 * 2));
  * ───────────────────────────────────────────────────────────────────────────── */
 
+/* ============================================================================
+ *  CALIBRATED DELAY
+ *  Datasheet waits are in microseconds - count CPU cycles (DWT) rather
+ *  than loop iterations, which shrink or grow with the optimizer.
+ * ============================================================================ */
+
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* DAC_TWAKEUP_US runs before anything else touches DWT, so turn
+     * CYCCNT on here (the M7 needs the LAR key first) */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
+}
+
 /* ============================================================================
  * 
  *  ✏️  EXERCISE 3: INITIALIZE DAC
@@ -264,6 +304,8 @@ void DAC_ConfigureGPIO(void) {
  * 
  * ============================================================================ */
 
+#define DAC_TWAKEUP_US          8U
+
 void DAC_Init(void) {
     /* Configure mode - normal mode with output buffer */
     DAC1->MCR = DAC_MCR_MODE1_BUFFER | DAC_MCR_MODE2_BUFFER;
@@ -271,8 +313,8 @@ void DAC_Init(void) {
     /* ✏️ YOUR TURN: Enable DAC channel 1 */
     DAC1->CR |= ???;                             /* HINT: Which bit enables channel 1? */
     
-    /* Small delay for startup */
-    for (volatile int i = 0; i < 1000; i++);
+    /* Output settles within tWAKEUP (datasheet: 7.5 µs max, buffer on) */
+    delay_us(DAC_TWAKEUP_US);
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
@@ -353,15 +395,11 @@ void DAC_SetVoltage(float voltage) {
  * 
  * ============================================================================ */
 
-void delay(volatile uint32_t count) {
-    while (count--);
-}
-
 /* Generate a sawtooth wave */
 void DAC_SawtoothWave(void) {
     for (uint16_t i = 0; i < 4096; i += 16) {
         DAC_SetValue(i);
-        delay(100);
+        delay_us(10);
     }
 }
 
@@ -370,12 +408,12 @@ void DAC_TriangleWave(void) {
     /* Rising edge */
     for (uint16_t i = 0; i < 4096; i += 16) {
         DAC_SetValue(i);
-        delay(100);
+        delay_us(10);
     }
     /* Falling edge */
     for (uint16_t i = 4095; i > 0; i -= 16) {
         DAC_SetValue(i);
-        delay(100);
+        delay_us(10);
     }
 }
 
@@ -401,13 +439,13 @@ int main(void)
     
     /* Test different voltage levels */
     DAC_SetVoltage(0.0f);       /* 0V */
-    delay(1000000);
+    delay_ms(100);
     
     DAC_SetVoltage(1.65f);      /* 1.65V (half) */
-    delay(1000000);
+    delay_ms(100);
     
     DAC_SetVoltage(3.3f);       /* 3.3V (max) */
-    delay(1000000);
+    delay_ms(100);
     
     for(;;) {
         /* Generate continuous triangle wave */
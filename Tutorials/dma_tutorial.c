@@ -392,7 +392,10 @@ uint16_t DMA_GetRemaining(void) {
  * 
  * ============================================================================ */
 
-/* Test buffers */
+/* Test buffers
+ * DMA1 cannot reach DTCM (0x20000000). If your linker script puts .data
+ * and .bss there, the transfer ends in TEIF - memory_regions_tutorial.c
+ * shows how to place these in AXI SRAM instead. */
 uint32_t source_buffer[16] = {
     0x11111111, 0x22222222, 0x33333333, 0x44444444,
     0x55555555, 0x66666666, 0x77777777, 0x88888888,
@@ -495,7 +495,10 @@ typedef struct {
 #define ETH_RX_DESC_CNT         4
 #define ETH_TX_DESC_CNT         4
 
-/* Buffers and Descriptors (must be in non-cached RAM or cache-managed) */
+/* Buffers and Descriptors (must be in non-cached RAM or cache-managed)
+ * The MAC is a D2 bus master: it cannot reach DTCM. If your linker
+ * script puts .bss in DTCM, place these in SRAM1-3 or AXI SRAM - see
+ * DMA_BUFFER(ETH, D2) in memory_regions_tutorial.c */
 __attribute__((aligned(4))) ETH_DMADescTypeDef RxDescriptors[ETH_RX_DESC_CNT];
 __attribute__((aligned(4))) ETH_DMADescTypeDef TxDescriptors[ETH_TX_DESC_CNT];
 __attribute__((aligned(4))) uint8_t RxBuffer[ETH_RX_DESC_CNT][ETH_RX_BUF_SIZE];
@@ -1019,8 +1022,39 @@ uint16_t BuildEthernetFrame(uint8_t *frame,
  * 
  * ============================================================================ */
 
-void delay(volatile uint32_t count) {
-    while (count--);
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+/* Delays count CPU cycles (DWT) - independent of optimization level */
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* Nothing else in the Ethernet code uses DWT - the first delay
+     * starts the counter, with the Cortex-M7 LAR key */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
 }
 
 /* Our MAC address (use a locally administered address) */
@@ -1070,7 +1104,7 @@ int main(void)
     for(;;) {
         /* Send test frame every second */
         ETH_SendFrame(frame, len);
-        delay(10000000);
+        delay_ms(1000);
         
         /* Check for received frames */
         uint16_t rx_len = ETH_ReceiveFrame(rxframe, sizeof(rxframe));
@@ -0,0 +1,830 @@
+/**
+ ******************************************************************************
+ * @file           : exti_manager_tutorial.c
+ * @brief          : Learning a generic EXTI line manager without HAL
+ ******************************************************************************
+ * 
+ *  ███████╗██╗  ██╗████████╗██╗    ███╗   ███╗ ██████╗ ██████╗ 
+ *  ██╔════╝╚██╗██╔╝╚══██╔══╝██║    ████╗ ████║██╔════╝ ██╔══██╗
+ *  █████╗   ╚███╔╝    ██║   ██║    ██╔████╔██║██║  ███╗██████╔╝
+ *  ██╔══╝   ██╔██╗    ██║   ██║    ██║╚██╔╝██║██║   ██║██╔══██╗
+ *  ███████╗██╔╝ ██╗   ██║   ██║    ██║ ╚═╝ ██║╚██████╔╝██║  ██║
+ *  ╚══════╝╚═╝  ╚═╝   ╚═╝   ╚═╝    ╚═╝     ╚═╝ ╚═════╝ ╚═╝  ╚═╝
+ * 
+ *  INTERACTIVE LEARNING: EXTI MANAGER (Any Pin, Any Edge, Callbacks)
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. How to route ANY port/pin to its EXTI line with SYSCFG EXTICR
+ *  2. How to select rising, falling or both edges per line
+ *  3. How drivers register a callback instead of writing their own ISR
+ *  4. How to service shared vectors (EXTI9_5, EXTI15_10) with CLZ
+ *  5. How to timestamp every edge into a queue for later processing
+ * 
+ *  PREREQUISITES:
+ *  - Complete the EXTI tutorial first! (it wires up PC13 by hand)
+ *  - Complete the TIM tutorial (free-running counter)
+ * 
+ *  HARDWARE:
+ *  - PC13 = USER button on Nucleo-H753ZI (active LOW)
+ *  - PD0, PE9 = optional extra inputs to GND (internal pull-ups enabled)
+ *  - PB0 / PE1 / PB14 = Green / Yellow / Red LEDs
+ * 
+ *  DIFFICULTY: ⭐⭐⭐ (Intermediate)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: WHY HAND-WRITTEN HANDLERS DON'T SCALE
+ *  ================================================
+ * 
+ *  In the EXTI tutorial every function is hard-wired to PC13 / line 13:
+ * 
+ *      void EXTI15_10_IRQHandler(void) {
+ *          if (EXTI->PR1 & EXTI_LINE_13) {
+ *              EXTI->PR1 = EXTI_LINE_13;
+ *              ... toggle LED ...
+ *          }
+ *      }
+ * 
+ *  Fine for ONE button. Now add an encoder (2 lines), a sensor DRDY, a
+ *  PHY interrupt, a limit switch... a dozen inputs later:
+ * 
+ *  ✗ Every driver edits the same shared handler
+ *  ✗ Lines 5-9 and 10-15 share ONE vector each - someone forgets to check
+ *    PR1 for "their" line and steals another driver's edge
+ *  ✗ Each driver re-implements EXTICR math, edge setup, NVIC enable
+ * 
+ *  THE FIX: a small manager that owns EXTI.
+ * 
+ *  ┌────────────┐  EXTI_Register(port, pin, edge, callback)
+ *  │  Driver A  │ ──────────────────────┐
+ *  └────────────┘                       ▼
+ *  ┌────────────┐               ┌───────────────┐   EXTICR / RTSR /
+ *  │  Driver B  │ ────────────► │ EXTI manager  │ ─ FTSR / IMR / NVIC
+ *  └────────────┘               └───────┬───────┘
+ *                                       │ one dispatcher for all vectors
+ *                                       ▼
+ *                          callback(line, timestamp, context)
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ * 
+ *  LESSON 1: THE EXTI VECTOR MAP
+ *  ==============================
+ * 
+ *  16 GPIO lines, but only 7 vectors:
+ * 
+ *  ┌──────────┬──────────────────────┬────────┐
+ *  │ Lines    │ Handler              │ IRQn   │
+ *  ├──────────┼──────────────────────┼────────┤
+ *  │ 0        │ EXTI0_IRQHandler     │ 6      │
+ *  │ 1        │ EXTI1_IRQHandler     │ 7      │
+ *  │ 2        │ EXTI2_IRQHandler     │ 8      │
+ *  │ 3        │ EXTI3_IRQHandler     │ 9      │
+ *  │ 4        │ EXTI4_IRQHandler     │ 10     │
+ *  │ 5 - 9    │ EXTI9_5_IRQHandler   │ 23     │  ← SHARED
+ *  │ 10 - 15  │ EXTI15_10_IRQHandler │ 40     │  ← SHARED
+ *  └──────────┴──────────────────────┴────────┘
+ * 
+ *  And only ONE port per line: PA5 and PC5 can NOT both be interrupts,
+ *  because EXTICR picks a single port for line 5.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOA_BASE      0x58020000UL
+#define GPIO_PORT_STEP  0x400UL         /* GPIOB = GPIOA + 0x400, ... */
+#define EXTI_BASE       0x58000000UL
+#define SYSCFG_BASE     0x58000400UL
+#define TIM2_BASE       0x40000000UL
+
+#define NVIC_ISER_BASE  0xE000E100UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t RESERVED1;
+    volatile uint32_t PMCR;
+    volatile uint32_t EXTICR[4];
+} SYSCFG_TypeDef;
+
+typedef struct {
+    volatile uint32_t RTSR1;    /* 0x00 - Rising trigger selection */
+    volatile uint32_t FTSR1;    /* 0x04 - Falling trigger selection */
+    volatile uint32_t SWIER1;   /* 0x08 - Software interrupt event */
+    volatile uint32_t D3PMR1;   /* 0x0C */
+    volatile uint32_t D3PCR1L;  /* 0x10 */
+    volatile uint32_t D3PCR1H;  /* 0x14 */
+    volatile uint32_t RESERVED1[2];
+    volatile uint32_t RTSR2;    /* 0x20 */
+    volatile uint32_t FTSR2;    /* 0x24 */
+    volatile uint32_t SWIER2;   /* 0x28 */
+    volatile uint32_t D3PMR2;   /* 0x2C */
+    volatile uint32_t D3PCR2L;  /* 0x30 */
+    volatile uint32_t D3PCR2H;  /* 0x34 */
+    volatile uint32_t RESERVED2[2];
+    volatile uint32_t RTSR3;    /* 0x40 */
+    volatile uint32_t FTSR3;    /* 0x44 */
+    volatile uint32_t SWIER3;   /* 0x48 */
+    volatile uint32_t D3PMR3;   /* 0x4C */
+    volatile uint32_t D3PCR3L;  /* 0x50 */
+    volatile uint32_t D3PCR3H;  /* 0x54 */
+    volatile uint32_t RESERVED3[10];
+    volatile uint32_t IMR1;     /* 0x80 - CPU interrupt mask */
+    volatile uint32_t EMR1;     /* 0x84 - CPU event mask */
+    volatile uint32_t PR1;      /* 0x88 - Pending register */
+} EXTI_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+} TIM_TypeDef;
+
+#define RCC     ((RCC_TypeDef *) RCC_BASE)
+#define SYSCFG  ((SYSCFG_TypeDef *) SYSCFG_BASE)
+#define EXTI    ((EXTI_TypeDef *) EXTI_BASE)
+#define TIM2    ((TIM_TypeDef *) TIM2_BASE)
+
+/* Port index → GPIO block (A = 0, B = 1, ... K = 10) */
+#define GPIO_PORT(p)    ((GPIO_TypeDef *) (GPIOA_BASE + (p) * GPIO_PORT_STEP))
+
+#define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_APB4ENR_SYSCFGEN    (1U << 1)
+#define RCC_APB1LENR_TIM2EN     (1U << 0)
+
+/* TIM */
+#define TIM_CR1_CEN             (1U << 0)
+#define TIM_EGR_UG              (1U << 0)
+
+/* NVIC IRQ numbers */
+#define EXTI0_IRQn              6
+#define EXTI1_IRQn              7
+#define EXTI2_IRQn              8
+#define EXTI3_IRQn              9
+#define EXTI4_IRQn              10
+#define EXTI9_5_IRQn            23
+#define EXTI15_10_IRQn          40
+
+/* Lines served by each shared vector */
+#define EXTI_LINES_9_5          0x000003E0U     /* bits 5..9   */
+#define EXTI_LINES_15_10        0x0000FC00U     /* bits 10..15 */
+
+/* GPIO ports (this is also the EXTICR code: PA = 0, PB = 1, ...) */
+#define PORT_A  0U
+#define PORT_B  1U
+#define PORT_C  2U
+#define PORT_D  3U
+#define PORT_E  4U
+
+/* LED Pins */
+#define LED_GREEN_PIN           0       /* PB0 */
+#define LED_YELLOW_PIN          1       /* PE1 */
+#define LED_RED_PIN             14      /* PB14 */
+
+/* ============================================================================
+ * 
+ *  LESSON 2: THE LINE TABLE
+ *  =========================
+ * 
+ *  One row per EXTI line. A driver owns a line by putting its callback
+ *  there; the dispatcher never needs to know who the driver is.
+ * 
+ *  The callback gets:
+ *  • line          - which pin moved (0..15)
+ *  • level         - pin level read right after the edge (1 = high)
+ *  • timestamp_us  - TIM2 count taken at the START of the ISR
+ *  • context       - the pointer the driver passed in (its own state)
+ * 
+ *  ⚠️ Callbacks run in interrupt context: keep them SHORT. Anything slow
+ *     goes through the edge queue to the main loop instead.
+ * 
+ * ============================================================================ */
+
+typedef enum {
+    EXTI_EDGE_RISING  = 1,      /* 0 → 1 */
+    EXTI_EDGE_FALLING = 2,      /* 1 → 0 */
+    EXTI_EDGE_BOTH    = 3       /* Either */
+} EXTI_Edge_t;
+
+typedef enum {
+    EXTI_PULL_NONE = 0,         /* PUPDR = 00 */
+    EXTI_PULL_UP   = 1,         /* PUPDR = 01 */
+    EXTI_PULL_DOWN = 2          /* PUPDR = 10 */
+} EXTI_Pull_t;
+
+typedef void (*EXTI_Callback_t)(uint8_t line, uint8_t level,
+                                uint32_t timestamp_us, void *context);
+
+typedef struct {
+    EXTI_Callback_t callback;   /* NULL = line is free */
+    void *context;              /* Handed back to the callback */
+    uint8_t port;               /* PORT_A .. PORT_K */
+    uint8_t queue;              /* 1 = also record edges in the queue */
+    uint32_t edge_count;        /* Edges seen on this line */
+} EXTI_Line_t;
+
+/* ============================================================================
+ * 
+ *  LESSON 3: THE TIMESTAMP QUEUE
+ *  ==============================
+ * 
+ *  Every edge on a "queued" line is recorded as (line, level, time).
+ *  TIM2 runs free at 1 MHz, so the main loop can measure pulse widths,
+ *  encoder speed or interrupt latency long after the ISR has returned.
+ * 
+ *  Power-of-2 ring: wrap is an AND, one writer (ISR) and one reader
+ *  (main loop) → no locking. A full queue COUNTS the loss.
+ * 
+ *  Several EXTI vectors can nest (different priorities), so the push is
+ *  done with interrupts masked for the few cycles it takes.
+ * 
+ * ============================================================================ */
+
+#define EXTI_QUEUE_SIZE         32U     /* Must be a power of 2 */
+#define EXTI_NUM_GPIO_LINES     16U
+
+typedef struct {
+    uint32_t timestamp_us;      /* TIM2 count at ISR entry */
+    uint8_t line;               /* EXTI line 0..15 */
+    uint8_t level;              /* Pin level after the edge */
+} EXTI_EdgeEvent_t;
+
+/* ============================================================================
+ *  GLOBAL STATE
+ * ============================================================================ */
+
+EXTI_Line_t exti_lines[EXTI_NUM_GPIO_LINES];
+
+EXTI_EdgeEvent_t exti_queue[EXTI_QUEUE_SIZE];
+volatile uint8_t exti_queue_head = 0;
+volatile uint8_t exti_queue_tail = 0;
+volatile uint32_t exti_queue_dropped = 0;
+
+/* Edges that arrived on a line nobody registered (should stay 0) */
+volatile uint32_t exti_spurious = 0;
+
+/* ============================================================================
+ * 
+ *  STEP 1: CLOCKS AND TIMESTAMP COUNTER
+ *  ======================================
+ * 
+ *  TIM2 runs free at 64 MHz / 64 = 1 MHz → 1 count = 1 µs,
+ *  wraps after ~71 minutes. Subtracting two uint32_t counts is
+ *  correct across the wrap.
+ * 
+ * ============================================================================ */
+
+void EXTI_ManagerInit(void) {
+    RCC->APB4ENR |= RCC_APB4ENR_SYSCFGEN;
+    RCC->APB1LENR |= RCC_APB1LENR_TIM2EN;
+    (void)RCC->APB1LENR;
+
+    TIM2->PSC = 63;
+    TIM2->ARR = 0xFFFFFFFF;
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->SR = 0;
+    TIM2->CR1 |= TIM_CR1_CEN;
+
+    for (uint32_t i = 0; i < EXTI_NUM_GPIO_LINES; i++) {
+        exti_lines[i].callback = NULL;
+        exti_lines[i].edge_count = 0;
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: ROUTE ANY PORT/PIN TO ITS LINE
+ *  ===============================================
+ * 
+ *  Same formula you used for PC13 - now with variables:
+ * 
+ *  EXTICR[pin / 4]      ← which of the 4 registers
+ *  (pin % 4) * 4        ← which 4-bit field inside it
+ *  port                 ← value to write (PA = 0, PB = 1, PC = 2 ...)
+ * 
+ *  Example: PE9 → EXTICR[2], bits [7:4] = 4
+ * 
+ * ============================================================================ */
+
+void EXTI_ConfigureSource(uint8_t port, uint8_t pin) {
+    uint32_t shift = (pin % 4) * 4;
+
+    /* ✏️ YOUR TURN: Clear the 4-bit field for this line */
+    SYSCFG->EXTICR[pin / 4] &= ???;     /* HINT: Inverted 0xF at the field position */
+
+    /* ✏️ YOUR TURN: Select the port */
+    SYSCFG->EXTICR[pin / 4] |= ???;     /* HINT: Port code at the field position */
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * SYSCFG->EXTICR[pin / 4] &= ~(0xFU << shift);
+ * SYSCFG->EXTICR[pin / 4] |= ((uint32_t)port << shift);
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: EDGE SELECTION FOR ANY LINE
+ *  ============================================
+ * 
+ *  RTSR1 and FTSR1 are independent: set a line's bit in BOTH to get an
+ *  interrupt on either edge. Always write both registers, so calling
+ *  this again with a different edge really changes it.
+ * 
+ * ============================================================================ */
+
+void EXTI_ConfigureEdge(uint8_t line, EXTI_Edge_t edge) {
+    uint32_t mask = (1U << line);
+
+    /* ✏️ YOUR TURN: Rising edge on or off */
+    if (edge & ???) {                   /* HINT: Which enum bit means rising? */
+        EXTI->RTSR1 |= mask;
+    } else {
+        EXTI->RTSR1 &= ~mask;
+    }
+
+    if (edge & EXTI_EDGE_FALLING) {
+        EXTI->FTSR1 |= mask;
+    } else {
+        EXTI->FTSR1 &= ~mask;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (edge & EXTI_EDGE_RISING) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Line number → NVIC vector that serves it */
+uint8_t EXTI_LineToIRQn(uint8_t line) {
+    if (line <= 4) {
+        return (uint8_t)(EXTI0_IRQn + line);    /* 6, 7, 8, 9, 10 */
+    }
+    if (line <= 9) {
+        return EXTI9_5_IRQn;
+    }
+    return EXTI15_10_IRQn;
+}
+
+void EXTI_EnableInterrupt(uint8_t line) {
+    uint8_t irq = EXTI_LineToIRQn(line);
+
+    EXTI->PR1 = (1U << line);           /* Drop any stale pending edge */
+    EXTI->IMR1 |= (1U << line);         /* Unmask */
+
+    /* Enabling an already-enabled vector is harmless (ISER is write-1-to-set) */
+    NVIC_ISER[irq / 32] = (1U << (irq % 32));
+}
+
+void EXTI_DisableInterrupt(uint8_t line) {
+    /* Only mask the LINE - the vector may still serve other lines */
+    EXTI->IMR1 &= ~(1U << line);
+    EXTI->PR1 = (1U << line);
+}
+
+/* ============================================================================
+ * 
+ *  STEP 2: THE REGISTRATION API
+ *  ==============================
+ * 
+ *  One call does everything a driver used to do by hand:
+ * 
+ *      EXTI_Register(PORT_D, 0, EXTI_EDGE_BOTH, EXTI_PULL_UP,
+ *                    Encoder_OnEdge, &encoder, 1);
+ * 
+ *  Returns 0 on success, -1 if the line is already owned. Two drivers
+ *  can never share a line (EXTICR only holds one port for it anyway).
+ * 
+ * ============================================================================ */
+
+int EXTI_Register(uint8_t port, uint8_t pin, EXTI_Edge_t edge, EXTI_Pull_t pull,
+                  EXTI_Callback_t callback, void *context, uint8_t queue) {
+    GPIO_TypeDef *gpio = GPIO_PORT(port);
+    EXTI_Line_t *l;
+
+    if (pin >= EXTI_NUM_GPIO_LINES || callback == NULL) {
+        return -1;
+    }
+
+    l = &exti_lines[pin];
+    if (l->callback != NULL) {
+        return -1;                      /* Line already taken */
+    }
+
+    /* GPIO clock, input mode, pull resistor */
+    RCC->AHB4ENR |= (1U << port);
+    (void)RCC->AHB4ENR;
+    gpio->MODER &= ~(3U << (pin * 2));
+    gpio->PUPDR &= ~(3U << (pin * 2));
+    gpio->PUPDR |= ((uint32_t)pull << (pin * 2));
+
+    /* Fill the table BEFORE unmasking, the first edge may come right away */
+    l->context = context;
+    l->port = port;
+    l->queue = queue;
+    l->edge_count = 0;
+    l->callback = callback;
+
+    EXTI_ConfigureSource(port, pin);
+    EXTI_ConfigureEdge(pin, edge);
+    EXTI_EnableInterrupt(pin);
+
+    return 0;
+}
+
+void EXTI_Unregister(uint8_t line) {
+    EXTI_DisableInterrupt(line);
+    EXTI->RTSR1 &= ~(1U << line);
+    EXTI->FTSR1 &= ~(1U << line);
+    exti_lines[line].callback = NULL;
+}
+
+/* ============================================================================
+ * 
+ *  STEP 3: THE EDGE QUEUE
+ *  =======================
+ * 
+ * ============================================================================ */
+
+void EXTI_QueuePush(uint8_t line, uint8_t level, uint32_t timestamp_us) {
+    uint32_t primask;
+    uint8_t next;
+
+    /* Save PRIMASK and mask interrupts (nested EXTI vectors also push) */
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+
+    next = (exti_queue_head + 1) & (EXTI_QUEUE_SIZE - 1);
+    if (next == exti_queue_tail) {
+        exti_queue_dropped++;
+    } else {
+        exti_queue[exti_queue_head].timestamp_us = timestamp_us;
+        exti_queue[exti_queue_head].line = line;
+        exti_queue[exti_queue_head].level = level;
+        exti_queue_head = next;
+    }
+
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+}
+
+/* Returns 1 and fills *evt if an edge was waiting */
+uint8_t EXTI_QueuePop(EXTI_EdgeEvent_t *evt) {
+    if (exti_queue_tail == exti_queue_head) {
+        return 0;
+    }
+    *evt = exti_queue[exti_queue_tail];
+    exti_queue_tail = (exti_queue_tail + 1) & (EXTI_QUEUE_SIZE - 1);
+    return 1;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 4: FINDING SET BITS WITH CLZ
+ *  ====================================
+ * 
+ *  The shared handler must service EVERY pending line in its group.
+ *  Testing 6 bits one by one works, but Cortex-M7 has an instruction
+ *  that finds the highest set bit in ONE cycle:
+ * 
+ *      CLZ = Count Leading Zeros
+ * 
+ *      pending = 0b0000_0000_0000_0000_0010_0100_0000_0000
+ *                                         ↑     ↑
+ *                                     line 13  line 10
+ * 
+ *      CLZ(pending) = 18   →   line = 31 - 18 = 13
+ *      clear bit 13, repeat →  CLZ = 21 → line 10
+ *      pending = 0 → done
+ * 
+ *  The loop runs once per PENDING line, not once per POSSIBLE line.
+ * 
+ *  ⚠️ CLZ(0) = 32 - only call it while pending != 0.
+ * 
+ * ============================================================================ */
+
+uint32_t EXTI_CLZ(uint32_t value) {
+    uint32_t result;
+    __asm volatile ("CLZ %0, %1" : "=r" (result) : "r" (value));
+    return result;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: THE COMMON DISPATCHER
+ *  ======================================
+ * 
+ *  Every vector calls this with the set of lines it serves.
+ * 
+ *  ORDER MATTERS:
+ *  1. Take the timestamp FIRST (closest to the real edge)
+ *  2. Read PR1, keep only our group and only unmasked lines
+ *  3. Clear exactly those bits (W1C) BEFORE the callbacks - an edge that
+ *     arrives during a callback then sets PR1 again and is not lost
+ *  4. Walk the set bits with CLZ
+ * 
+ * ============================================================================ */
+
+void EXTI_Dispatch(uint32_t group_mask) {
+    uint32_t now = TIM2->CNT;
+    uint32_t pending = EXTI->PR1 & EXTI->IMR1 & group_mask;
+
+    /* ✏️ YOUR TURN: Clear all the pending lines we are about to service */
+    EXTI->PR1 = ???;                    /* HINT: W1C - write exactly the bits we took */
+
+    while (pending) {
+        /* ✏️ YOUR TURN: Highest pending line number */
+        uint8_t line = (uint8_t)(??? - EXTI_CLZ(pending));  /* HINT: Bit 31 has CLZ = 0 */
+        EXTI_Line_t *l = &exti_lines[line];
+
+        pending &= ~(1U << line);
+
+        if (l->callback == NULL) {
+            exti_spurious++;
+            continue;
+        }
+
+        uint8_t level = (GPIO_PORT(l->port)->IDR >> line) & 1U;
+
+        l->edge_count++;
+        if (l->queue) {
+            EXTI_QueuePush(line, level, now);
+        }
+        l->callback(line, level, now, l->context);
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * EXTI->PR1 = pending;
+ * uint8_t line = (uint8_t)(31 - EXTI_CLZ(pending));
+ * 
+ * WHY "& EXTI->IMR1"?
+ *   PR1 latches edges even on masked lines. Without the mask a disabled
+ *   line would still be "serviced" whenever a neighbour fires.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 4: THE VECTORS - NOW ONE LINE EACH
+ *  =========================================
+ * 
+ *  These never change again, no matter how many drivers register.
+ * 
+ * ============================================================================ */
+
+void EXTI0_IRQHandler(void)     { EXTI_Dispatch(1U << 0); }
+void EXTI1_IRQHandler(void)     { EXTI_Dispatch(1U << 1); }
+void EXTI2_IRQHandler(void)     { EXTI_Dispatch(1U << 2); }
+void EXTI3_IRQHandler(void)     { EXTI_Dispatch(1U << 3); }
+void EXTI4_IRQHandler(void)     { EXTI_Dispatch(1U << 4); }
+void EXTI9_5_IRQHandler(void)   { EXTI_Dispatch(EXTI_LINES_9_5); }
+void EXTI15_10_IRQHandler(void) { EXTI_Dispatch(EXTI_LINES_15_10); }
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: WRITE A DRIVER CALLBACK
+ *  ========================================
+ * 
+ *  The USER button (PC13, active LOW) toggles the green LED on every
+ *  press. The callback gets the pin level, so with EXTI_EDGE_BOTH it can
+ *  tell press from release without reading GPIO itself.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    GPIO_TypeDef *led_port;
+    uint8_t led_pin;
+    uint32_t presses;
+} LedButton_t;
+
+void LedButton_OnEdge(uint8_t line, uint8_t level, uint32_t timestamp_us, void *context) {
+    LedButton_t *lb = (LedButton_t *)context;
+
+    (void)line;
+    (void)timestamp_us;
+
+    /* ✏️ YOUR TURN: Only act on the PRESS (button is active low) */
+    if (level == ???) {                 /* HINT: Pressed reads as...? */
+        lb->led_port->ODR ^= (1U << lb->led_pin);
+        lb->presses++;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (level == 0) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* A counter-only callback: all the work happens from the queue */
+void Counter_OnEdge(uint8_t line, uint8_t level, uint32_t timestamp_us, void *context) {
+    (void)line;
+    (void)level;
+    (void)timestamp_us;
+    (*(volatile uint32_t *)context)++;
+}
+
+/* ============================================================================
+ *  LED HELPERS
+ * ============================================================================ */
+
+void LED_Init(void) {
+    RCC->AHB4ENR |= (1U << PORT_B) | (1U << PORT_E);
+    (void)RCC->AHB4ENR;
+
+    GPIO_PORT(PORT_B)->MODER &= ~(3U << (LED_GREEN_PIN * 2));
+    GPIO_PORT(PORT_B)->MODER |= (1U << (LED_GREEN_PIN * 2));
+    GPIO_PORT(PORT_E)->MODER &= ~(3U << (LED_YELLOW_PIN * 2));
+    GPIO_PORT(PORT_E)->MODER |= (1U << (LED_YELLOW_PIN * 2));
+    GPIO_PORT(PORT_B)->MODER &= ~(3U << (LED_RED_PIN * 2));
+    GPIO_PORT(PORT_B)->MODER |= (1U << (LED_RED_PIN * 2));
+}
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Three drivers, three vectors, zero hand-written ISRs
+ * 
+ *  • PC13 (line 13, shared EXTI15_10) - USER button toggles green LED
+ *  • PD0  (line 0,  own EXTI0)        - pulse input, widths measured
+ *  • PE9  (line 9,  shared EXTI9_5)   - edge counter
+ * 
+ * ============================================================================ */
+
+LedButton_t user_button = { .led_port = GPIO_PORT(PORT_B), .led_pin = LED_GREEN_PIN };
+volatile uint32_t pd0_edges = 0;
+volatile uint32_t pe9_edges = 0;
+
+/* Width of the last LOW pulse on PD0 in µs (watch it in the debugger) */
+volatile uint32_t pd0_low_width_us = 0;
+
+int main(void)
+{
+    EXTI_EdgeEvent_t evt;
+    uint32_t pd0_fall_us = 0;
+
+    EXTI_ManagerInit();
+    LED_Init();
+
+    EXTI_Register(PORT_C, 13, EXTI_EDGE_BOTH, EXTI_PULL_NONE,
+                  LedButton_OnEdge, &user_button, 1);
+    EXTI_Register(PORT_D, 0, EXTI_EDGE_BOTH, EXTI_PULL_UP,
+                  Counter_OnEdge, (void *)&pd0_edges, 1);
+    EXTI_Register(PORT_E, 9, EXTI_EDGE_FALLING, EXTI_PULL_UP,
+                  Counter_OnEdge, (void *)&pe9_edges, 0);
+
+    /* PC9 is line 9 too - already owned by PE9, so this claim fails */
+    if (EXTI_Register(PORT_C, 9, EXTI_EDGE_RISING, EXTI_PULL_NONE,
+                      Counter_OnEdge, (void *)&pe9_edges, 0) != 0) {
+        GPIO_PORT(PORT_E)->ODR |= (1U << LED_YELLOW_PIN);
+    }
+
+    for (;;) {
+        while (EXTI_QueuePop(&evt)) {
+            if (evt.line == 0) {
+                if (evt.level == 0) {
+                    pd0_fall_us = evt.timestamp_us;
+                } else {
+                    pd0_low_width_us = evt.timestamp_us - pd0_fall_us;
+                }
+            }
+        }
+
+        /* Red LED = the queue overflowed at least once */
+        if (exti_queue_dropped) {
+            GPIO_PORT(PORT_B)->ODR |= (1U << LED_RED_PIN);
+        }
+
+        __asm("wfi");
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've built an EXTI manager without HAL:
+ * 
+ *  ✅ Any port/pin → EXTI line through SYSCFG EXTICR
+ *  ✅ Rising / falling / both edges per line
+ *  ✅ Drivers register callbacks with their own context pointer
+ *  ✅ Shared vectors serviced with CLZ, one pass per pending line
+ *  ✅ Pending bits cleared before callbacks so no edge is lost
+ *  ✅ µs timestamps for every edge in an interrupt-safe queue
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Register a quadrature encoder on two lines and decode it from the
+ *    queue using the level + timestamp of each edge
+ *  • Measure ISR latency: drive a GPIO from another pin, compare
+ *    TIM2->CNT before the write with the queued timestamp
+ *  • Port button_tutorial.c to EXTI_Register() - its three handlers
+ *    collapse into one callback
+ *  • Use NVIC priorities so EXTI0 can preempt EXTI15_10, then check the
+ *    queue push still never corrupts an entry
+ * 
+ * ============================================================================ */
@@ -31,6 +31,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 
 /* ============================================================================
  * 
@@ -107,14 +108,20 @@ typedef struct {
     volatile uint32_t CRCEADD1;     /* 0x58 */
     volatile uint32_t CRCDATA;      /* 0x5C */
     volatile uint32_t ECC_FA1;      /* 0x60 */
-    volatile uint32_t RESERVED1[39];/* 0x64-0xFC */
-    volatile uint32_t KEYR2;        /* 0x100 - Key register bank 2 */
-    volatile uint32_t RESERVED2;    /* 0x104 */
-    volatile uint32_t CR2;          /* 0x108 - Control register bank 2 */
-    volatile uint32_t SR2;          /* 0x10C - Status register bank 2 */
-    volatile uint32_t CCR2;         /* 0x110 - Clear control register bank 2 */
+    volatile uint32_t RESERVED1[40];/* 0x64-0x100 */
+    volatile uint32_t KEYR2;        /* 0x104 - Key register bank 2 */
+    volatile uint32_t RESERVED2;    /* 0x108 */
+    volatile uint32_t CR2;          /* 0x10C - Control register bank 2 */
+    volatile uint32_t SR2;          /* 0x110 - Status register bank 2 */
+    volatile uint32_t CCR2;         /* 0x114 - Clear control register bank 2 */
 } FLASH_TypeDef;
 
+/* Offsets from RM0433 - a miscounted RESERVED array fails the build */
+_Static_assert(offsetof(FLASH_TypeDef, CCR1) == 0x014, "FLASH_CCR1 offset");
+_Static_assert(offsetof(FLASH_TypeDef, CRCCR1) == 0x050, "FLASH_CRCCR1 offset");
+_Static_assert(offsetof(FLASH_TypeDef, KEYR2) == 0x104, "FLASH_KEYR2 offset");
+_Static_assert(offsetof(FLASH_TypeDef, CCR2) == 0x114, "FLASH_CCR2 offset");
+
 #define FLASH   ((FLASH_TypeDef *) FLASH_BASE)
 
 /* ============================================================================
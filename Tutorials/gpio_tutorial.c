@@ -639,10 +639,50 @@ void GPIO_SetAlternateFunction(GPIO_TypeDef *port, uint8_t pin, uint8_t af) {
 
 /* ============================================================================
  *  DELAY HELPER
+ *  ============
+ *  
+ *  A "while (count--)" loop takes as long as the compiler makes it: -O0
+ *  and -O2 differ several times over, and a faster clock shortens it
+ *  again. The DWT cycle counter counts real CPU clocks, so a wait in
+ *  cycles is the same at any optimization level:
+ *  
+ *      cycles = microseconds × (CPU_CLOCK_HZ / 1,000,000)
+ *  
+ *  Only CPU_CLOCK_HZ has to match the clock the core really runs at.
  * ============================================================================ */
 
-void delay(volatile uint32_t count) {
-    while (count--);
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* CYCCNT only runs once TRCENA and CYCCNTENA are set. On the M7 the
+     * DWT also ignores writes until LAR gets its key. */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
 }
 
 /* ============================================================================
@@ -675,7 +715,7 @@ int main(void)
             LED_On();
         } else {
             LED_Toggle();
-            delay(1000000);
+            delay_ms(100);
         }
     }
 }
@@ -0,0 +1,1115 @@
+/**
+ ******************************************************************************
+ * @file           : i2c_async_tutorial.c
+ * @brief          : Learning an interrupt/DMA driven I2C engine without HAL
+ ******************************************************************************
+ * 
+ *  ██╗██████╗  ██████╗     █████╗ ███████╗██╗   ██╗███╗   ██╗ ██████╗
+ *  ██║╚════██╗██╔════╝    ██╔══██╗██╔════╝╚██╗ ██╔╝████╗  ██║██╔════╝
+ *  ██║ █████╔╝██║         ███████║███████╗ ╚████╔╝ ██╔██╗ ██║██║     
+ *  ██║██╔═══╝ ██║         ██╔══██║╚════██║  ╚██╔╝  ██║╚██╗██║██║     
+ *  ██║███████╗╚██████╗    ██║  ██║███████║   ██║   ██║ ╚████║╚██████╗
+ *  ╚═╝╚══════╝ ╚═════╝    ╚═╝  ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═══╝ ╚═════╝
+ * 
+ *  INTERACTIVE LEARNING: I2C WITHOUT WAITING (Interrupts, DMA, Queue)
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. Why the polled I2C driver wastes almost all of its time
+ *  2. How to describe write, read and write-then-read as ONE struct
+ *  3. How to run a transfer from the event (EV) interrupt
+ *  4. How to hand long transfers to DMA
+ *  5. How to report NACK, arbitration loss, bus error and timeout
+ *     per transaction instead of hanging forever
+ *  6. How to discover every device on the bus (address scan)
+ *  7. How to poll each device at its own rate and measure latency and
+ *     bus occupancy
+ * 
+ *  PREREQUISITES:
+ *  - Complete the I2C tutorial first! (CR2, NBYTES, AUTOEND, TXIS/RXNE)
+ *  - Complete the SPI DMA tutorial (transaction queue, callbacks)
+ *  - Complete the DMA tutorial (streams, DMAMUX)
+ * 
+ *  HARDWARE:
+ *  - I2C1: PB8 = SCL, PB9 = SDA (AF4, open-drain, 4.7 kΩ pull-ups)
+ *  - Any mix of TMP102 (0x48..0x4F), MPU6050 (0x68/0x69) and
+ *    BMP280 (0x76/0x77) - the scan finds them
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐ (Advanced)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: WHERE DOES THE TIME GO?
+ *  ==================================
+ * 
+ *  At 100 kHz one byte (8 bits + ACK) takes 90 µs. The polled driver in
+ *  the I2C tutorial sits in while (!(I2C1->ISR & ...)) for all of it:
+ * 
+ *  Reading a 2-byte temperature = addr + reg + addr + 2 data ≈ 450 µs
+ *  8 sensors                                                  ≈ 3.6 ms
+ *  CPU work actually needed                                   ≈ 10 µs
+ * 
+ *  And worse: if a sensor does not ACK, or somebody holds SDA low, the
+ *  polled driver never leaves its while() loop.
+ * 
+ *  THE FIX:
+ *  • Let the I2C peripheral raise an interrupt for every event
+ *  • Let DMA move the bytes of long transfers
+ *  • Give every transaction a status and a timeout
+ *  • Queue transactions so the next one starts the moment the bus is free
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOB_BASE      0x58020400UL
+#define I2C1_BASE       0x40005400UL
+#define TIM2_BASE       0x40000000UL
+#define TIM7_BASE       0x40001400UL
+#define DMA1_BASE       0x40020000UL
+#define DMAMUX1_BASE    0x40020800UL
+
+/* DMA1 streams used here */
+#define DMA1_Stream2    (DMA1_BASE + 0x040)     /* I2C1 RX */
+#define DMA1_Stream3    (DMA1_BASE + 0x058)     /* I2C1 TX */
+
+#define NVIC_ISER_BASE  0xE000E100UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;      /* 0x00 - Control register 1 */
+    volatile uint32_t CR2;      /* 0x04 - Control register 2 */
+    volatile uint32_t OAR1;     /* 0x08 - Own address register 1 */
+    volatile uint32_t OAR2;     /* 0x0C - Own address register 2 */
+    volatile uint32_t TIMINGR;  /* 0x10 - Timing register */
+    volatile uint32_t TIMEOUTR; /* 0x14 - Timeout register */
+    volatile uint32_t ISR;      /* 0x18 - Interrupt and status register */
+    volatile uint32_t ICR;      /* 0x1C - Interrupt clear register */
+    volatile uint32_t PECR;     /* 0x20 - PEC register */
+    volatile uint32_t RXDR;     /* 0x24 - Receive data register */
+    volatile uint32_t TXDR;     /* 0x28 - Transmit data register */
+} I2C_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+} TIM_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR;       /* Stream configuration */
+    volatile uint32_t NDTR;     /* Number of data items */
+    volatile uint32_t PAR;      /* Peripheral address */
+    volatile uint32_t M0AR;     /* Memory 0 address */
+    volatile uint32_t M1AR;     /* Memory 1 address (double buffer) */
+    volatile uint32_t FCR;      /* FIFO control */
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    volatile uint32_t LISR;     /* Low interrupt status (streams 0-3) */
+    volatile uint32_t HISR;     /* High interrupt status (streams 4-7) */
+    volatile uint32_t LIFCR;    /* Low interrupt flag clear */
+    volatile uint32_t HIFCR;    /* High interrupt flag clear */
+} DMA_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define GPIOB       ((GPIO_TypeDef *) GPIOB_BASE)
+#define I2C1        ((I2C_TypeDef *) I2C1_BASE)
+#define TIM2        ((TIM_TypeDef *) TIM2_BASE)
+#define TIM7        ((TIM_TypeDef *) TIM7_BASE)
+#define DMA1        ((DMA_TypeDef *) DMA1_BASE)
+#define DMA1_S2     ((DMA_Stream_TypeDef *) DMA1_Stream2)
+#define DMA1_S3     ((DMA_Stream_TypeDef *) DMA1_Stream3)
+
+/* DMAMUX1 channel n feeds DMA1 stream n (one CCR per channel, 4 bytes apart) */
+#define DMAMUX1_CCR ((volatile uint32_t *) DMAMUX1_BASE)
+
+#define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB4ENR_GPIOBEN     (1U << 1)
+#define RCC_AHB1ENR_DMA1EN      (1U << 0)
+#define RCC_APB1LENR_TIM2EN     (1U << 0)
+#define RCC_APB1LENR_TIM7EN     (1U << 5)
+#define RCC_APB1LENR_I2C1EN     (1U << 21)
+
+/* I2C_CR1 */
+#define I2C_CR1_PE              (1U << 0)   /* Peripheral enable */
+#define I2C_CR1_TXIE            (1U << 1)   /* TXIS interrupt */
+#define I2C_CR1_RXIE            (1U << 2)   /* RXNE interrupt */
+#define I2C_CR1_NACKIE          (1U << 4)   /* NACK interrupt */
+#define I2C_CR1_STOPIE          (1U << 5)   /* STOP detected interrupt */
+#define I2C_CR1_TCIE            (1U << 6)   /* Transfer complete interrupt */
+#define I2C_CR1_ERRIE           (1U << 7)   /* BERR / ARLO / OVR / TIMEOUT */
+#define I2C_CR1_TXDMAEN         (1U << 14)  /* TX DMA request */
+#define I2C_CR1_RXDMAEN         (1U << 15)  /* RX DMA request */
+#define I2C_CR1_IE_ALL          (I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_NACKIE \
+                                 | I2C_CR1_STOPIE | I2C_CR1_TCIE | I2C_CR1_ERRIE)
+
+/* I2C_CR2 */
+#define I2C_CR2_RD_WRN          (1U << 10)  /* 0 = write, 1 = read */
+#define I2C_CR2_START           (1U << 13)
+#define I2C_CR2_STOP            (1U << 14)
+#define I2C_CR2_NBYTES_Pos      16U
+#define I2C_CR2_AUTOEND         (1U << 25)
+
+/* I2C_ISR */
+#define I2C_ISR_TXE             (1U << 0)
+#define I2C_ISR_TXIS            (1U << 1)
+#define I2C_ISR_RXNE            (1U << 2)
+#define I2C_ISR_NACKF           (1U << 4)
+#define I2C_ISR_STOPF           (1U << 5)
+#define I2C_ISR_TC              (1U << 6)
+#define I2C_ISR_BERR            (1U << 8)   /* Misplaced START/STOP */
+#define I2C_ISR_ARLO            (1U << 9)   /* Arbitration lost */
+#define I2C_ISR_OVR             (1U << 10)  /* Overrun (slave mode only) */
+#define I2C_ISR_TIMEOUT         (1U << 12)  /* SMBus timeout (TIMEOUTR) */
+#define I2C_ISR_BUSY            (1U << 15)
+
+/* I2C_ICR */
+#define I2C_ICR_NACKCF          (1U << 4)
+#define I2C_ICR_STOPCF          (1U << 5)
+#define I2C_ICR_BERRCF          (1U << 8)
+#define I2C_ICR_ARLOCF          (1U << 9)
+#define I2C_ICR_OVRCF           (1U << 10)
+#define I2C_ICR_TIMOUTCF        (1U << 12)
+#define I2C_ICR_ALL             0x00003F38U
+
+/* TIM */
+#define TIM_CR1_CEN             (1U << 0)
+#define TIM_DIER_UIE            (1U << 0)
+#define TIM_SR_UIF              (1U << 0)
+#define TIM_EGR_UG              (1U << 0)
+
+/* DMA_SxCR */
+#define DMA_CR_EN               (1U << 0)
+#define DMA_CR_TEIE             (1U << 2)
+#define DMA_CR_DIR_P2M          (0U << 6)
+#define DMA_CR_DIR_M2P          (1U << 6)
+#define DMA_CR_MINC             (1U << 10)
+#define DMA_CR_PL_HIGH          (2U << 16)
+
+/* DMA LISR / LIFCR: stream 2 flags at bit 16, stream 3 flags at bit 22 */
+#define DMA_FLAGS_ALL           0x3DU       /* FEIF | DMEIF | TEIF | HTIF | TCIF */
+#define DMA_FLAG_TEIF           0x08U
+#define DMA_S2_SHIFT            16U
+#define DMA_S3_SHIFT            22U
+
+/* DMAMUX request IDs */
+#define DMAMUX_REQ_I2C1_RX      33
+#define DMAMUX_REQ_I2C1_TX      34
+
+/* NVIC */
+#define DMA1_Stream2_IRQn       13
+#define DMA1_Stream3_IRQn       14
+#define I2C1_EV_IRQn            31
+#define I2C1_ER_IRQn            32
+#define TIM7_IRQn               55
+
+/* Pins */
+#define GPIO_AF4_I2C1           4U
+#define LED_GREEN_PIN           0           /* PB0 */
+#define LED_RED_PIN             14          /* PB14 */
+
+/* Same 100 kHz timing as the I2C tutorial (64 MHz kernel clock) */
+#define I2C_TIMING_100KHZ       0x40E03758UL
+
+/* Transfers at least this long use DMA, shorter ones use TXIS/RXNE */
+#define I2C_DMA_THRESHOLD       8U
+
+/* ============================================================================
+ * 
+ *  LESSON 1: ONE STRUCT, THREE KINDS OF TRANSFER
+ *  ==============================================
+ * 
+ *  ┌───────────────┬────────┬────────┬─────────────────────────────────┐
+ *  │ Kind          │ tx_len │ rx_len │ On the wire                     │
+ *  ├───────────────┼────────┼────────┼─────────────────────────────────┤
+ *  │ Write         │ > 0    │ 0      │ S addr+W data... P              │
+ *  │ Read          │ 0      │ > 0    │ S addr+R data... P              │
+ *  │ Write-Read    │ > 0    │ > 0    │ S addr+W reg Sr addr+R data.. P │
+ *  │ Probe         │ 0      │ 0      │ S addr+W P  (ACK = present)     │
+ *  └───────────────┴────────┴────────┴─────────────────────────────────┘
+ *  S = START, Sr = repeated START, P = STOP
+ * 
+ *  Like the SPI DMA tutorial, the caller OWNS the transaction and its
+ *  buffers until the callback has run; the queue only stores pointers.
+ * 
+ *  Each phase is at most 255 bytes here (one NBYTES load). The I2C
+ *  tutorial shows how RELOAD chains longer transfers.
+ * 
+ * ============================================================================ */
+
+typedef enum {
+    I2C_TXN_IDLE,               /* Never submitted / recycled */
+    I2C_TXN_QUEUED,             /* Waiting for the bus */
+    I2C_TXN_ACTIVE,             /* On the wire right now */
+    I2C_TXN_DONE,               /* Finished OK */
+    I2C_TXN_NACK,               /* Address or data byte not acknowledged */
+    I2C_TXN_ARLO,               /* Lost arbitration to another master */
+    I2C_TXN_BUS_ERROR,          /* Misplaced START/STOP or DMA error */
+    I2C_TXN_TIMEOUT             /* Did not finish within timeout_ms */
+} I2C_TxnStatus_t;
+
+struct I2C_Txn;
+typedef void (*I2C_Callback_t)(struct I2C_Txn *txn);
+
+typedef struct I2C_Txn {
+    uint8_t addr;               /* 7-bit slave address */
+    const uint8_t *tx;          /* Write phase (register, data) */
+    uint8_t tx_len;             /* 0 = no write phase */
+    uint8_t *rx;                /* Read phase */
+    uint8_t rx_len;             /* 0 = no read phase */
+    uint16_t timeout_ms;        /* 0 = use I2C_DEFAULT_TIMEOUT_MS */
+    I2C_Callback_t callback;    /* Called from the ISR, may be NULL */
+    void *context;              /* Free for the driver */
+    volatile I2C_TxnStatus_t status;
+} I2C_Txn_t;
+
+#define I2C_DEFAULT_TIMEOUT_MS  10U
+
+/* ============================================================================
+ *  GLOBAL STATE
+ * ============================================================================ */
+
+#define I2C_QUEUE_SIZE          16U     /* Must be a power of 2 */
+
+I2C_Txn_t *i2c_queue[I2C_QUEUE_SIZE];
+volatile uint8_t i2c_queue_head = 0;    /* Written by Submit */
+volatile uint8_t i2c_queue_tail = 0;    /* Written by the ISR */
+
+I2C_Txn_t *volatile i2c_active = NULL;  /* Transaction on the wire */
+volatile uint8_t i2c_in_read_phase = 0;
+volatile uint16_t i2c_index = 0;        /* Byte position (interrupt mode) */
+volatile I2C_TxnStatus_t i2c_result;    /* Reported when STOP arrives */
+volatile uint16_t i2c_timeout_left = 0; /* ms, counted down by TIM7 */
+
+/* Statistics - watch them in the debugger */
+volatile uint32_t i2c_txn_completed = 0;
+volatile uint32_t i2c_txn_nack = 0;
+volatile uint32_t i2c_txn_errors = 0;   /* ARLO, bus error, timeout */
+volatile uint32_t i2c_txn_start_us = 0; /* TIM2 stamp of the active START */
+volatile uint32_t i2c_bus_busy_us = 0;  /* Time with a transaction on the wire */
+
+/* ============================================================================
+ * 
+ *  STEP 1: CLOCKS, PINS, DMA ROUTING AND THE TIMEOUT TICK
+ *  =======================================================
+ * 
+ *  All four interrupts (I2C EV, I2C ER, DMA, TIM7) stay at the default
+ *  priority 0, so none of them can interrupt another. That is what makes
+ *  it safe for each of them to finish the active transaction.
+ * 
+ * ============================================================================ */
+
+void I2C_Engine_InitHardware(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOBEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB1LENR |= RCC_APB1LENR_I2C1EN | RCC_APB1LENR_TIM2EN | RCC_APB1LENR_TIM7EN;
+    (void)RCC->APB1LENR;
+
+    /* PB8 = SCL, PB9 = SDA: AF4, open-drain, pull-up, high speed */
+    for (uint32_t pin = 8; pin <= 9; pin++) {
+        GPIOB->MODER &= ~(3U << (pin * 2));
+        GPIOB->MODER |= (2U << (pin * 2));
+        GPIOB->OTYPER |= (1U << pin);
+        GPIOB->OSPEEDR |= (3U << (pin * 2));
+        GPIOB->PUPDR &= ~(3U << (pin * 2));
+        GPIOB->PUPDR |= (1U << (pin * 2));
+        GPIOB->AFR[1] &= ~(0xFU << ((pin - 8) * 4));
+        GPIOB->AFR[1] |= (GPIO_AF4_I2C1 << ((pin - 8) * 4));
+    }
+
+    /* LEDs */
+    GPIOB->MODER &= ~((3U << (LED_GREEN_PIN * 2)) | (3U << (LED_RED_PIN * 2)));
+    GPIOB->MODER |= (1U << (LED_GREEN_PIN * 2)) | (1U << (LED_RED_PIN * 2));
+
+    I2C1->CR1 = 0;
+    I2C1->TIMINGR = I2C_TIMING_100KHZ;
+    I2C1->CR1 = I2C_CR1_PE;
+
+    /* DMA stream → request routing, done once */
+    DMAMUX1_CCR[2] = DMAMUX_REQ_I2C1_RX;    /* Stream 2 = I2C1 RX */
+    DMAMUX1_CCR[3] = DMAMUX_REQ_I2C1_TX;    /* Stream 3 = I2C1 TX */
+
+    /* TIM2: free-running 1 µs counter for latency and occupancy */
+    TIM2->PSC = 63;
+    TIM2->ARR = 0xFFFFFFFF;
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->CR1 |= TIM_CR1_CEN;
+    
+    /* TIM7: 1 ms tick for transaction timeouts */
+    TIM7->PSC = 63;                         /* 64 MHz / 64 = 1 MHz */
+    TIM7->ARR = 999;
+    TIM7->EGR = TIM_EGR_UG;
+    TIM7->SR = 0;
+    TIM7->DIER |= TIM_DIER_UIE;
+    TIM7->CR1 |= TIM_CR1_CEN;
+
+    NVIC_ISER[I2C1_EV_IRQn / 32] = (1U << (I2C1_EV_IRQn % 32));
+    NVIC_ISER[I2C1_ER_IRQn / 32] = (1U << (I2C1_ER_IRQn % 32));
+    NVIC_ISER[DMA1_Stream2_IRQn / 32] = (1U << (DMA1_Stream2_IRQn % 32));
+    NVIC_ISER[DMA1_Stream3_IRQn / 32] = (1U << (DMA1_Stream3_IRQn % 32));
+    NVIC_ISER[TIM7_IRQn / 32] = (1U << (TIM7_IRQn % 32));
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: START ONE PHASE
+ *  ================================
+ * 
+ *  CR2 for a phase:
+ *  • SADD    = addr << 1
+ *  • RD_WRN  = 1 for the read phase
+ *  • NBYTES  = bytes in this phase
+ *  • AUTOEND = 1 only in the LAST phase → hardware sends STOP.
+ *              In the write phase of a write-read we leave it at 0: the
+ *              peripheral then sets TC and holds SCL low until we write
+ *              the repeated START.
+ *  • START
+ * 
+ *  Bytes move either by DMA (long) or by TXIE/RXIE interrupts (short).
+ * 
+ * ============================================================================ */
+
+void I2C_Engine_StartPhase(I2C_Txn_t *txn, uint8_t read) {
+    uint8_t len = read ? txn->rx_len : txn->tx_len;
+    uint8_t last = read || (txn->rx_len == 0);
+    uint32_t cr1 = I2C_CR1_PE | I2C_CR1_NACKIE | I2C_CR1_STOPIE
+                 | I2C_CR1_TCIE | I2C_CR1_ERRIE;
+    uint32_t cr2;
+
+    i2c_in_read_phase = read;
+    i2c_index = 0;
+
+    if (len >= I2C_DMA_THRESHOLD) {
+        if (read) {
+            DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S2_SHIFT);
+            DMA1_S2->CR = 0;
+            DMA1_S2->PAR = (uint32_t)&I2C1->RXDR;
+            DMA1_S2->M0AR = (uint32_t)txn->rx;
+            DMA1_S2->NDTR = len;
+            DMA1_S2->CR = DMA_CR_DIR_P2M | DMA_CR_MINC | DMA_CR_PL_HIGH | DMA_CR_TEIE;
+            DMA1_S2->CR |= DMA_CR_EN;
+            cr1 |= I2C_CR1_RXDMAEN;
+        } else {
+            DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S3_SHIFT);
+            DMA1_S3->CR = 0;
+            DMA1_S3->PAR = (uint32_t)&I2C1->TXDR;
+            DMA1_S3->M0AR = (uint32_t)txn->tx;
+            DMA1_S3->NDTR = len;
+            DMA1_S3->CR = DMA_CR_DIR_M2P | DMA_CR_MINC | DMA_CR_PL_HIGH | DMA_CR_TEIE;
+            DMA1_S3->CR |= DMA_CR_EN;
+            cr1 |= I2C_CR1_TXDMAEN;
+        }
+    } else if (len > 0) {
+        cr1 |= read ? I2C_CR1_RXIE : I2C_CR1_TXIE;
+    }
+    I2C1->CR1 = cr1;
+
+    cr2 = ((uint32_t)(txn->addr << 1) & 0xFEU)
+        | ((uint32_t)len << I2C_CR2_NBYTES_Pos);
+    if (read) {
+        cr2 |= I2C_CR2_RD_WRN;
+    }
+
+    /* ✏️ YOUR TURN: Automatic STOP only after the last phase */
+    if (last) {
+        cr2 |= ???;                     /* HINT: See LESSON 4 of the I2C tutorial */
+    }
+
+    I2C1->CR2 = cr2 | I2C_CR2_START;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * cr2 |= I2C_CR2_AUTOEND;
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 2: FINISHING, ABORTING AND CHAINING
+ *  =========================================
+ * 
+ *  Clearing PE is the reset button of the I2C state machine: it releases
+ *  SCL/SDA and clears every flag, while keeping TIMINGR. The reference
+ *  manual asks for PE to stay low for at least 3 APB clock cycles. A
+ *  counted loop only guesses at that; one TIM2 microsecond is hundreds
+ *  of APB cycles at any bus clock.
+ * 
+ * ============================================================================ */
+
+/* Busy wait on the TIM2 µs counter. The first tick can come right after
+ * the start stamp, so ask for one more than the minimum. */
+void delay_us(uint32_t us) {
+    uint32_t start = TIM2->CNT;
+    while ((TIM2->CNT - start) < us);
+}
+
+void I2C_Engine_Abort(void) {
+    I2C1->CR1 &= ~I2C_CR1_PE;
+    while (I2C1->CR1 & I2C_CR1_PE);
+    delay_us(2);                        /* >= 1 µs with PE low */
+    I2C1->CR1 = I2C_CR1_PE;
+}
+
+void I2C_Engine_StartNext(void) {
+    I2C_Txn_t *txn;
+
+    if (i2c_queue_tail == i2c_queue_head) {
+        i2c_active = NULL;              /* Bus idle */
+        return;
+    }
+    txn = i2c_queue[i2c_queue_tail];
+    i2c_queue_tail = (i2c_queue_tail + 1) & (I2C_QUEUE_SIZE - 1);
+
+    i2c_active = txn;
+    i2c_result = I2C_TXN_DONE;
+    i2c_timeout_left = txn->timeout_ms ? txn->timeout_ms : I2C_DEFAULT_TIMEOUT_MS;
+    txn->status = I2C_TXN_ACTIVE;
+    i2c_txn_start_us = TIM2->CNT;
+
+    /* A probe (no data at all) is an empty WRITE - an empty read would
+     * let the slave drive SDA with nobody clocking it out */
+    I2C_Engine_StartPhase(txn, txn->tx_len == 0 && txn->rx_len > 0);
+}
+
+void I2C_Engine_Finish(I2C_TxnStatus_t status) {
+    I2C_Txn_t *txn = i2c_active;
+
+    DMA1_S2->CR &= ~DMA_CR_EN;
+    DMA1_S3->CR &= ~DMA_CR_EN;
+    I2C1->CR1 &= ~(I2C_CR1_IE_ALL | I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN);
+    I2C1->ICR = I2C_ICR_ALL;
+
+    if (txn == NULL) {
+        return;
+    }
+    txn->status = status;
+    i2c_bus_busy_us += TIM2->CNT - i2c_txn_start_us;
+
+    if (status == I2C_TXN_DONE) {
+        i2c_txn_completed++;
+    } else if (status == I2C_TXN_NACK) {
+        i2c_txn_nack++;
+    } else {
+        i2c_txn_errors++;
+    }
+
+    if (txn->callback) {
+        txn->callback(txn);
+    }
+
+    I2C_Engine_StartNext();
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: THE EVENT INTERRUPT
+ *  ====================================
+ * 
+ *  ┌────────┬────────────────────────────────────────────────────────┐
+ *  │ Flag   │ What to do                                             │
+ *  ├────────┼────────────────────────────────────────────────────────┤
+ *  │ TXIS   │ Write the next byte to TXDR (interrupt mode only)      │
+ *  │ RXNE   │ Read the next byte from RXDR (interrupt mode only)     │
+ *  │ NACKF  │ Remember "NACK". In master mode the hardware sends     │
+ *  │        │ STOP by itself, so STOPF follows.                      │
+ *  │ TC     │ Write phase done without AUTOEND → repeated START      │
+ *  │ STOPF  │ Transaction over → finish with the remembered result   │
+ *  └────────┴────────────────────────────────────────────────────────┘
+ * 
+ *  RXNE is handled BEFORE STOPF: the last byte and STOP can arrive in
+ *  the same interrupt.
+ * 
+ * ============================================================================ */
+
+void I2C1_EV_IRQHandler(void) {
+    uint32_t isr = I2C1->ISR;
+    uint32_t cr1 = I2C1->CR1;
+    I2C_Txn_t *txn = i2c_active;
+
+    if (txn == NULL) {
+        I2C1->CR1 &= ~I2C_CR1_IE_ALL;   /* Spurious - nothing on the wire */
+        return;
+    }
+
+    if (isr & I2C_ISR_NACKF) {
+        I2C1->ICR = I2C_ICR_NACKCF;
+        I2C1->ISR = I2C_ISR_TXE;        /* Flush a byte stuck in TXDR */
+        i2c_result = I2C_TXN_NACK;
+    }
+
+    if ((isr & I2C_ISR_TXIS) && (cr1 & I2C_CR1_TXIE)) {
+        /* ✏️ YOUR TURN: Next byte of the write phase */
+        I2C1->TXDR = txn->tx[???];      /* HINT: Post-increment the byte position */
+    }
+
+    if ((isr & I2C_ISR_RXNE) && (cr1 & I2C_CR1_RXIE)) {
+        txn->rx[i2c_index++] = (uint8_t)I2C1->RXDR;
+    }
+
+    if ((isr & I2C_ISR_TC) && !i2c_in_read_phase) {
+        /* ✏️ YOUR TURN: Switch to the read phase (repeated START) */
+        I2C1->CR1 &= ~(I2C_CR1_TXIE | I2C_CR1_TXDMAEN);
+        I2C_Engine_StartPhase(txn, ???);    /* HINT: 1 = read */
+    }
+
+    if (isr & I2C_ISR_STOPF) {
+        I2C1->ICR = I2C_ICR_STOPCF;
+        I2C_Engine_Finish(i2c_result);
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * I2C1->TXDR = txn->tx[i2c_index++];
+ * I2C_Engine_StartPhase(txn, 1);
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: THE ERROR INTERRUPT, DMA ERRORS AND TIMEOUTS
+ *  =============================================================
+ * 
+ *  After ARLO or BERR the state machine is in an unknown state, so we
+ *  reset it with I2C_Engine_Abort() before the next transaction.
+ * 
+ *  A slave that holds SCL low forever (clock stretching gone wrong)
+ *  raises NO flag at all - only the TIM7 countdown catches it.
+ * 
+ * ============================================================================ */
+
+void I2C1_ER_IRQHandler(void) {
+    uint32_t isr = I2C1->ISR;
+    I2C_TxnStatus_t status;
+
+    /* ✏️ YOUR TURN: Which flag means another master won the bus? */
+    if (isr & ???) {                    /* HINT: Arbitration lost */
+        status = I2C_TXN_ARLO;
+    } else if (isr & I2C_ISR_TIMEOUT) {
+        status = I2C_TXN_TIMEOUT;
+    } else {
+        status = I2C_TXN_BUS_ERROR;
+    }
+
+    I2C1->ICR = I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF | I2C_ICR_TIMOUTCF;
+    I2C_Engine_Abort();
+    I2C_Engine_Finish(status);
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (isr & I2C_ISR_ARLO) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void DMA1_Stream2_IRQHandler(void) {
+    if (DMA1->LISR & (DMA_FLAG_TEIF << DMA_S2_SHIFT)) {
+        DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S2_SHIFT);
+        I2C_Engine_Abort();
+        I2C_Engine_Finish(I2C_TXN_BUS_ERROR);
+    }
+}
+
+void DMA1_Stream3_IRQHandler(void) {
+    if (DMA1->LISR & (DMA_FLAG_TEIF << DMA_S3_SHIFT)) {
+        DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S3_SHIFT);
+        I2C_Engine_Abort();
+        I2C_Engine_Finish(I2C_TXN_BUS_ERROR);
+    }
+}
+
+volatile uint32_t tick_ms = 0;
+
+/* Optional periodic work, called from the 1 ms tick (e.g. a scheduler) */
+void (*volatile i2c_tick_hook)(uint32_t now_ms) = NULL;
+
+void TIM7_IRQHandler(void) {
+    if (TIM7->SR & TIM_SR_UIF) {
+        TIM7->SR &= ~TIM_SR_UIF;
+        tick_ms++;
+
+        if (i2c_active != NULL && i2c_timeout_left > 0) {
+            if (--i2c_timeout_left == 0) {
+                I2C_Engine_Abort();
+                I2C_Engine_Finish(I2C_TXN_TIMEOUT);
+            }
+        }
+
+        if (i2c_tick_hook != NULL) {
+            i2c_tick_hook(tick_ms);
+        }
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: SUBMITTING A TRANSACTION
+ *  =========================================
+ * 
+ *  Same pattern as SPI_Bus_Submit(): a short critical section, and the
+ *  bus is only kicked if it is idle. Safe to call from a callback.
+ * 
+ *  Returns 0 if queued, -1 if the queue is full or the txn is invalid.
+ *  tx_len = rx_len = 0 is allowed: that is a probe (see LESSON 2).
+ * 
+ * ============================================================================ */
+
+int I2C_Engine_Submit(I2C_Txn_t *txn) {
+    uint32_t primask;
+    uint8_t next;
+    int result = 0;
+
+    if (txn == NULL || (txn->tx_len && !txn->tx) || (txn->rx_len && !txn->rx)) {
+        return -1;
+    }
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+
+    next = (i2c_queue_head + 1) & (I2C_QUEUE_SIZE - 1);
+    if (next == i2c_queue_tail) {
+        result = -1;
+    } else {
+        txn->status = I2C_TXN_QUEUED;
+        i2c_queue[i2c_queue_head] = txn;
+        i2c_queue_head = next;
+
+        /* ✏️ YOUR TURN: Bus idle → start it now */
+        if (i2c_active == ???) {        /* HINT: No transaction on the wire */
+            I2C_Engine_StartNext();
+        }
+    }
+
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+    return result;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (i2c_active == NULL) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Spin until a transaction is finished (for code that must be blocking) */
+I2C_TxnStatus_t I2C_Engine_Wait(I2C_Txn_t *txn) {
+    while (txn->status == I2C_TXN_QUEUED || txn->status == I2C_TXN_ACTIVE) {
+        __asm("wfi");
+    }
+    return txn->status;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 2: WHO IS ON THE BUS?
+ *  =============================
+ * 
+ *  A device that exists ACKs its address. So we send an EMPTY write
+ *  (NBYTES = 0, AUTOEND) to every legal 7-bit address:
+ * 
+ *      0x08 ... 0x77    (0x00-0x07 and 0x78-0x7F are reserved)
+ * 
+ *      ACK  → STOPF, status DONE → present
+ *      NACK → STOPF, status NACK → empty
+ * 
+ *  Each probe is ~ 20 bit times (200 µs @ 100 kHz), and the callback of
+ *  one probe submits the next, so the whole scan is ~ 25 ms and runs
+ *  entirely from interrupts. A 2 ms timeout per probe keeps a stuck
+ *  address from stalling it.
+ * 
+ * ============================================================================ */
+
+#define I2C_SCAN_FIRST          0x08
+#define I2C_SCAN_LAST           0x77
+#define I2C_SCAN_TIMEOUT_MS     2U
+
+uint8_t i2c_found[128];                 /* 1 = address ACKed */
+volatile uint8_t i2c_found_count = 0;
+volatile uint8_t i2c_scan_done = 0;
+
+I2C_Txn_t scan_txn;
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 5: A SELF-CHAINING SCAN
+ *  =====================================
+ * 
+ * ============================================================================ */
+
+void Scan_OnDone(I2C_Txn_t *txn) {
+    /* ✏️ YOUR TURN: Which status means "somebody answered"? */
+    if (txn->status == ???) {           /* HINT: The address was ACKed */
+        i2c_found[txn->addr] = 1;
+        i2c_found_count++;
+    }
+
+    if (txn->addr < I2C_SCAN_LAST) {
+        txn->addr++;
+        I2C_Engine_Submit(txn);         /* Next address, straight from the ISR */
+    } else {
+        i2c_scan_done = 1;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (txn->status == I2C_TXN_DONE) {
+ * 
+ * NOTE: Some devices misbehave on an empty write (a few EEPROMs start a
+ * write cycle). They still ACK, so the scan stays correct.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void I2C_Scan(void) {
+    for (uint32_t i = 0; i < 128; i++) {
+        i2c_found[i] = 0;
+    }
+    i2c_found_count = 0;
+    i2c_scan_done = 0;
+
+    scan_txn.addr = I2C_SCAN_FIRST;
+    scan_txn.tx_len = 0;
+    scan_txn.rx_len = 0;
+    scan_txn.timeout_ms = I2C_SCAN_TIMEOUT_MS;
+    scan_txn.callback = Scan_OnDone;
+    I2C_Engine_Submit(&scan_txn);
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 3: EVERY DEVICE AT ITS OWN RATE
+ *  =======================================
+ * 
+ *  ┌──────────┬─────────┬──────────┬────────┬──────────────────────┐
+ *  │ Device   │ Address │ Register │ Bytes  │ Period               │
+ *  ├──────────┼─────────┼──────────┼────────┼──────────────────────┤
+ *  │ MPU6050  │ 0x68/69 │ 0x3B     │ 14     │ 10 ms  (100 Hz)      │
+ *  │ BMP280   │ 0x76/77 │ 0xF7     │ 6      │ 50 ms  (20 Hz)       │
+ *  │ TMP102   │ 0x48-4F │ 0x00     │ 2      │ 250 ms (4 Hz)        │
+ *  └──────────┴─────────┴──────────┴────────┴──────────────────────┘
+ * 
+ *  Every 1 ms the scheduler submits ALL devices that are due. The engine
+ *  queue then runs them back to back, so the bus never idles between
+ *  reads that are due together:
+ * 
+ *  t = 0 ms   |IMU|BMP|TMP|TMP|          (all due - packed)
+ *  t = 10 ms  |IMU|
+ *  t = 20 ms  |IMU|
+ *  ...
+ *  t = 50 ms  |IMU|BMP|
+ * 
+ *  MEASUREMENTS (µs, from TIM2):
+ *  • latency   = completion time - due time (queue wait + transfer)
+ *  • overruns  = device was due again while its last read was still
+ *                queued or running → its rate is too high for the bus
+ *  • occupancy = time with a transaction on the wire / elapsed time
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    uint8_t addr_first;
+    uint8_t addr_last;
+    uint8_t reg;
+    uint8_t len;
+    uint16_t period_ms;
+} Poll_Profile_t;
+
+const Poll_Profile_t poll_profiles[] = {
+    { 0x68, 0x69, 0x3B, 14,  10 },      /* MPU6050 accel/temp/gyro */
+    { 0x76, 0x77, 0xF7,  6,  50 },      /* BMP280 pressure + temperature */
+    { 0x48, 0x4F, 0x00,  2, 250 },      /* TMP102 temperature */
+};
+
+#define POLL_PROFILE_COUNT      (sizeof(poll_profiles) / sizeof(poll_profiles[0]))
+#define POLL_MAX_DEVICES        12U
+#define POLL_MAX_BYTES          16U
+
+typedef struct {
+    I2C_Txn_t txn;
+    uint8_t reg;
+    uint8_t data[POLL_MAX_BYTES];       /* Latest sample */
+    uint16_t period_ms;
+    uint32_t next_due_ms;
+    uint32_t due_us;                    /* When the current read became due */
+
+    /* Statistics */
+    volatile uint32_t samples;
+    volatile uint32_t failures;         /* NACK / error / timeout */
+    volatile uint32_t overruns;
+    volatile uint32_t latency_last_us;
+    volatile uint32_t latency_max_us;
+    volatile uint32_t latency_sum_us;
+} Poll_Device_t;
+
+Poll_Device_t poll_devices[POLL_MAX_DEVICES];
+volatile uint8_t poll_device_count = 0;
+
+/* Bus occupancy over the last full second, in 0.1 % */
+volatile uint32_t bus_occupancy_permille = 0;
+
+void Poll_OnDone(I2C_Txn_t *txn) {
+    Poll_Device_t *d = (Poll_Device_t *)txn->context;
+    uint32_t latency = TIM2->CNT - d->due_us;
+
+    if (txn->status != I2C_TXN_DONE) {
+        d->failures++;
+        return;
+    }
+
+    d->samples++;
+    d->latency_last_us = latency;
+    d->latency_sum_us += latency;
+    if (latency > d->latency_max_us) {
+        d->latency_max_us = latency;
+    }
+}
+
+/* Build the schedule from the scan result */
+void Poll_Setup(void) {
+    poll_device_count = 0;
+
+    for (uint32_t addr = I2C_SCAN_FIRST; addr <= I2C_SCAN_LAST; addr++) {
+        if (!i2c_found[addr]) {
+            continue;
+        }
+        for (uint32_t p = 0; p < POLL_PROFILE_COUNT; p++) {
+            const Poll_Profile_t *prof = &poll_profiles[p];
+            Poll_Device_t *d;
+
+            if (addr < prof->addr_first || addr > prof->addr_last ||
+                poll_device_count >= POLL_MAX_DEVICES) {
+                continue;
+            }
+
+            d = &poll_devices[poll_device_count++];
+            d->reg = prof->reg;
+            d->period_ms = prof->period_ms;
+            d->next_due_ms = tick_ms;
+            d->txn.addr = (uint8_t)addr;
+            d->txn.tx = &d->reg;
+            d->txn.tx_len = 1;
+            d->txn.rx = d->data;
+            d->txn.rx_len = prof->len;
+            d->txn.callback = Poll_OnDone;
+            d->txn.context = d;
+            break;
+        }
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 6: THE SCHEDULER TICK
+ *  ===================================
+ * 
+ *  Runs in the TIM7 interrupt every 1 ms.
+ * 
+ * ============================================================================ */
+
+void Poll_Tick(uint32_t now_ms) {
+    static uint32_t window_start_us = 0;
+    static uint32_t window_ms = 0;
+    uint32_t now_us = TIM2->CNT;
+
+    for (uint32_t i = 0; i < poll_device_count; i++) {
+        Poll_Device_t *d = &poll_devices[i];
+
+        /* ✏️ YOUR TURN: Is this device due? (wrap-safe compare) */
+        if ((int32_t)(now_ms - ???) < 0) {  /* HINT: When the next read is due */
+            continue;
+        }
+        d->next_due_ms += d->period_ms;
+        if ((int32_t)(now_ms - d->next_due_ms) >= 0) {
+            d->next_due_ms = now_ms + d->period_ms;     /* Fell behind: resync */
+        }
+
+        if (d->txn.status == I2C_TXN_QUEUED || d->txn.status == I2C_TXN_ACTIVE) {
+            d->overruns++;              /* Previous read not finished yet */
+            continue;
+        }
+        d->due_us = now_us;
+        I2C_Engine_Submit(&d->txn);
+    }
+
+    /* Occupancy, once per second */
+    if (++window_ms >= 1000U) {
+        uint32_t elapsed = now_us - window_start_us;
+
+        bus_occupancy_permille = (uint32_t)(((uint64_t)i2c_bus_busy_us * 1000U) / elapsed);
+        i2c_bus_busy_us = 0;
+        window_start_us = now_us;
+        window_ms = 0;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if ((int32_t)(now_ms - d->next_due_ms) < 0) {
+ * 
+ * A device whose overruns keep rising needs a longer period, a faster
+ * bus (see the TIMINGR solver in the I2C tutorial), or fewer bytes.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Scan the bus, then poll what was found at mixed rates
+ * 
+ * ============================================================================ */
+
+int main(void)
+{
+    I2C_Engine_InitHardware();
+
+    /* 1. Find out what is connected (~25 ms, interrupt driven) */
+    I2C_Scan();
+    while (!i2c_scan_done) {
+        __asm("wfi");
+    }
+
+    /* 2. Give every known device its own rate, then let TIM7 run it */
+    Poll_Setup();
+    if (poll_device_count > 0) {
+        GPIOB->ODR |= (1U << LED_GREEN_PIN);
+    }
+    i2c_tick_hook = Poll_Tick;
+
+    for (;;) {
+        /* Watch in the debugger:
+         *   poll_devices[n].samples / latency_max_us / overruns
+         *   bus_occupancy_permille (e.g. 412 = bus busy 41.2 % of the time) */
+
+        /* Red LED = something went wrong on the bus at least once */
+        if (i2c_txn_errors) {
+            GPIOB->ODR |= (1U << LED_RED_PIN);
+        }
+
+        /* The CPU is free - the whole poll runs from interrupts */
+        __asm("wfi");
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've built an asynchronous I2C engine without HAL:
+ * 
+ *  ✅ Write, read and write-read (repeated START) in one struct
+ *  ✅ Transfers driven by the I2C event interrupt
+ *  ✅ DMA for long phases, TXIS/RXNE interrupts for short ones
+ *  ✅ NACK, arbitration loss, bus error and timeout per transaction
+ *  ✅ A queue shared by several drivers, with completion callbacks
+ *  ✅ A bus scan with empty writes, chained from its own callback
+ *  ✅ A mixed-rate polling schedule with latency and occupancy stats
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Unplug a sensor while running and watch i2c_txn_nack climb
+ *  • Short SDA to GND for a moment: the timeout fires, the bus recovers
+ *  • Halve the MPU6050 period until overruns appear - then try 400 kHz
+ *    and watch bus_occupancy_permille drop
+ *  • Move poll_devices into DTCM on purpose and see I2C_TXN_BUS_ERROR
+ * 
+ * ============================================================================ */
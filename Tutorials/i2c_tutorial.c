@@ -18,6 +18,9 @@
  *  2. How to configure GPIO pins for I2C
  *  3. How to configure I2C as Master
  *  4. How to write and read data from I2C devices
+ *  5. How to read/write register bursts of any length (NBYTES + RELOAD)
+ *  6. How to COMPUTE TIMINGR for 100 kHz, 400 kHz and 1 MHz
+ *  7. How to free a bus that a slave is holding low
  * 
  *  PREREQUISITES:
  *  - Complete the RCC tutorial first!
@@ -83,6 +86,7 @@
 #define RCC_BASE        0x58024400UL
 #define GPIOB_BASE      0x58020400UL
 #define I2C1_BASE       0x40005400UL
+#define SYSCFG_BASE     0x58000400UL
 
 /* ============================================================================
  *  RCC REGISTERS
@@ -207,6 +211,14 @@ typedef struct {
 /* RCC Clock Enable Bits */
 #define RCC_AHB4ENR_GPIOBEN     (1U << 1)   /* GPIOB clock enable */
 #define RCC_APB1LENR_I2C1EN     (1U << 21)  /* I2C1 clock enable */
+#define RCC_APB4ENR_SYSCFGEN    (1U << 1)   /* SYSCFG clock enable */
+#define RCC_APB1LRSTR_I2C1RST   (1U << 21)  /* I2C1 reset */
+
+/* SYSCFG_PMCR: Fast-mode Plus (20 mA) drive on the I2C pins */
+#define SYSCFG_PMCR             (*(volatile uint32_t *)(SYSCFG_BASE + 0x04))
+#define SYSCFG_PMCR_I2C1FMP     (1U << 0)   /* FM+ on the I2C1 pins */
+#define SYSCFG_PMCR_PB8FMP      (1U << 6)   /* FM+ on PB8 */
+#define SYSCFG_PMCR_PB9FMP      (1U << 7)   /* FM+ on PB9 */
 
 /* I2C_CR1 Register Bits */
 #define I2C_CR1_PE              (1U << 0)   /* Peripheral Enable */
@@ -218,19 +230,30 @@ typedef struct {
 #define I2C_CR2_NACK            (1U << 15)  /* NACK generation (for receive) */
 #define I2C_CR2_AUTOEND         (1U << 25)  /* Automatic end mode */
 #define I2C_CR2_RD_WRN          (1U << 10)  /* Transfer direction (0=write, 1=read) */
+#define I2C_CR2_NBYTES_Pos      16U         /* Number of bytes (bits 16-23) */
+#define I2C_CR2_NBYTES_Msk      (0xFFU << 16)
+#define I2C_CR2_RELOAD          (1U << 24)  /* More than NBYTES bytes will follow */
 
 /* I2C_ISR Register Bits */
 #define I2C_ISR_TXE             (1U << 0)   /* TX buffer empty */
 #define I2C_ISR_TXIS            (1U << 1)   /* TX interrupt status */
 #define I2C_ISR_RXNE            (1U << 2)   /* RX buffer not empty */
 #define I2C_ISR_TC              (1U << 6)   /* Transfer complete */
+#define I2C_ISR_TCR             (1U << 7)   /* Transfer complete reload */
 #define I2C_ISR_NACKF           (1U << 4)   /* NACK received */
 #define I2C_ISR_STOPF           (1U << 5)   /* Stop detected */
+#define I2C_ISR_TIMEOUT         (1U << 12)  /* SCL low / clock stretch timeout */
 #define I2C_ISR_BUSY            (1U << 15)  /* Bus busy */
 
 /* I2C_ICR Register Bits */
 #define I2C_ICR_NACKCF          (1U << 4)   /* Clear NACK flag */
 #define I2C_ICR_STOPCF          (1U << 5)   /* Clear STOP flag */
+#define I2C_ICR_TIMOUTCF        (1U << 12)  /* Clear TIMEOUT flag */
+
+/* I2C_TIMEOUTR Register */
+#define I2C_TIMEOUTR_TIMEOUTA_Pos 0U        /* SCL low timeout (bits 0-11) */
+#define I2C_TIMEOUTR_TIDLE      (1U << 12)  /* 0 = measure SCL low */
+#define I2C_TIMEOUTR_TIMOUTEN   (1U << 15)  /* Enable TIMEOUTA */
 
 /* GPIO Alternate Function */
 #define GPIO_AF4_I2C1           4U          /* AF4 = I2C1 */
@@ -387,6 +410,281 @@ void I2C_Configure(void) {
  * }
  * ───────────────────────────────────────────────────────────────────────────── */
 
+/* ============================================================================
+ * 
+ *  LESSON 3B: WHEN A SLAVE HOLDS THE BUS
+ *  ======================================
+ * 
+ *  Reset the STM32 in the middle of a read and the slave does not know.
+ *  It is still sending a byte, and if the current bit is a 0 it keeps
+ *  SDA LOW - forever, because the master never clocks again:
+ * 
+ *  SCL ▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔    (master gone, pull-up)
+ *  SDA ▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁    (slave waiting for the next clock)
+ * 
+ *  The I2C peripheral now sees a busy bus and a polled driver waits in
+ *  while (I2C1->ISR & I2C_ISR_BUSY) until the watchdog bites.
+ * 
+ *  THE CURE (I2C specification, "bus clear"):
+ *  1. Take SCL away from the peripheral: plain GPIO open-drain output
+ *  2. Clock SCL up to 9 times - enough for the slave to finish its byte -
+ *     until it lets go of SDA
+ *  3. Send a STOP by hand (SDA low → high while SCL is high)
+ *  4. Give the pins back to I2C1 and reset the peripheral
+ * 
+ *  And so it never needs a human: TIMEOUTR makes the hardware flag an
+ *  SCL line held low for too long (25 ms, the SMBus limit).
+ * 
+ *      tTIMEOUT = (TIMEOUTA + 1) × 2048 × tI2CCLK
+ * 
+ * ============================================================================ */
+
+#define I2C_SCL_PIN             8
+#define I2C_SDA_PIN             9
+#define I2C_LINES               ((1U << I2C_SCL_PIN) | (1U << I2C_SDA_PIN))
+#define I2C_SCL_LOW_MAX_MS      25U         /* SMBus limit, loaded into TIMEOUTA */
+#define I2C_BUSY_WAIT_US        (I2C_SCL_LOW_MAX_MS * 1000U)
+#define I2C_FLAG_WAIT_US        (2U * I2C_SCL_LOW_MAX_MS * 1000U)
+
+/* Every transfer returns one of these */
+#define I2C_OK                  0
+#define I2C_ERR_NACK            (-1)        /* No ACK - wrong address, or busy */
+#define I2C_ERR_TIMEOUT         (-2)        /* SCL held low, or a flag never came */
+#define I2C_ERR_BUS             (-3)        /* Stuck bus that recovery could not free */
+
+/* Counted over the whole run - a rising value means a flaky bus */
+volatile uint32_t i2c_recoveries = 0;
+volatile uint32_t i2c_recovery_failures = 0;
+
+/* ============================================================================
+ *  CALIBRATED DELAYS
+ *  The bit-banged recovery clock (5 µs half periods) and every wait for
+ *  the bus are measured on the DWT cycle counter, so they hold at any
+ *  optimization level.
+ * ============================================================================ */
+
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+/* The counter is off after reset; the first reader starts it */
+uint32_t I2C_Cycles(void) {
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;           /* M7: unlock before the first write */
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+    return DWT_CYCCNT;
+}
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start = I2C_Cycles();
+
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
+}
+
+/* Half an SCL period at 100 kHz */
+void I2C_BitDelay(void) {
+    delay_us(5);
+}
+
+void I2C_EnableTimeouts(uint32_t kernel_hz, uint32_t scl_low_ms) {
+    uint32_t timeouta = (kernel_hz / 2048U) * scl_low_ms / 1000U;
+
+    if (timeouta > 0) {
+        timeouta--;
+    }
+    if (timeouta > 0xFFFU) {
+        timeouta = 0xFFFU;
+    }
+
+    /* TIMEOUTA may only change while TIMOUTEN = 0 */
+    I2C1->TIMEOUTR = 0;
+    I2C1->TIMEOUTR = (timeouta << I2C_TIMEOUTR_TIMEOUTA_Pos);
+    I2C1->TIMEOUTR |= I2C_TIMEOUTR_TIMOUTEN;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3B: CLOCK THE SLAVE FREE
+ *  ======================================
+ * 
+ * ============================================================================ */
+
+int I2C_RecoverBus(void) {
+    uint32_t timingr = I2C1->TIMINGR;
+    uint32_t timeoutr = I2C1->TIMEOUTR;
+    int result;
+
+    I2C1->CR1 &= ~I2C_CR1_PE;
+
+    /* Both lines → GPIO output (open-drain from EXERCISE 2), released */
+    GPIOB->BSRR = I2C_LINES;
+    GPIOB->MODER &= ~((3U << (I2C_SCL_PIN * 2)) | (3U << (I2C_SDA_PIN * 2)));
+    GPIOB->MODER |= (1U << (I2C_SCL_PIN * 2)) | (1U << (I2C_SDA_PIN * 2));
+    I2C_BitDelay();
+
+    /* ✏️ YOUR TURN: Up to 9 clocks, stop as soon as SDA reads HIGH */
+    for (uint32_t pulse = 0; pulse < 9; pulse++) {
+        if (GPIOB->IDR & (1U << ???)) { /* HINT: Which pin is SDA? */
+            break;
+        }
+        GPIOB->BSRR = (1U << (I2C_SCL_PIN + 16));   /* SCL low */
+        I2C_BitDelay();
+        GPIOB->BSRR = (1U << I2C_SCL_PIN);          /* SCL released */
+        I2C_BitDelay();
+    }
+
+    /* STOP: SCL low, SDA low, SCL high, then SDA high */
+    GPIOB->BSRR = (1U << (I2C_SCL_PIN + 16));
+    I2C_BitDelay();
+    GPIOB->BSRR = (1U << (I2C_SDA_PIN + 16));
+    I2C_BitDelay();
+    GPIOB->BSRR = (1U << I2C_SCL_PIN);
+    I2C_BitDelay();
+    GPIOB->BSRR = (1U << I2C_SDA_PIN);
+    I2C_BitDelay();
+
+    result = ((GPIOB->IDR & I2C_LINES) == I2C_LINES) ? 0 : -1;
+
+    /* Pins back to AF4 */
+    GPIOB->MODER &= ~((3U << (I2C_SCL_PIN * 2)) | (3U << (I2C_SDA_PIN * 2)));
+    GPIOB->MODER |= (2U << (I2C_SCL_PIN * 2)) | (2U << (I2C_SDA_PIN * 2));
+
+    /* Full peripheral reset, then restore its configuration */
+    RCC->APB1LRSTR |= RCC_APB1LRSTR_I2C1RST;
+    RCC->APB1LRSTR &= ~RCC_APB1LRSTR_I2C1RST;
+    I2C1->TIMINGR = timingr;
+    I2C1->TIMEOUTR = timeoutr & ~I2C_TIMEOUTR_TIMOUTEN;
+    I2C1->TIMEOUTR = timeoutr;
+    I2C1->CR1 |= I2C_CR1_PE;
+
+    i2c_recoveries++;
+    if (result != 0) {
+        i2c_recovery_failures++;        /* SDA shorted, or a dead slave */
+    }
+    return result;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (GPIOB->IDR & (1U << I2C_SDA_PIN)) {
+ * 
+ * WHY 9? The slave may be anywhere in a byte: up to 8 data bits plus
+ * the ACK bit. After at most 9 clocks it MUST release SDA.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Wait until the bus is idle; recover it if it stays stuck.
+ * Idle = BUSY clear AND both lines high (a slave stuck since our reset
+ * never produced the START that sets BUSY). Any transfer by another
+ * master ends within one SCL-low timeout, so that is how long we wait. */
+int I2C_WaitBusFree(void) {
+    uint32_t start = I2C_Cycles();
+
+    while ((DWT_CYCCNT - start) < I2C_BUSY_WAIT_US * (CPU_CLOCK_HZ / 1000000U)) {
+        if (!(I2C1->ISR & (I2C_ISR_BUSY | I2C_ISR_TIMEOUT)) &&
+            (GPIOB->IDR & I2C_LINES) == I2C_LINES) {
+            return I2C_OK;
+        }
+    }
+
+    I2C1->ICR = I2C_ICR_TIMOUTCF;
+    return (I2C_RecoverBus() == 0) ? I2C_OK : I2C_ERR_BUS;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 3C: NO WAIT WITHOUT AN EXIT
+ *  ===================================
+ * 
+ *  while (!(I2C1->ISR & I2C_ISR_TXIS)); hangs forever if the slave
+ *  never answers. Every flag wait below also watches for:
+ * 
+ *  • NACKF   - the slave said no (wrong address, busy EEPROM). The
+ *              hardware sends STOP by itself; TXIS/RXNE never come.
+ *  • TIMEOUT - TIMEOUTR saw SCL held low for 25 ms.
+ *  • 50 ms on the cycle counter - a backstop if neither flag fires.
+ * 
+ *  A NACK is a normal answer - the bus is fine. Wait for the STOP,
+ *  clear NACKF/STOPF, flush the byte still sitting in TXDR and return
+ *  I2C_ERR_NACK. Only a TIMEOUT or the backstop means a stuck bus:
+ *  then recover it (9 clocks, STOP, peripheral reset) and count it.
+ * 
+ * ============================================================================ */
+
+/* Stuck bus: clear the flags and clock it free */
+int I2C_Fail(int error) {
+    I2C1->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF | I2C_ICR_TIMOUTCF;
+    if (I2C_RecoverBus() != 0) {
+        return I2C_ERR_BUS;
+    }
+    return error;
+}
+
+/* NACK: the bus is healthy, just finish the transfer cleanly */
+int I2C_Nack(void) {
+    uint32_t start = I2C_Cycles();
+
+    /* As master, the peripheral sends STOP right after a NACK - even in
+     * software-end mode. Setting CR2.STOP here would race with it. */
+    while (!(I2C1->ISR & I2C_ISR_STOPF)) {
+        if ((I2C1->ISR & I2C_ISR_TIMEOUT) ||
+            (DWT_CYCCNT - start) > I2C_FLAG_WAIT_US * (CPU_CLOCK_HZ / 1000000U)) {
+            return I2C_Fail(I2C_ERR_TIMEOUT);
+        }
+    }
+
+    I2C1->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+    I2C1->ISR = I2C_ISR_TXE;            /* Flush the byte nobody took */
+    return I2C_ERR_NACK;
+}
+
+int I2C_WaitFlag(uint32_t flag) {
+    uint32_t start = I2C_Cycles();
+
+    for (;;) {
+        uint32_t isr = I2C1->ISR;
+
+        /* NACK first: it also sets STOPF, which is not a success */
+        if (isr & I2C_ISR_NACKF) {
+            return I2C_Nack();
+        }
+        if (isr & flag) {
+            return I2C_OK;
+        }
+        if ((isr & I2C_ISR_TIMEOUT) ||
+            (DWT_CYCCNT - start) > I2C_FLAG_WAIT_US * (CPU_CLOCK_HZ / 1000000U)) {
+            return I2C_Fail(I2C_ERR_TIMEOUT);
+        }
+    }
+}
+
+/* Every transfer ends the same way: STOP seen, flag cleared */
+int I2C_WaitStop(void) {
+    int status = I2C_WaitFlag(I2C_ISR_STOPF);
+
+    if (status == I2C_OK) {
+        I2C1->ICR = I2C_ICR_STOPCF;
+    }
+    return status;
+}
+
 /* ============================================================================
  * 
  *  LESSON 4: I2C TRANSFER SETUP
@@ -422,9 +720,14 @@ void I2C_Configure(void) {
  *  START → ADDRESS → R/W → ACK → DATA → ACK → ... → STOP
  * ============================================================================ */
 
-void I2C_Write(uint8_t slave_addr, uint8_t *data, uint8_t length) {
-    /* Wait until bus is not busy */
-    while (I2C1->ISR & I2C_ISR_BUSY);
+int I2C_Write(uint8_t slave_addr, const uint8_t *data, uint8_t length) {
+    int status;
+
+    /* Wait until bus is not busy (frees a stuck bus, LESSON 3B) */
+    status = I2C_WaitBusFree();
+    if (status != I2C_OK) {
+        return status;
+    }
     
     /* Configure transfer:
      * - Slave address (shifted left by 1)
@@ -442,24 +745,24 @@ void I2C_Write(uint8_t slave_addr, uint8_t *data, uint8_t length) {
     /* Send all bytes */
     for (uint8_t i = 0; i < length; i++) {
         /* ✏️ YOUR TURN: Wait until TX buffer is empty */
-        while (!(I2C1->ISR & ???)); /* HINT: Which flag indicates TX ready? */
+        status = I2C_WaitFlag(???); /* HINT: Which flag indicates TX ready? */
+        if (status != I2C_OK) {
+            return status;
+        }
         
         /* ✏️ YOUR TURN: Write data byte */
         I2C1->TXDR = ???;       /* HINT: Current byte from the data array */
     }
-    
-    /* Wait for transfer complete */
-    while (!(I2C1->ISR & I2C_ISR_STOPF));
-    
-    /* Clear STOP flag */
-    I2C1->ICR = I2C_ICR_STOPCF;
+        
+    /* Wait for transfer complete, clear STOP flag */
+    return I2C_WaitStop();
 }
-
+        
 /* ─────────────────────────────────────────────────────────────────────────────
  * 💡 SOLUTION:
  * 
  * I2C1->CR2 |= I2C_CR2_START;
- * while (!(I2C1->ISR & I2C_ISR_TXIS));
+ * status = I2C_WaitFlag(I2C_ISR_TXIS);
  * I2C1->TXDR = data[i];
  * ───────────────────────────────────────────────────────────────────────────── */
 
@@ -473,9 +776,14 @@ void I2C_Write(uint8_t slave_addr, uint8_t *data, uint8_t length) {
  *  START → ADDRESS → R/W → ACK → DATA → ACK → ... → STOP
  * ============================================================================ */
 
-void I2C_Read(uint8_t slave_addr, uint8_t *data, uint8_t length) {
-    /* Wait until bus is not busy */
-    while (I2C1->ISR & I2C_ISR_BUSY);
+int I2C_Read(uint8_t slave_addr, uint8_t *data, uint8_t length) {
+    int status;
+
+    /* Wait until bus is not busy (frees a stuck bus, LESSON 3B) */
+    status = I2C_WaitBusFree();
+    if (status != I2C_OK) {
+        return status;
+    }
     
     /* Configure transfer:
      * - Slave address
@@ -494,23 +802,23 @@ void I2C_Read(uint8_t slave_addr, uint8_t *data, uint8_t length) {
     /* Read all bytes */
     for (uint8_t i = 0; i < length; i++) {
         /* ✏️ YOUR TURN: Wait until RX buffer has data */
-        while (!(I2C1->ISR & ???)); /* HINT: Which flag indicates RX data available? */
+        status = I2C_WaitFlag(???); /* HINT: Which flag indicates RX data available? */
+        if (status != I2C_OK) {
+            return status;
+        }
         
         /* ✏️ YOUR TURN: Read data byte */
         data[i] = ???;          /* HINT: Read from receive data register */
     }
-    
-    /* Wait for STOP */
-    while (!(I2C1->ISR & I2C_ISR_STOPF));
-    
-    /* Clear STOP flag */
-    I2C1->ICR = I2C_ICR_STOPCF;
+        
+    /* Wait for STOP, clear STOP flag */
+    return I2C_WaitStop();
 }
-
+        
 /* ─────────────────────────────────────────────────────────────────────────────
  * 💡 SOLUTION:
  * 
- * while (!(I2C1->ISR & I2C_ISR_RXNE));
+ * status = I2C_WaitFlag(I2C_ISR_RXNE);
  * data[i] = I2C1->RXDR;
  * ───────────────────────────────────────────────────────────────────────────── */
 
@@ -527,12 +835,15 @@ void I2C_Read(uint8_t slave_addr, uint8_t *data, uint8_t length) {
  *  START → ADDRESS → R/W → ACK → DATA → ACK → ... → STOP
  * ============================================================================ */
 
-uint8_t I2C_ReadRegister(uint8_t slave_addr, uint8_t reg_addr) {
-    uint8_t value;
-    
-    /* Wait until bus is not busy */
-    while (I2C1->ISR & I2C_ISR_BUSY);
+int I2C_ReadRegister(uint8_t slave_addr, uint8_t reg_addr, uint8_t *value) {
+    int status;
     
+    /* Wait until bus is not busy (frees a stuck bus, LESSON 3B) */
+    status = I2C_WaitBusFree();
+    if (status != I2C_OK) {
+        return status;
+    }
+        
     /* ────────────────────────────────────────────────────────────────────────
      * STEP 1: Write the register address (no AUTOEND, no STOP)
      * ──────────────────────────────────────────────────────────────────────── */
@@ -544,14 +855,20 @@ uint8_t I2C_ReadRegister(uint8_t slave_addr, uint8_t reg_addr) {
     I2C1->CR2 |= ???;            /* HINT: Which bit generates START? */
     
     /* Wait for TX empty */
-    while (!(I2C1->ISR & I2C_ISR_TXIS));
+    status = I2C_WaitFlag(I2C_ISR_TXIS);
+    if (status != I2C_OK) {
+        return status;
+    }
     
     /* ✏️ YOUR TURN: Send register address */
     I2C1->TXDR = ???;           /* HINT: Register address to read from */
     
     /* Wait for transfer complete (not STOP, just TC) */
-    while (!(I2C1->ISR & I2C_ISR_TC));
-    
+    status = I2C_WaitFlag(I2C_ISR_TC);
+    if (status != I2C_OK) {
+        return status;
+    }
+        
     /* ────────────────────────────────────────────────────────────────────────
      * STEP 2: Read the register value (with AUTOEND for STOP)
      * ──────────────────────────────────────────────────────────────────────── */
@@ -564,24 +881,24 @@ uint8_t I2C_ReadRegister(uint8_t slave_addr, uint8_t reg_addr) {
     I2C1->CR2 |= I2C_CR2_START;
     
     /* Wait for RX data */
-    while (!(I2C1->ISR & I2C_ISR_RXNE));
+    status = I2C_WaitFlag(I2C_ISR_RXNE);
+    if (status != I2C_OK) {
+        return status;
+    }
     
     /* ✏️ YOUR TURN: Read the value */
-    value = ???;                /* HINT: Read from receive data register */
+    *value = ???;               /* HINT: Read from receive data register */
     
     /* Wait for STOP */
-    while (!(I2C1->ISR & I2C_ISR_STOPF));
-    I2C1->ICR = I2C_ICR_STOPCF;
-    
-    return value;
+    return I2C_WaitStop();
 }
-
+    
 /* ─────────────────────────────────────────────────────────────────────────────
  * 💡 SOLUTION:
  * 
  * I2C1->CR2 |= I2C_CR2_START;
  * I2C1->TXDR = reg_addr;
- * value = I2C1->RXDR;
+ * *value = I2C1->RXDR;
  * ───────────────────────────────────────────────────────────────────────────── */
 
 /* ============================================================================
@@ -591,9 +908,615 @@ uint8_t I2C_ReadRegister(uint8_t slave_addr, uint8_t reg_addr) {
  * 
  * ============================================================================ */
 
-void I2C_WriteRegister(uint8_t slave_addr, uint8_t reg_addr, uint8_t value) {
+int I2C_WriteRegister(uint8_t slave_addr, uint8_t reg_addr, uint8_t value) {
     uint8_t data[2] = {reg_addr, value};
-    I2C_Write(slave_addr, data, 2);
+    return I2C_Write(slave_addr, data, 2);
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 5: BURSTS AND TRANSFERS LONGER THAN 255 BYTES
+ *  =====================================================
+ * 
+ *  Reading an MPU6050 sample (accel XYZ, temp, gyro XYZ = 14 bytes)
+ *  with I2C_ReadRegister() means 14 × (START, addr, reg, Sr, addr, data,
+ *  STOP). The sensor auto-increments its register pointer, so ONE
+ *  write-then-read does the same job:
+ * 
+ *  14 single reads:  14 × 5 bytes on the wire = 70 bytes ≈ 6.3 ms
+ *  1 burst read:     3 + 14 bytes on the wire = 17 bytes ≈ 1.5 ms
+ *                                                        (@ 100 kHz)
+ * 
+ *  But NBYTES is only 8 bits wide - so how do we read a 32 KB EEPROM?
+ * 
+ *  RELOAD MODE:
+ *  ┌────────────────────────────────────────────────────────────────┐
+ *  │ RELOAD = 1: after NBYTES bytes the peripheral does NOT stop.   │
+ *  │             It sets TCR and stretches SCL until we write a     │
+ *  │             new NBYTES. No START, no address on the wire.      │
+ *  │ RELOAD = 0: the last chunk. AUTOEND then sends STOP as usual.  │
+ *  └────────────────────────────────────────────────────────────────┘
+ * 
+ *  1000 bytes = 255 (RELOAD) + 255 (RELOAD) + 255 (RELOAD) + 235 (AUTOEND)
+ * 
+ *  16-BIT REGISTER ADDRESSES:
+ *  EEPROMs bigger than 2 KB (24LC32 and up) take a 2-byte memory
+ *  address, high byte first:
+ * 
+ *      START | 0x50+W | ADDR_HI | ADDR_LO | data... | STOP
+ * 
+ * ============================================================================ */
+
+/* CR2 bits for the next chunk: NBYTES, plus RELOAD if more follows */
+uint32_t I2C_ChunkBits(uint32_t remaining, uint8_t autoend) {
+    if (remaining > 255U) {
+        return (255U << I2C_CR2_NBYTES_Pos) | I2C_CR2_RELOAD;
+    }
+    return (remaining << I2C_CR2_NBYTES_Pos) | (autoend ? I2C_CR2_AUTOEND : 0U);
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 7: CHAINING CHUNKS WITH RELOAD
+ *  ============================================
+ * 
+ *  Whenever a chunk runs out and bytes are still left, wait for TCR and
+ *  load the next NBYTES. Writing NBYTES clears TCR and releases SCL.
+ * 
+ *  The header (register address, 1 or 2 bytes) goes out in the same
+ *  transaction as the data - one START, one STOP.
+ * 
+ * ============================================================================ */
+
+int I2C_WriteBurst(uint8_t slave_addr, const uint8_t *header, uint8_t header_len,
+                   const uint8_t *data, uint32_t length) {
+    uint32_t remaining = header_len + length;
+    uint32_t chunk_left = (remaining > 255U) ? 255U : remaining;
+    int status;
+
+    status = I2C_WaitBusFree();
+    if (status != I2C_OK) {
+        return status;
+    }
+
+    I2C1->CR2 = ((slave_addr << 1) & 0xFE)
+              | I2C_ChunkBits(remaining, 1)
+              | I2C_CR2_START;
+
+    for (uint32_t i = 0; i < header_len + length; i++) {
+        if (chunk_left == 0) {
+            /* ✏️ YOUR TURN: Wait until the peripheral asks for more */
+            status = I2C_WaitFlag(???);     /* HINT: Transfer complete RELOAD flag */
+            if (status != I2C_OK) {
+                return status;
+            }
+
+            I2C1->CR2 = (I2C1->CR2 & ~(I2C_CR2_NBYTES_Msk | I2C_CR2_RELOAD | I2C_CR2_AUTOEND))
+                      | I2C_ChunkBits(remaining, 1);
+            chunk_left = (remaining > 255U) ? 255U : remaining;
+        }
+
+        status = I2C_WaitFlag(I2C_ISR_TXIS);
+        if (status != I2C_OK) {
+            return status;
+        }
+        I2C1->TXDR = (i < header_len) ? header[i] : data[i - header_len];
+        chunk_left--;
+        remaining--;
+    }
+
+    return I2C_WaitStop();
+}
+
+int I2C_ReadBurst(uint8_t slave_addr, const uint8_t *header, uint8_t header_len,
+                  uint8_t *data, uint32_t length) {
+    uint32_t remaining = length;
+    uint32_t chunk_left = (remaining > 255U) ? 255U : remaining;
+    int status;
+
+    status = I2C_WaitBusFree();
+    if (status != I2C_OK) {
+        return status;
+    }
+
+    /* Register address: no AUTOEND, so we get TC and a repeated START */
+    I2C1->CR2 = ((slave_addr << 1) & 0xFE)
+              | ((uint32_t)header_len << I2C_CR2_NBYTES_Pos)
+              | I2C_CR2_START;
+    for (uint8_t i = 0; i < header_len; i++) {
+        status = I2C_WaitFlag(I2C_ISR_TXIS);
+        if (status != I2C_OK) {
+            return status;
+        }
+        I2C1->TXDR = header[i];
+    }
+    status = I2C_WaitFlag(I2C_ISR_TC);
+    if (status != I2C_OK) {
+        return status;
+    }
+
+    /* ✏️ YOUR TURN: Read direction, first chunk, repeated START */
+    I2C1->CR2 = ((slave_addr << 1) & 0xFE)
+              | I2C_CR2_RD_WRN
+              | I2C_ChunkBits(???, 1)       /* HINT: Bytes still to read */
+              | I2C_CR2_START;
+
+    for (uint32_t i = 0; i < length; i++) {
+        if (chunk_left == 0) {
+            status = I2C_WaitFlag(I2C_ISR_TCR);
+            if (status != I2C_OK) {
+                return status;
+            }
+            I2C1->CR2 = (I2C1->CR2 & ~(I2C_CR2_NBYTES_Msk | I2C_CR2_RELOAD | I2C_CR2_AUTOEND))
+                      | I2C_ChunkBits(remaining, 1);
+            chunk_left = (remaining > 255U) ? 255U : remaining;
+        }
+
+        status = I2C_WaitFlag(I2C_ISR_RXNE);
+        if (status != I2C_OK) {
+            return status;
+        }
+        data[i] = (uint8_t)I2C1->RXDR;
+        chunk_left--;
+        remaining--;
+    }
+
+    return I2C_WaitStop();
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * status = I2C_WaitFlag(I2C_ISR_TCR);
+ * | I2C_ChunkBits(remaining, 1)
+ * 
+ * NOTE: Only the READ side needs RELOAD for the repeated START case -
+ * the header is at most 2 bytes and always fits in one chunk.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* 8-bit register address: sensors (MPU6050, BMP280, ...) */
+int I2C_ReadRegisters(uint8_t slave_addr, uint8_t reg_addr, uint8_t *data, uint32_t length) {
+    return I2C_ReadBurst(slave_addr, &reg_addr, 1, data, length);
+}
+
+/* 16-bit register address, high byte first: EEPROMs (24LC32 and up) */
+int I2C_ReadRegisters16(uint8_t slave_addr, uint16_t reg_addr, uint8_t *data, uint32_t length) {
+    uint8_t header[2] = { (uint8_t)(reg_addr >> 8), (uint8_t)reg_addr };
+    return I2C_ReadBurst(slave_addr, header, 2, data, length);
+}
+
+int I2C_WriteRegisters16(uint8_t slave_addr, uint16_t reg_addr, const uint8_t *data, uint32_t length) {
+    uint8_t header[2] = { (uint8_t)(reg_addr >> 8), (uint8_t)reg_addr };
+    return I2C_WriteBurst(slave_addr, header, 2, data, length);
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 6: EEPROM PAGES
+ *  =======================
+ * 
+ *  An EEPROM accepts a burst write only INSIDE one page (24LC256: 64
+ *  bytes). Crossing the end of a page WRAPS to the start of the same
+ *  page and overwrites data you wrote a moment ago!
+ * 
+ *  Write 100 bytes at 0x0030 (page size 64):
+ * 
+ *      0x0030..0x003F   16 bytes   (rest of page 0)
+ *      0x0040..0x007F   64 bytes   (page 1)
+ *      0x0080..0x0093   20 bytes   (page 2)
+ * 
+ *  After each page the chip is busy for up to 5 ms and does NOT
+ *  acknowledge its address. Instead of a fixed delay, "ACK polling"
+ *  sends an empty write until the chip answers - for at most 10 ms,
+ *  in case it never does.
+ * 
+ * ============================================================================ */
+
+#define I2C_EEPROM_READY_US     10000U      /* 2 × tWR */
+
+/* Empty write (NBYTES = 0): 1 if the device ACKs its address, 0 if it
+ * NACKs (here a NACK is an answer, not an error), < 0 on a bus error */
+int I2C_IsDeviceReady(uint8_t slave_addr) {
+    uint32_t start;
+    int ack;
+    int status;
+
+    status = I2C_WaitBusFree();
+    if (status != I2C_OK) {
+        return status;
+    }
+
+    I2C1->CR2 = ((slave_addr << 1) & 0xFE) | I2C_CR2_AUTOEND | I2C_CR2_START;
+
+    /* Hardware sends STOP after the address either way */
+    start = I2C_Cycles();
+    while (!(I2C1->ISR & I2C_ISR_STOPF)) {
+        if ((I2C1->ISR & I2C_ISR_TIMEOUT) ||
+            (DWT_CYCCNT - start) > I2C_FLAG_WAIT_US * (CPU_CLOCK_HZ / 1000000U)) {
+            return I2C_Fail(I2C_ERR_TIMEOUT);
+        }
+    }
+
+    ack = (I2C1->ISR & I2C_ISR_NACKF) ? 0 : 1;
+    I2C1->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF;
+    return ack;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 8: SPLIT A WRITE AT PAGE BOUNDARIES
+ *  =================================================
+ * 
+ *  Bytes that still fit in the current page:
+ * 
+ *      room = page_size - (mem_addr % page_size)
+ * 
+ * ============================================================================ */
+
+int I2C_EEPROM_Write(uint8_t slave_addr, uint16_t mem_addr, const uint8_t *data,
+                     uint32_t length, uint16_t page_size) {
+    int status;
+
+    while (length > 0) {
+        /* ✏️ YOUR TURN: How many bytes fit before the page ends? */
+        uint32_t chunk = page_size - (???);     /* HINT: Offset inside the page */
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        status = I2C_WriteRegisters16(slave_addr, mem_addr, data, chunk);
+        if (status != I2C_OK) {
+            return status;
+        }
+
+        /* ACK polling: wait for the internal write cycle */
+        uint32_t start = I2C_Cycles();
+        while ((status = I2C_IsDeviceReady(slave_addr)) == 0) {
+            if ((DWT_CYCCNT - start) > I2C_EEPROM_READY_US * (CPU_CLOCK_HZ / 1000000U)) {
+                return I2C_ERR_TIMEOUT;
+            }
+        }
+        if (status < 0) {
+            return status;
+        }
+
+        mem_addr += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return I2C_OK;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * uint32_t chunk = page_size - (mem_addr % page_size);
+ * 
+ * Reading has no page limit - one I2C_ReadRegisters16() call can read
+ * the whole EEPROM, RELOAD takes care of the 255-byte steps.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  LESSON 7: WHERE DO THE TIMINGR NUMBERS COME FROM?
+ *  ==================================================
+ * 
+ *  The I2C specification (NXP UM10204) sets MINIMUM times per mode:
+ * 
+ *  ┌──────────────────┬───────────┬───────────┬───────────┐
+ *  │ Parameter        │ Standard  │ Fast      │ Fast+     │
+ *  ├──────────────────┼───────────┼───────────┼───────────┤
+ *  │ f SCL (max)      │ 100 kHz   │ 400 kHz   │ 1 MHz     │
+ *  │ t LOW  (min)     │ 4.7 µs    │ 1.3 µs    │ 0.5 µs    │
+ *  │ t HIGH (min)     │ 4.0 µs    │ 0.6 µs    │ 0.26 µs   │
+ *  │ t SU;DAT (min)   │ 250 ns    │ 100 ns    │ 50 ns     │
+ *  │ t VD;DAT (max)   │ 3.45 µs   │ 0.9 µs    │ 0.45 µs   │
+ *  │ t r (max)        │ 1000 ns   │ 300 ns    │ 120 ns    │
+ *  │ t f (max)        │ 300 ns    │ 300 ns    │ 120 ns    │
+ *  └──────────────────┴───────────┴───────────┴───────────┘
+ * 
+ *  The STM32 builds each of them from the prescaled kernel clock:
+ * 
+ *      tPRESC  = (PRESC + 1)  × tI2CCLK
+ *      tSCLDEL = (SCLDEL + 1) × tPRESC   ≥ tr + tSU;DAT
+ *      tSDADEL = SDADEL × tPRESC         ≥ tf - tAF(min) - 3 × tI2CCLK
+ *                                        ≤ tVD;DAT - tr - tAF(max) - 4 × tI2CCLK
+ *      tLOW    = (SCLL + 1) × tPRESC + tSYNC
+ *      tHIGH   = (SCLH + 1) × tPRESC + tSYNC
+ *      tSCL    = tLOW + tHIGH + tr + tf
+ * 
+ *  tSYNC is the time the peripheral needs to see an SCL edge (analog
+ *  filter + 2 kernel clocks). tr and tf depend on YOUR board: pull-up
+ *  value × bus capacitance. Measure them with a scope, or use the
+ *  worst case from the table.
+ * 
+ *  The solver below tries PRESC = 0, 1, 2, ... and takes the first one
+ *  where every field fits - the smallest prescaler gives the finest
+ *  steps, so the real frequency lands closest to (but never above) the
+ *  target.
+ * 
+ *  Above 400 kHz the pins also need FAST-MODE PLUS drive (SYSCFG_PMCR)
+ *  to pull the bus low fast enough.
+ * 
+ * ============================================================================ */
+
+/* Analog noise filter delay (enabled by default, ANFOFF = 0) */
+#define I2C_AF_MIN_NS           50U
+#define I2C_AF_MAX_NS           260U
+
+/* Kernel clock of I2C1 (rcc_pclk1 after reset - 64 MHz HSI here) */
+#define I2C_KERNEL_CLOCK_HZ     64000000UL
+
+typedef struct {
+    uint32_t max_hz;
+    uint32_t low_min_ns;
+    uint32_t high_min_ns;
+    uint32_t su_dat_min_ns;
+    uint32_t vd_dat_max_ns;
+    uint32_t rise_max_ns;
+    uint32_t fall_max_ns;
+} I2C_Spec_t;
+
+const I2C_Spec_t i2c_specs[3] = {
+    {  100000U, 4700U, 4000U, 250U, 3450U, 1000U, 300U },   /* Standard */
+    {  400000U, 1300U,  600U, 100U,  900U,  300U, 300U },   /* Fast */
+    { 1000000U,  500U,  260U,  50U,  450U,  120U, 120U },   /* Fast-mode Plus */
+};
+
+/* Every limit the solver and the checker need, in picoseconds */
+typedef struct {
+    const I2C_Spec_t *spec;
+    uint32_t clk_ps;            /* One kernel clock */
+    uint32_t period_ps;         /* Target SCL period */
+    uint32_t scldel_min_ps;
+    uint32_t sdadel_min_ps;
+    uint32_t sdadel_max_ps;
+    uint32_t sync_ps;           /* tSYNC, added to both tLOW and tHIGH */
+    uint32_t edges_ps;          /* tr + tf */
+} I2C_TimingLimits_t;
+
+typedef struct {
+    uint8_t presc;
+    uint8_t scldel;
+    uint8_t sdadel;
+    uint8_t sclh;
+    uint8_t scll;
+    uint32_t actual_hz;         /* Real SCL frequency (always <= target) */
+    uint32_t timingr;           /* Ready for I2C1->TIMINGR */
+} I2C_Timing_t;
+
+int I2C_TimingLimits(uint32_t kernel_hz, uint32_t bus_hz, uint32_t rise_ns,
+                     uint32_t fall_ns, I2C_TimingLimits_t *lim) {
+    int32_t sdadel_min;
+    int32_t sdadel_max;
+    uint32_t i;
+
+    if (kernel_hz < 1000U || bus_hz < 1000U) {
+        return -1;
+    }
+    for (i = 0; i < 3; i++) {
+        if (bus_hz <= i2c_specs[i].max_hz) {
+            break;
+        }
+    }
+    if (i == 3) {
+        return -1;                      /* Faster than Fast-mode Plus */
+    }
+    lim->spec = &i2c_specs[i];
+    if (rise_ns > lim->spec->rise_max_ns || fall_ns > lim->spec->fall_max_ns) {
+        return -1;                      /* Board too slow for this mode */
+    }
+
+    lim->clk_ps = 1000000000UL / (kernel_hz / 1000U);
+    lim->period_ps = 1000000000UL / (bus_hz / 1000U);
+    lim->scldel_min_ps = (rise_ns + lim->spec->su_dat_min_ns) * 1000U;
+
+    sdadel_min = (int32_t)(fall_ns * 1000U) - (int32_t)(I2C_AF_MIN_NS * 1000U)
+               - 3 * (int32_t)lim->clk_ps;
+    sdadel_max = (int32_t)((lim->spec->vd_dat_max_ns - rise_ns - I2C_AF_MAX_NS) * 1000U)
+               - 4 * (int32_t)lim->clk_ps;
+    if (sdadel_max < 0) {
+        return -1;
+    }
+    lim->sdadel_min_ps = (sdadel_min > 0) ? (uint32_t)sdadel_min : 0U;
+    lim->sdadel_max_ps = (uint32_t)sdadel_max;
+
+    lim->sync_ps = I2C_AF_MIN_NS * 1000U + 2U * lim->clk_ps;
+    lim->edges_ps = (rise_ns + fall_ns) * 1000U;
+
+    /* Reference manual: tI2CCLK < (tLOW - tfilters) / 4 and < tHIGH */
+    if (4U * lim->clk_ps >= (lim->spec->low_min_ns - I2C_AF_MAX_NS) * 1000U ||
+        lim->clk_ps >= lim->spec->high_min_ns * 1000U) {
+        return -1;                      /* Kernel clock too slow */
+    }
+    return 0;
+}
+
+/* Smallest n with n * step >= value */
+uint32_t I2C_CeilDiv(uint32_t value, uint32_t step) {
+    return (value + step - 1U) / step;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 9: THE TIMINGR SOLVER
+ *  ===================================
+ * 
+ * ============================================================================ */
+
+int I2C_ComputeTiming(uint32_t kernel_hz, uint32_t bus_hz, uint32_t rise_ns,
+                      uint32_t fall_ns, I2C_Timing_t *t) {
+    I2C_TimingLimits_t lim;
+
+    if (I2C_TimingLimits(kernel_hz, bus_hz, rise_ns, fall_ns, &lim) != 0) {
+        return -1;
+    }
+
+    for (uint32_t presc = 0; presc < 16; presc++) {
+        uint32_t tpresc = (presc + 1U) * lim.clk_ps;
+        uint32_t scldel, sdadel, scll, sclh, fixed, total, extra;
+
+        /* Data setup: (SCLDEL + 1) × tPRESC >= minimum */
+        scldel = I2C_CeilDiv(lim.scldel_min_ps, tpresc);
+        scldel = (scldel > 0U) ? scldel - 1U : 0U;
+
+        /* ✏️ YOUR TURN: Data hold: SDADEL × tPRESC >= minimum */
+        sdadel = I2C_CeilDiv(???, tpresc);     /* HINT: Minimum SDADEL time from lim */
+
+        if (scldel > 15U || sdadel > 15U || sdadel * tpresc > lim.sdadel_max_ps) {
+            continue;
+        }
+
+        /* Shortest legal LOW and HIGH periods */
+        scll = I2C_CeilDiv(lim.spec->low_min_ns * 1000U - lim.sync_ps, tpresc) - 1U;
+        sclh = I2C_CeilDiv(lim.spec->high_min_ns * 1000U - lim.sync_ps, tpresc) - 1U;
+
+        /* Stretch both until the period reaches the target */
+        fixed = 2U * lim.sync_ps + lim.edges_ps;
+        if (lim.period_ps <= fixed) {
+            continue;
+        }
+        total = I2C_CeilDiv(lim.period_ps - fixed, tpresc);
+        if (total < (scll + 1U) + (sclh + 1U)) {
+            total = (scll + 1U) + (sclh + 1U);
+        }
+        extra = total - ((scll + 1U) + (sclh + 1U));
+        scll += (extra + 1U) / 2U;
+        sclh += extra / 2U;
+
+        if (scll > 255U || sclh > 255U) {
+            continue;                   /* Too fine - try a bigger prescaler */
+        }
+
+        t->presc = (uint8_t)presc;
+        t->scldel = (uint8_t)scldel;
+        t->sdadel = (uint8_t)sdadel;
+        t->scll = (uint8_t)scll;
+        t->sclh = (uint8_t)sclh;
+        t->actual_hz = (uint32_t)(1000000000000ULL / ((uint64_t)total * tpresc + fixed));
+        t->timingr = (presc << 28) | (scldel << 20) | (sdadel << 16) | (sclh << 8) | scll;
+        return 0;
+    }
+    return -1;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * sdadel = I2C_CeilDiv(lim.sdadel_min_ps, tpresc);
+ * 
+ * EXAMPLE (64 MHz, 100 kHz, tr = 100 ns, tf = 10 ns):
+ *   PRESC = 0 fails (SCLL would exceed 255), PRESC = 1 fits:
+ *   tPRESC = 31.25 ns → SCLDEL = 11, SDADEL = 0, SCLH = 144, SCLL = 166
+ *   → TIMINGR = 0x10B090A6, 99.8 kHz
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 3: CHECKING A TIMINGR VALUE AGAINST THE SPEC
+ *  ==================================================
+ * 
+ *  Decodes any TIMINGR (computed, from CubeMX, or from LESSON 3's table)
+ *  back into times and compares every one with the spec. Returns 0 if
+ *  all is well, otherwise a mask of I2C_TIMING_ERR_* bits.
+ * 
+ * ============================================================================ */
+
+#define I2C_TIMING_ERR_LIMITS   (1U << 0)   /* Mode/rise/fall/clock impossible */
+#define I2C_TIMING_ERR_LOW      (1U << 1)   /* tLOW too short */
+#define I2C_TIMING_ERR_HIGH     (1U << 2)   /* tHIGH too short */
+#define I2C_TIMING_ERR_SETUP    (1U << 3)   /* Data setup too short */
+#define I2C_TIMING_ERR_HOLD     (1U << 4)   /* Data hold outside its window */
+#define I2C_TIMING_ERR_FREQ     (1U << 5)   /* SCL faster than requested */
+
+uint32_t I2C_CheckTiming(uint32_t kernel_hz, uint32_t bus_hz, uint32_t rise_ns,
+                         uint32_t fall_ns, uint32_t timingr) {
+    I2C_TimingLimits_t lim;
+    uint32_t errors = 0;
+    uint32_t tpresc, t_low, t_high, t_scldel, t_sdadel;
+
+    if (I2C_TimingLimits(kernel_hz, bus_hz, rise_ns, fall_ns, &lim) != 0) {
+        return I2C_TIMING_ERR_LIMITS;
+    }
+
+    tpresc   = (((timingr >> 28) & 0xFU) + 1U) * lim.clk_ps;
+    t_scldel = (((timingr >> 20) & 0xFU) + 1U) * tpresc;
+    t_sdadel = ((timingr >> 16) & 0xFU) * tpresc;
+    t_high   = (((timingr >> 8) & 0xFFU) + 1U) * tpresc + lim.sync_ps;
+    t_low    = ((timingr & 0xFFU) + 1U) * tpresc + lim.sync_ps;
+
+    if (t_low < lim.spec->low_min_ns * 1000U)   errors |= I2C_TIMING_ERR_LOW;
+    if (t_high < lim.spec->high_min_ns * 1000U) errors |= I2C_TIMING_ERR_HIGH;
+    if (t_scldel < lim.scldel_min_ps)           errors |= I2C_TIMING_ERR_SETUP;
+    if (t_sdadel < lim.sdadel_min_ps || t_sdadel > lim.sdadel_max_ps) {
+        errors |= I2C_TIMING_ERR_HOLD;
+    }
+    if (t_low + t_high + lim.edges_ps < lim.period_ps) {
+        errors |= I2C_TIMING_ERR_FREQ;
+    }
+    return errors;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 10: APPLY A SPEED AT RUNTIME
+ *  ==========================================
+ * 
+ *  TIMINGR may only be written while PE = 0. Above 400 kHz, switch on
+ *  the 20 mA Fast-mode Plus drive for I2C1 and its pins.
+ * 
+ * ============================================================================ */
+
+int I2C_ConfigureSpeed(uint32_t kernel_hz, uint32_t bus_hz, uint32_t rise_ns, uint32_t fall_ns) {
+    I2C_Timing_t t;
+    uint32_t fmp = SYSCFG_PMCR_I2C1FMP | SYSCFG_PMCR_PB8FMP | SYSCFG_PMCR_PB9FMP;
+
+    if (I2C_ComputeTiming(kernel_hz, bus_hz, rise_ns, fall_ns, &t) != 0) {
+        return -1;                      /* Keep the old speed */
+    }
+
+    RCC->APB4ENR |= RCC_APB4ENR_SYSCFGEN;
+    (void)RCC->APB4ENR;
+
+    I2C1->CR1 &= ~I2C_CR1_PE;
+    I2C1->TIMINGR = t.timingr;
+
+    /* ✏️ YOUR TURN: FM+ drive only above Fast mode */
+    if (bus_hz > ???) {                 /* HINT: Fast mode maximum in Hz */
+        SYSCFG_PMCR |= fmp;
+    } else {
+        SYSCFG_PMCR &= ~fmp;
+    }
+
+    I2C1->CR1 |= I2C_CR1_PE;
+    return 0;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (bus_hz > 400000U) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Solve and check all three modes; a non-zero result means a bug */
+volatile uint32_t i2c_timing_selftest = 0;
+
+void I2C_TimingSelfTest(void) {
+    const uint32_t speeds[3] = { 100000U, 400000U, 1000000U };
+    const uint32_t rise_ns[3] = { 1000U, 300U, 120U };     /* Worst case */
+    I2C_Timing_t t;
+
+    for (uint32_t i = 0; i < 3; i++) {
+        if (I2C_ComputeTiming(I2C_KERNEL_CLOCK_HZ, speeds[i], rise_ns[i], 10U, &t) != 0 ||
+            I2C_CheckTiming(I2C_KERNEL_CLOCK_HZ, speeds[i], rise_ns[i], 10U, t.timingr) != 0) {
+            i2c_timing_selftest |= (1U << i);
+        }
+    }
+
+    /* The table value from LESSON 3 passes for tr <= 100 ns (not 1000!) */
+    if (I2C_CheckTiming(I2C_KERNEL_CLOCK_HZ, 100000U, 100U, 10U, I2C_TIMING_100KHZ) != 0) {
+        i2c_timing_selftest |= (1U << 3);
+    }
 }
 
 /* ============================================================================
@@ -609,13 +1532,10 @@ void I2C_WriteRegister(uint8_t slave_addr, uint8_t reg_addr, uint8_t value) {
  * 
  * ============================================================================ */
 
-void delay(volatile uint32_t count) {
-    while (count--);
-}
-
 int main(void)
 {
-    uint8_t whoami;
+    uint8_t whoami = 0;
+    int status;
     
     /* ────────────────────────────────────────────────────────────────────────
      * Common I2C device addresses (7-bit):
@@ -629,24 +1549,50 @@ int main(void)
     
     #define MPU6050_ADDR    0x68
     #define MPU6050_WHO_AM_I 0x75
+    #define MPU6050_ACCEL_XOUT_H 0x3B
+    #define EEPROM_ADDR     0x50
+    #define EEPROM_PAGE     64
+    
+    uint8_t imu_sample[14];             /* Accel XYZ, temp, gyro XYZ */
     
     /* Initialize I2C */
     I2C_EnableClocks();
     I2C_ConfigureGPIO();
     I2C_Configure();
     
+    /* 25 ms SCL-low timeout, and free the bus if a slave is still stuck
+     * from before our reset */
+    I2C_EnableTimeouts(I2C_KERNEL_CLOCK_HZ, I2C_SCL_LOW_MAX_MS);
+    status = I2C_WaitBusFree();         /* I2C_ERR_BUS: check wiring and pull-ups */
+    
+    /* Check the solver, then move the bus to 400 kHz (tr = 100 ns, tf = 10 ns) */
+    I2C_TimingSelfTest();
+    I2C_ConfigureSpeed(I2C_KERNEL_CLOCK_HZ, 400000U, 100U, 10U);
+    
     /* Read WHO_AM_I register from MPU6050 */
-    /* Should return 0x68 */
-    whoami = I2C_ReadRegister(MPU6050_ADDR, MPU6050_WHO_AM_I);
+    /* Should return 0x68 - I2C_ERR_NACK means nothing answers at 0x68 */
+    if (status == I2C_OK) {
+        status = I2C_ReadRegister(MPU6050_ADDR, MPU6050_WHO_AM_I, &whoami);
+    }
+    
+    /* Whole sample in ONE transaction instead of 14 */
+    if (status == I2C_OK && whoami == 0x68) {
+        status = I2C_ReadRegisters(MPU6050_ADDR, MPU6050_ACCEL_XOUT_H, imu_sample, sizeof(imu_sample));
+    }
+    
+    /* 24LC256 EEPROM: page-split write, then one long read (uses RELOAD) */
+    /* static uint8_t log_data[300]; */
+    /* I2C_EEPROM_Write(EEPROM_ADDR, 0x0030, log_data, sizeof(log_data), EEPROM_PAGE); */
+    /* I2C_ReadRegisters16(EEPROM_ADDR, 0x0030, log_data, sizeof(log_data)); */
     
     /* If you have an EEPROM, you could test like this: */
     /* I2C_WriteRegister(0x50, 0x00, 0xAB); */
-    /* delay(10000); // EEPROM needs write time */
-    /* uint8_t read_back = I2C_ReadRegister(0x50, 0x00); */
+    /* delay_ms(5);  // EEPROM write cycle tWR (5 ms max) */
+    /* uint8_t read_back; I2C_ReadRegister(0x50, 0x00, &read_back); */
     
     for(;;) {
         /* Your application code here */
-        delay(1000000);
+        delay_ms(100);
     }
 }
 
@@ -663,6 +1609,11 @@ int main(void)
  *  ✅ Writing data to I2C devices
  *  ✅ Reading data from I2C devices
  *  ✅ Combined write-then-read (repeated start)
+ *  ✅ Register bursts and >255-byte transfers with RELOAD
+ *  ✅ 16-bit addresses, EEPROM page splitting and ACK polling
+ *  ✅ Computing and checking TIMINGR for any clock and speed
+ *  ✅ Bus recovery (9 clocks + STOP) and SCL-low timeouts
+ *  ✅ Error codes instead of endless waits: NACK, timeout, stuck bus
  *  
  *  COMMON I2C DEVICES TO TRY:
  *  • EEPROM (24LC, AT24)
@@ -677,5 +1628,6 @@ int main(void)
  *  • Verify slave address (some datasheets show 8-bit, divide by 2!)
  *  • Use logic analyzer to see SCL/SDA waveforms
  *  • Check NACK flag for addressing problems
+ *  • i2c_recoveries going up = a slave is losing sync (noise, resets)
  * 
  * ============================================================================ */
@@ -0,0 +1,688 @@
+/**
+ ******************************************************************************
+ * @file           : log_tutorial.c
+ * @brief          : Learning binary deferred logging without HAL
+ ******************************************************************************
+ * 
+ *  ██████╗ ██╗███╗   ██╗    ██╗      ██████╗  ██████╗ 
+ *  ██╔══██╗██║████╗  ██║    ██║     ██╔═══██╗██╔════╝ 
+ *  ██████╔╝██║██╔██╗ ██║    ██║     ██║   ██║██║  ███╗
+ *  ██╔══██╗██║██║╚██╗██║    ██║     ██║   ██║██║   ██║
+ *  ██████╔╝██║██║ ╚████║    ███████╗╚██████╔╝╚██████╔╝
+ *  ╚═════╝ ╚═╝╚═╝  ╚═══╝    ╚══════╝ ╚═════╝  ╚═════╝ 
+ * 
+ *  INTERACTIVE LEARNING: LOGGING THAT DOES NOT CHANGE THE TIMING
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. Why text logging over UART destroys the timing you are debugging
+ *  2. How to keep format strings OFF the target (a string ID instead)
+ *  3. How to claim ring space from main AND interrupts without disabling
+ *     interrupts (LDREX/STREX)
+ *  4. How to commit a record so the reader never sees half of it
+ *  5. How to drain the ring in the background over USART3
+ *  6. How the PC turns the raw words back into text
+ * 
+ *  PREREQUISITES:
+ *  - Complete the UART tutorial first! (USART3, BRR, TXE)
+ *  - Complete the NVIC tutorial (interrupt priorities, preemption)
+ *  - The DWT cycle counter from the SPI tutorial
+ * 
+ *  HARDWARE:
+ *  - Nucleo-H753ZI: USART3 is the ST-Link Virtual COM Port
+ *    (PD8 = TX, PD9 = RX, 115200 8N1)
+ *  - Nothing else - TIM6 plays the part of a busy interrupt
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐ (Advanced)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: WHAT DOES ONE LOG LINE COST?
+ *  =======================================
+ * 
+ *  At 115200 baud one character = 10 bits = 86.8 µs. A modest line:
+ * 
+ *      "tim6 tick=1234 adc=2048\r\n"   25 chars  ≈ 2.2 ms on the wire
+ *      + sprintf() formatting                    ≈ 2000..5000 cycles
+ * 
+ *  Called from an interrupt that runs every 1 ms, that line alone takes
+ *  more than 100 % of the CPU. Called from the main loop, it shifts every
+ *  event after it by milliseconds - the race you are chasing disappears
+ *  the moment you add the printf ("Heisenbug").
+ * 
+ *  THE FIX: do almost nothing at the call site.
+ * 
+ *      LOG("tim6 tick=%u adc=%u", tick, adc);
+ * 
+ *  stores FIVE words in a RAM ring:
+ * 
+ *      header │ string ID │ timestamp │ tick │ adc        ≈ 30-40 cycles
+ * 
+ *  The text never exists on the target. The main loop sends the raw words
+ *  whenever it has nothing better to do, and the PC - which has the ELF
+ *  file and therefore all the strings - prints the line.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOD_BASE      0x58020C00UL
+#define USART3_BASE     0x40004800UL
+#define TIM6_BASE       0x40001000UL
+
+#define NVIC_ISER_BASE  0xE000E100UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;      /* 0x00 - Control register 1 */
+    volatile uint32_t CR2;      /* 0x04 - Control register 2 */
+    volatile uint32_t CR3;      /* 0x08 - Control register 3 */
+    volatile uint32_t BRR;      /* 0x0C - Baud rate register */
+    volatile uint32_t GTPR;     /* 0x10 - Guard time and prescaler */
+    volatile uint32_t RTOR;     /* 0x14 - Receiver timeout */
+    volatile uint32_t RQR;      /* 0x18 - Request register */
+    volatile uint32_t ISR;      /* 0x1C - Interrupt and status register */
+    volatile uint32_t ICR;      /* 0x20 - Interrupt flag clear register */
+    volatile uint32_t RDR;      /* 0x24 - Receive data register */
+    volatile uint32_t TDR;      /* 0x28 - Transmit data register */
+    volatile uint32_t PRESC;    /* 0x2C - Prescaler register */
+} USART_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+} TIM_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define GPIOD       ((GPIO_TypeDef *) GPIOD_BASE)
+#define USART3      ((USART_TypeDef *) USART3_BASE)
+#define TIM6        ((TIM_TypeDef *) TIM6_BASE)
+
+#define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
+
+/* DWT cycle counter (see the SPI tutorial) */
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB4ENR_GPIODEN     (1U << 3)
+#define RCC_APB1LENR_TIM6EN     (1U << 4)
+#define RCC_APB1LENR_USART3EN   (1U << 18)
+
+/* USART */
+#define USART_CR1_UE            (1U << 0)   /* USART enable */
+#define USART_CR1_TE            (1U << 3)   /* Transmitter enable */
+#define USART_CR1_FIFOEN        (1U << 29)  /* 16-byte TX/RX FIFOs */
+#define USART_ISR_TXE_TXFNF     (1U << 7)   /* TX FIFO not full */
+
+/* TIM */
+#define TIM_CR1_CEN             (1U << 0)
+#define TIM_DIER_UIE            (1U << 0)
+#define TIM_SR_UIF              (1U << 0)
+#define TIM_EGR_UG              (1U << 0)
+
+/* NVIC */
+#define TIM6_DAC_IRQn           54
+
+#define GPIO_AF7_USART3         7U
+#define HSI_CLOCK               64000000UL
+#define BAUD_RATE               115200UL
+
+/* ============================================================================
+ * 
+ *  LESSON 1: THE STRING STAYS ON THE PC
+ *  =====================================
+ * 
+ *  Every LOG() call puts its format string in its own linker section:
+ * 
+ *      static const char fmt[] __attribute__((section(".logstr"))) = "...";
+ * 
+ *  The ADDRESS of that string is its ID - one 32-bit word, known at link
+ *  time, unique for free. Add this to the linker script so the section
+ *  is kept in the ELF but never programmed into flash:
+ * 
+ *      .logstr 0 (INFO) : { KEEP(*(.logstr*)) }
+ * 
+ *  (Without it the strings simply land in flash - still correct, only
+ *  not free.)
+ * 
+ *  ONE RECORD IN THE RING:
+ * 
+ *      word 0   header     0xA5 │ nargs │ position (16 bits)  ← written LAST
+ *      word 1   string ID  address in .logstr
+ *      word 2   timestamp  DWT_CYCCNT (64 MHz → 15.6 ns resolution)
+ *      word 3+  arguments  one uint32_t each (0 .. LOG_MAX_ARGS)
+ * 
+ *  The ring starts out all zeros, and the drain sets every word it has
+ *  sent back to 0. So "header == 0" means "not committed yet", and the
+ *  0xA5 in the top byte means a header word can never be 0.
+ * 
+ *  Arguments are integers or pointers. A float must be sent as its bits
+ *  (memcpy into a uint32_t) and printed with %f by the decoder.
+ * 
+ * ============================================================================ */
+
+#define LOG_RING_WORDS          1024U       /* 4 KB, must be a power of 2 */
+#define LOG_RING_MASK           (LOG_RING_WORDS - 1U)
+#define LOG_MAX_ARGS            4U
+#define LOG_RECORD_MAX          (3U + LOG_MAX_ARGS)
+#define LOG_SYNC                0xA5U
+
+uint32_t log_ring[LOG_RING_WORDS];
+volatile uint32_t log_head = 0;         /* Next free word - claimed by writers */
+volatile uint32_t log_tail = 0;         /* Oldest unsent word - moved by the drain */
+
+/* Statistics - watch them in the debugger */
+volatile uint32_t log_records = 0;      /* Records committed */
+volatile uint32_t log_dropped = 0;      /* Records lost because the ring was full */
+volatile uint32_t log_cost_cycles = 0;  /* Cycles of one LOG() with 2 arguments */
+
+void Log_Write(const uint32_t *id_and_args, uint32_t count);
+
+/* The string gets its own section; the ID and the arguments travel as one
+ * array so a single function handles 0..LOG_MAX_ARGS arguments. */
+#define LOG(fmt, ...)                                                                   \
+    do {                                                                                \
+        static const char log_fmt_[] __attribute__((section(".logstr"), used)) = fmt;  \
+        const uint32_t log_words_[] = { (uint32_t)log_fmt_, ##__VA_ARGS__ };           \
+        _Static_assert(sizeof(log_words_) <= (1U + LOG_MAX_ARGS) * sizeof(uint32_t),   \
+                       "LOG: too many arguments");                                      \
+        Log_Write(log_words_, sizeof(log_words_) / sizeof(uint32_t));                   \
+    } while (0)
+
+/* ============================================================================
+ * 
+ *  LESSON 2: SHARING A RING WITHOUT DISABLING INTERRUPTS
+ *  ======================================================
+ * 
+ *  Main writes a record, TIM6 fires in the middle and writes its own.
+ *  Both read log_head = 100 and both write to words 100..104. Broken.
+ * 
+ *  The classic cure is cpsid i around the claim. The Cortex-M7 has a
+ *  cheaper one, built for exactly this - an exclusive load/store pair:
+ * 
+ *      LDREX  r0, [log_head]      read AND arm the "exclusive monitor"
+ *      ...compute new head...
+ *      STREX  r1, r2, [log_head]  store ONLY if nothing broke the monitor
+ *                                 r1 = 0 success, 1 = try again
+ * 
+ *  Every exception entry/exit clears the monitor. So if TIM6 ran between
+ *  our LDREX and STREX (and claimed its own words), our STREX fails and
+ *  we simply start over with the new head. Nobody ever waits, interrupts
+ *  stay on, and no two writers can own the same words.
+ * 
+ *  We read the timestamp INSIDE the retry loop: whoever claims first also
+ *  stamps first, so timestamps always increase along the ring.
+ * 
+ * ============================================================================ */
+
+static inline uint32_t LDREX(volatile uint32_t *addr) {
+    uint32_t value;
+    __asm volatile ("ldrex %0, [%1]" : "=r" (value) : "r" (addr) : "memory");
+    return value;
+}
+
+/* Returns 0 when the store happened */
+static inline uint32_t STREX(uint32_t value, volatile uint32_t *addr) {
+    uint32_t failed;
+    __asm volatile ("strex %0, %2, [%1]" : "=&r" (failed) : "r" (addr), "r" (value) : "memory");
+    return failed;
+}
+
+/* log_dropped++ that is safe from any context */
+void Log_CountDrop(void) {
+    uint32_t n;
+    do {
+        n = LDREX(&log_dropped);
+    } while (STREX(n + 1, &log_dropped));
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: CLAIM WORDS IN THE RING
+ *  ========================================
+ * 
+ *  log_head and log_tail run freely (they are never masked), so
+ *      used = head - tail      (correct even after 2^32 wraps)
+ *  A record of n words fits if  used + n <= LOG_RING_WORDS.
+ * 
+ * ============================================================================ */
+
+int Log_Claim(uint32_t words, uint32_t *start, uint32_t *stamp) {
+    uint32_t head;
+
+    do {
+        head = LDREX(&log_head);
+        if (head + words - log_tail > LOG_RING_WORDS) {
+            __asm volatile ("clrex");       /* Give the monitor back */
+            return -1;
+        }
+        *stamp = DWT_CYCCNT;
+
+        /* ✏️ YOUR TURN: Try to publish the new head, retry if it failed */
+    } while (STREX(???, &log_head));        /* HINT: Where does the next record start? */
+
+    *start = head;
+    return 0;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * } while (STREX(head + words, &log_head));
+ * 
+ * WHY NOT log_head += words?
+ *   That is three instructions (load, add, store). An interrupt between
+ *   the load and the store claims the same words. STREX detects exactly
+ *   that case - and the retry costs a few cycles, only when it happens.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: COMMIT THE RECORD
+ *  ==================================
+ * 
+ *  Body first, header last. The drain only looks at the header: while it
+ *  is 0 the record is "not there yet", however much of the body is.
+ * 
+ *  The DMB (data memory barrier) makes sure the body stores are visible
+ *  before the header store - the M7 may otherwise reorder them on the
+ *  bus.
+ * 
+ * ============================================================================ */
+
+void Log_Write(const uint32_t *id_and_args, uint32_t count) {
+    uint32_t nargs = count - 1U;
+    uint32_t words = count + 2U;        /* + header + timestamp */
+    uint32_t start, stamp;
+
+    if (Log_Claim(words, &start, &stamp) != 0) {
+        Log_CountDrop();
+        return;
+    }
+
+    log_ring[(start + 1U) & LOG_RING_MASK] = id_and_args[0];
+    log_ring[(start + 2U) & LOG_RING_MASK] = stamp;
+    for (uint32_t i = 1; i < count; i++) {
+        log_ring[(start + 2U + i) & LOG_RING_MASK] = id_and_args[i];
+    }
+
+    __asm volatile ("dmb" ::: "memory");
+
+    /* ✏️ YOUR TURN: Write the header - this is the moment the record exists */
+    log_ring[start & LOG_RING_MASK] = ???;  /* HINT: LOG_SYNC in bits 31:24, nargs in 23:16, start in 15:0 */
+
+    log_records++;                      /* Statistics only - a lost count is fine */
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * log_ring[start & LOG_RING_MASK] = (LOG_SYNC << 24) | (nargs << 16)
+ *                                 | (start & 0xFFFFU);
+ * 
+ * WHY THE POSITION? The decoder expects the next record at position +
+ * length. If it sees a jump, records were dropped (ring full) or bytes
+ * were lost on the wire - and it can say so instead of printing garbage.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  LESSON 3: DRAINING IN THE BACKGROUND
+ *  =====================================
+ * 
+ *  The main loop calls Log_Pump() whenever it is idle. Each call:
+ *  1. If nothing is being sent: copy the oldest COMMITTED record out of
+ *     the ring, zero its words and move log_tail → the space is free
+ *     again immediately, long before the bytes are on the wire
+ *  2. Push bytes into the USART TX FIFO until it is full - never wait
+ * 
+ *  If the oldest record is claimed but not committed (its writer was
+ *  interrupted), the pump simply returns and tries again later. Records
+ *  therefore always leave in ring order.
+ * 
+ *  Bandwidth: 5 words = 20 bytes ≈ 1.7 ms at 115200. Log at most a few
+ *  hundred records per second, or raise the baud rate (the ST-Link VCP
+ *  handles 921600 → 8x more).
+ * 
+ * ============================================================================ */
+
+uint32_t log_tx_words[LOG_RECORD_MAX];  /* Record being sent */
+uint32_t log_tx_len = 0;                /* Bytes in log_tx_words */
+uint32_t log_tx_pos = 0;                /* Bytes already in the FIFO */
+
+void Log_InitHardware(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIODEN;
+    RCC->APB1LENR |= RCC_APB1LENR_USART3EN | RCC_APB1LENR_TIM6EN;
+    (void)RCC->APB1LENR;
+
+    /* PD8 = USART3_TX, AF7 */
+    GPIOD->MODER &= ~(3U << (8 * 2));
+    GPIOD->MODER |= (2U << (8 * 2));
+    GPIOD->AFR[1] &= ~(0xFU << ((8 - 8) * 4));
+    GPIOD->AFR[1] |= (GPIO_AF7_USART3 << ((8 - 8) * 4));
+
+    /* USART3: 115200 8N1, TX only, FIFO on */
+    USART3->CR1 = 0;
+    USART3->BRR = HSI_CLOCK / BAUD_RATE;
+    USART3->CR1 = USART_CR1_FIFOEN | USART_CR1_TE;
+    USART3->CR1 |= USART_CR1_UE;
+
+    /* Cycle counter for timestamps */
+    DEMCR |= DEMCR_TRCENA;
+    DWT_LAR = 0xC5ACCE55;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: PUMP THE RING INTO THE UART
+ *  ============================================
+ * 
+ * ============================================================================ */
+
+void Log_Pump(void) {
+    if (log_tx_pos == log_tx_len) {
+        uint32_t tail = log_tail;
+        uint32_t header = log_ring[tail & LOG_RING_MASK];
+        uint32_t words;
+
+        if (header == 0) {
+            return;                     /* Empty, or oldest record not committed */
+        }
+        __asm volatile ("dmb" ::: "memory");
+
+        words = 3U + ((header >> 16) & 0xFFU);
+        for (uint32_t i = 0; i < words; i++) {
+            log_tx_words[i] = log_ring[(tail + i) & LOG_RING_MASK];
+            log_ring[(tail + i) & LOG_RING_MASK] = 0;
+        }
+        __asm volatile ("dmb" ::: "memory");
+
+        /* ✏️ YOUR TURN: Hand the words back to the writers */
+        log_tail = ???;                 /* HINT: The tail moves past the whole record */
+
+        log_tx_len = words * 4U;
+        log_tx_pos = 0;
+    }
+
+    /* Little-endian: the bytes of log_tx_words are already in wire order */
+    while (log_tx_pos < log_tx_len && (USART3->ISR & USART_ISR_TXE_TXFNF)) {
+        USART3->TDR = ((uint8_t *)log_tx_words)[log_tx_pos++];
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * log_tail = tail + words;
+ * 
+ * WHY ZERO EVERY WORD, NOT JUST THE HEADER?
+ *   The next record may start anywhere - for example on what used to be
+ *   an argument word. If that word were still non-zero, the pump would
+ *   take an uncommitted record for a finished one.
+ * 
+ * ORDER MATTERS: zero first, DMB, then move log_tail. A writer that sees
+ * the new tail may start filling those words at once.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Block until everything logged so far is on the wire (e.g. before reset) */
+void Log_Flush(void) {
+    while (log_tail != log_head || log_tx_pos != log_tx_len) {
+        Log_Pump();
+    }
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 4: THE DECODER ON THE PC
+ *  ================================
+ * 
+ *  The strings are in the ELF you flashed - extract them once per build:
+ * 
+ *      arm-none-eabi-objdump -h app.elf            → VMA of .logstr
+ *      arm-none-eabi-objcopy -O binary --only-section=.logstr \
+ *                            app.elf logstr.bin
+ * 
+ *  Then read the COM port 4 bytes at a time (Python sketch):
+ * 
+ *      strings = open("logstr.bin", "rb").read()
+ *      while True:
+ *          header = u32()
+ *          if header >> 24 != 0xA5:
+ *              drop one byte, try again        ← resynchronise
+ *              continue
+ *          nargs  = (header >> 16) & 0xFF
+ *          fmt_id = u32() - LOGSTR_VMA
+ *          stamp  = u32()
+ *          args   = [u32() for _ in range(nargs)]
+ *          fmt    = strings[fmt_id : strings.index(b"\0", fmt_id)]
+ *          print("%12.6f  %s" % (stamp / 64e6, fmt.decode() % tuple(args)))
+ * 
+ *  Python's % understands %u %d %x %08X directly. Check the position in
+ *  bits 15:0 against the previous record to report gaps.
+ * 
+ *  IMPORTANT: decode with the ELF of the running firmware. A rebuilt ELF
+ *  moves the strings - old IDs then print the wrong text.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: MEASURE IT
+ *  ===========================
+ * 
+ *  Time one LOG() with the cycle counter. Expect a few dozen cycles
+ *  (under 1 µs at 64 MHz) - compare that with 2.2 ms for the text line.
+ * 
+ * ============================================================================ */
+
+void Log_MeasureCost(void) {
+    uint32_t start = DWT_CYCCNT;
+
+    LOG("cost probe a=%u b=%u", 1U, 2U);
+
+    /* ✏️ YOUR TURN: Store the elapsed cycles */
+    log_cost_cycles = ???;              /* HINT: Now minus start */
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * log_cost_cycles = DWT_CYCCNT - start;
+ * 
+ * Unsigned subtraction stays correct when CYCCNT wraps (every 67 s).
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ *  A BUSY INTERRUPT THAT LOGS (TIM6, 1 kHz)
+ * ============================================================================ */
+
+volatile uint32_t tim6_ticks = 0;
+
+void TIM6_DAC_IRQHandler(void) {
+    if (TIM6->SR & TIM_SR_UIF) {
+        TIM6->SR = ~TIM_SR_UIF;
+        tim6_ticks++;
+
+        /* Safe from an ISR - and cheap enough to do every 100 ms */
+        if ((tim6_ticks % 100U) == 0) {
+            LOG("tim6 tick=%u", tim6_ticks);
+        }
+    }
+}
+
+void Tick_Start(void) {
+    TIM6->PSC = 63;                     /* 64 MHz / 64 = 1 MHz */
+    TIM6->ARR = 999;                    /* 1 ms */
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->SR = 0;
+    TIM6->DIER |= TIM_DIER_UIE;
+    TIM6->CR1 |= TIM_CR1_CEN;
+
+    NVIC_ISER[TIM6_DAC_IRQn / 32] = (1U << (TIM6_DAC_IRQn % 32));
+}
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Log from main and from TIM6, drain while idle
+ * 
+ * ============================================================================ */
+
+int main(void)
+{
+    uint32_t loops = 0;
+    uint32_t last_second = 0;
+
+    Log_InitHardware();
+    LOG("boot: ring=%u words, max %u args", LOG_RING_WORDS, LOG_MAX_ARGS);
+
+    Log_MeasureCost();
+    LOG("one LOG() = %u cycles", log_cost_cycles);
+
+    Tick_Start();
+
+    for (;;) {
+        loops++;
+
+        /* Once per second (tim6_ticks counts ms) */
+        if (tim6_ticks - last_second >= 1000U) {
+            last_second += 1000U;
+            LOG("main: %u loops/s, %u records, %u dropped",
+                loops, log_records, log_dropped);
+            loops = 0;
+        }
+
+        /* Idle time → bytes on the wire */
+        Log_Pump();
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've built a binary deferred logger without HAL:
+ * 
+ *  ✅ Format strings that never reach the target's flash or the UART
+ *  ✅ A record = header, string ID, timestamp, raw arguments
+ *  ✅ Lock-free claiming with LDREX/STREX - safe from any interrupt
+ *  ✅ Commit by writing the header last, behind a DMB
+ *  ✅ A non-blocking drain that frees ring space before sending
+ *  ✅ A decoder that rebuilds the text from the ELF
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Log every TIM6 tick instead of every 100th and watch log_dropped
+ *    climb - then switch to 921600 baud
+ *  • Put the same line through a text UART_SendString in the ISR and
+ *    measure the difference with DWT_CYCCNT
+ *  • Send the staged record in a UDP packet (Ethernet tutorial) instead
+ *    of over USART3 - 100 Mbit/s leaves no excuse to drop anything
+ *  • Add a LOG_ERROR level bit in the header and let the decoder colour it
+ * 
+ * ============================================================================ */
@@ -0,0 +1,976 @@
+/**
+ ******************************************************************************
+ * @file           : memcpy_tutorial.c
+ * @brief          : Learning fast memory copy, move, fill and compare
+ ******************************************************************************
+ * 
+ *  ███╗   ███╗███████╗███╗   ███╗ ██████╗██████╗ ██╗   ██╗
+ *  ████╗ ████║██╔════╝████╗ ████║██╔════╝██╔══██╗╚██╗ ██╔╝
+ *  ██╔████╔██║█████╗  ██╔████╔██║██║     ██████╔╝ ╚████╔╝ 
+ *  ██║╚██╔╝██║██╔══╝  ██║╚██╔╝██║██║     ██╔═══╝   ╚██╔╝  
+ *  ██║ ╚═╝ ██║███████╗██║ ╚═╝ ██║╚██████╗██║        ██║   
+ *  ╚═╝     ╚═╝╚══════╝╚═╝     ╚═╝ ╚═════╝╚═╝        ╚═╝   
+ * 
+ *  INTERACTIVE LEARNING: MOVING BYTES AT THE SPEED OF THE BUS
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. Why the memcpy() in newlib-nano copies one byte at a time
+ *  2. How the Cortex-M7 moves 8 bytes per instruction (LDRD/STRD, LDM/STM)
+ *  3. How to handle the unaligned head and tail of a buffer
+ *  4. How memmove() copies overlapping buffers safely (backwards)
+ *  5. How to make tiny copies fast without loops
+ *  6. How to measure it: cycles per size, alignment and RAM region
+ * 
+ *  PREREQUISITES:
+ *  - Complete the UART tutorial (USART3 on the ST-Link VCP)
+ *  - The DWT cycle counter from the SPI tutorial
+ *  - The memory regions tutorial (DTCM, AXI SRAM, SRAM1)
+ * 
+ *  HARDWARE:
+ *  - Nucleo-H753ZI: USART3 is the ST-Link Virtual COM Port
+ *    (PD8 = TX, 115200 8N1) - the benchmark table appears there
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐ (Advanced)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>             /* Only for the library versions we race against */
+
+/* ============================================================================
+ * 
+ *  LESSON 0: WHERE THE TIME GOES
+ *  ==============================
+ * 
+ *  The Ethernet tutorial builds every frame with memcpy() and memset().
+ *  newlib-nano is compiled for SIZE, so its memcpy is essentially:
+ * 
+ *      while (n--) *d++ = *s++;        one byte per ~2 cycles
+ * 
+ *  The Cortex-M7 has a 64-bit bus to its TCMs and AXI, and can issue two
+ *  instructions per cycle:
+ * 
+ *  ┌──────────────────────┬──────────────────┬─────────────────────────┐
+ *  │ Instruction          │ Moves            │ Needs                   │
+ *  ├──────────────────────┼──────────────────┼─────────────────────────┤
+ *  │ LDRB / STRB          │ 1 byte           │ nothing                 │
+ *  │ LDR / STR            │ 4 bytes          │ works unaligned (slower)│
+ *  │ LDRD / STRD          │ 8 bytes          │ 4-byte aligned address  │
+ *  │ LDM / STM {4 regs}   │ 16 bytes         │ 4-byte aligned address  │
+ *  └──────────────────────┴──────────────────┴─────────────────────────┘
+ * 
+ *  So a fast copy is three parts:
+ * 
+ *      head:  bytes until dst is 4-byte aligned       (0..3 bytes)
+ *      body:  32-byte blocks with LDRD/STRD, then words
+ *      tail:  the last 0..3 bytes
+ * 
+ *  If src and dst are aligned DIFFERENTLY (src = 0x...1, dst = 0x...0),
+ *  aligning dst leaves src unaligned. The M7 allows unaligned LDR (not
+ *  LDRD/LDM) in normal RAM, so the body becomes "LDR unaligned, STR
+ *  aligned" - still 4 bytes per instruction.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOD_BASE      0x58020C00UL
+#define USART3_BASE     0x40004800UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;      /* 0x00 - Control register 1 */
+    volatile uint32_t CR2;      /* 0x04 - Control register 2 */
+    volatile uint32_t CR3;      /* 0x08 - Control register 3 */
+    volatile uint32_t BRR;      /* 0x0C - Baud rate register */
+    volatile uint32_t GTPR;     /* 0x10 - Guard time and prescaler */
+    volatile uint32_t RTOR;     /* 0x14 - Receiver timeout */
+    volatile uint32_t RQR;      /* 0x18 - Request register */
+    volatile uint32_t ISR;      /* 0x1C - Interrupt and status register */
+    volatile uint32_t ICR;      /* 0x20 - Interrupt flag clear register */
+    volatile uint32_t RDR;      /* 0x24 - Receive data register */
+    volatile uint32_t TDR;      /* 0x28 - Transmit data register */
+    volatile uint32_t PRESC;    /* 0x2C - Prescaler register */
+} USART_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define GPIOD       ((GPIO_TypeDef *) GPIOD_BASE)
+#define USART3      ((USART_TypeDef *) USART3_BASE)
+
+/* DWT cycle counter (see the SPI tutorial) */
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB2ENR_SRAM1EN     (1U << 29)
+#define RCC_AHB4ENR_GPIODEN     (1U << 3)
+#define RCC_APB1LENR_USART3EN   (1U << 18)
+
+/* USART */
+#define USART_CR1_UE            (1U << 0)
+#define USART_CR1_TE            (1U << 3)
+#define USART_CR1_FIFOEN        (1U << 29)
+#define USART_ISR_TXE_TXFNF     (1U << 7)
+
+#define GPIO_AF7_USART3         7U
+#define HSI_CLOCK               64000000UL
+#define BAUD_RATE               115200UL
+
+/* ============================================================================
+ * 
+ *  LESSON 1: THE BLOCK MOVERS
+ *  ===========================
+ * 
+ *  The inner loops are a few lines of assembly, so the instructions are
+ *  exactly the ones we chose - the compiler is not asked to guess.
+ *  Each moves 32 bytes per iteration between 4-byte aligned addresses:
+ * 
+ *  • forward copy:  4 × LDRD + 4 × STRD, loads interleaved with stores
+ *                   so the M7 can pair them
+ *  • backward copy: LDMDB / STMDB ("decrement before") from the end
+ *  • fill:          STMIA of four registers holding the pattern, twice
+ * 
+ *  On any other CPU (the PC that runs the self-test) the same functions
+ *  are plain C with identical results - everything around them (head,
+ *  tail, alignment, overlap) is shared.
+ * 
+ *  One more trap: gcc recognises a byte-copy loop and replaces it with a
+ *  call to memcpy()! MEM_FUNC switches that off for our functions.
+ * 
+ * ============================================================================ */
+
+#define MEM_FUNC                __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+/* A word at any address - gcc emits a plain LDR/STR on the M7 */
+typedef struct __attribute__((packed)) {
+    uint32_t v;
+} Unaligned32_t;
+
+static inline uint32_t Load32(const uint8_t *p) {
+    return ((const Unaligned32_t *)p)->v;
+}
+
+static inline void Store32(uint8_t *p, uint32_t v) {
+    ((Unaligned32_t *)p)->v = v;
+}
+
+/* blocks × 32 bytes, d and s 4-byte aligned, blocks > 0 */
+MEM_FUNC static void Mem_CopyBlocks(uint32_t *d, const uint32_t *s, uint32_t blocks) {
+#if defined(__ARM_ARCH_7EM__)
+    __asm volatile (
+        "1:                             \n"
+        "    ldrd   r3, r4, [%[s], #0]  \n"
+        "    ldrd   r5, r6, [%[s], #8]  \n"
+        "    strd   r3, r4, [%[d], #0]  \n"
+        "    strd   r5, r6, [%[d], #8]  \n"
+        "    ldrd   r3, r4, [%[s], #16] \n"
+        "    ldrd   r5, r6, [%[s], #24] \n"
+        "    add    %[s], %[s], #32     \n"
+        "    strd   r3, r4, [%[d], #16] \n"
+        "    strd   r5, r6, [%[d], #24] \n"
+        "    add    %[d], %[d], #32     \n"
+        "    subs   %[n], %[n], #1      \n"
+        "    bne    1b                  \n"
+        : [d] "+r" (d), [s] "+r" (s), [n] "+r" (blocks)
+        :
+        : "r3", "r4", "r5", "r6", "cc", "memory");
+#else
+    do {
+        for (int i = 0; i < 8; i++) {
+            d[i] = s[i];
+        }
+        d += 8;
+        s += 8;
+    } while (--blocks);
+#endif
+}
+
+/* blocks × 32 bytes DOWNWARD: d and s point one past the end, aligned */
+MEM_FUNC static void Mem_CopyBlocksDown(uint32_t *d, const uint32_t *s, uint32_t blocks) {
+#if defined(__ARM_ARCH_7EM__)
+    __asm volatile (
+        "1:                                 \n"
+        "    ldmdb  %[s]!, {r3, r4, r5, r6} \n"
+        "    stmdb  %[d]!, {r3, r4, r5, r6} \n"
+        "    ldmdb  %[s]!, {r3, r4, r5, r6} \n"
+        "    stmdb  %[d]!, {r3, r4, r5, r6} \n"
+        "    subs   %[n], %[n], #1          \n"
+        "    bne    1b                      \n"
+        : [d] "+r" (d), [s] "+r" (s), [n] "+r" (blocks)
+        :
+        : "r3", "r4", "r5", "r6", "cc", "memory");
+#else
+    do {
+        for (int i = 1; i <= 8; i++) {
+            d[-i] = s[-i];
+        }
+        d -= 8;
+        s -= 8;
+    } while (--blocks);
+#endif
+}
+
+/* blocks × 32 bytes of word, d 4-byte aligned */
+MEM_FUNC static void Mem_SetBlocks(uint32_t *d, uint32_t word, uint32_t blocks) {
+#if defined(__ARM_ARCH_7EM__)
+    __asm volatile (
+        "    mov    r3, %[w]                \n"
+        "    mov    r4, %[w]                \n"
+        "    mov    r5, %[w]                \n"
+        "    mov    r6, %[w]                \n"
+        "1:                                 \n"
+        "    stmia  %[d]!, {r3, r4, r5, r6} \n"
+        "    stmia  %[d]!, {r3, r4, r5, r6} \n"
+        "    subs   %[n], %[n], #1          \n"
+        "    bne    1b                      \n"
+        : [d] "+r" (d), [n] "+r" (blocks)
+        : [w] "r" (word)
+        : "r3", "r4", "r5", "r6", "cc", "memory");
+#else
+    do {
+        for (int i = 0; i < 8; i++) {
+            d[i] = word;
+        }
+        d += 8;
+    } while (--blocks);
+#endif
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 2: TINY COPIES WITHOUT A LOOP
+ *  =====================================
+ * 
+ *  Most copies in a protocol stack are small: a 6-byte MAC address, a
+ *  2-byte EtherType, a 14-byte header. Setting up head/body/tail costs
+ *  more than the copy. For n = 8..16 two words from the front and two
+ *  from the back cover every byte - they may overlap in the middle, and
+ *  that is fine because the same bytes are written twice:
+ * 
+ *      n = 11:   [0 1 2 3][4 5 6 7]
+ *                          [3 4 5 6][7 8 9 10]
+ * 
+ *  All four loads happen before the first store, so this is also safe
+ *  for overlapping buffers (memmove).
+ * 
+ * ============================================================================ */
+
+#define MEM_SMALL_MAX           16U
+
+MEM_FUNC static void Mem_CopySmall(uint8_t *d, const uint8_t *s, uint32_t n) {
+    if (n >= 8) {
+        uint32_t a = Load32(s);
+        uint32_t b = Load32(s + 4);
+        uint32_t c = Load32(s + n - 8);
+        uint32_t e = Load32(s + n - 4);
+        Store32(d, a);
+        Store32(d + 4, b);
+        Store32(d + n - 8, c);
+        Store32(d + n - 4, e);
+    } else if (n >= 4) {
+        uint32_t a = Load32(s);
+        uint32_t b = Load32(s + n - 4);
+        Store32(d, a);
+        Store32(d + n - 4, b);
+    } else if (n > 0) {
+        uint8_t a = s[0];
+        uint8_t b = s[n / 2];
+        uint8_t c = s[n - 1];
+        d[0] = a;
+        d[n / 2] = b;
+        d[n - 1] = c;
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: THE FORWARD COPY
+ *  =================================
+ * 
+ *  Safe when dst < src, even if they overlap: every byte is read before
+ *  anything at or after it is written. Mem_Move() relies on that.
+ * 
+ * ============================================================================ */
+
+MEM_FUNC void *Mem_Copy(void *dst, const void *src, size_t n) {
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    if (n <= MEM_SMALL_MAX) {
+        Mem_CopySmall(d, s, (uint32_t)n);
+        return dst;
+    }
+
+    /* Head: bytes until d is word aligned */
+    /* ✏️ YOUR TURN: How many bytes to the next multiple of 4? */
+    uint32_t head = ???;                /* HINT: (0 - address) & 3 */
+    n -= head;
+    while (head--) {
+        *d++ = *s++;
+    }
+
+    if (((uintptr_t)s & 3U) == 0) {
+        /* Both aligned: 32-byte blocks, then words */
+        if (n >= 32) {
+            Mem_CopyBlocks((uint32_t *)d, (const uint32_t *)s, (uint32_t)(n / 32U));
+            d += n & ~(size_t)31U;
+            s += n & ~(size_t)31U;
+            n &= 31U;
+        }
+        while (n >= 4) {
+            *(uint32_t *)d = *(const uint32_t *)s;
+            d += 4;
+            s += 4;
+            n -= 4;
+        }
+    } else {
+        /* Different alignment: unaligned loads, aligned stores, 16 per turn */
+        while (n >= 16) {
+            uint32_t a = Load32(s);
+            uint32_t b = Load32(s + 4);
+            uint32_t c = Load32(s + 8);
+            uint32_t e = Load32(s + 12);
+            ((uint32_t *)d)[0] = a;
+            ((uint32_t *)d)[1] = b;
+            ((uint32_t *)d)[2] = c;
+            ((uint32_t *)d)[3] = e;
+            d += 16;
+            s += 16;
+            n -= 16;
+        }
+        while (n >= 4) {
+            *(uint32_t *)d = Load32(s);
+            d += 4;
+            s += 4;
+            n -= 4;
+        }
+    }
+
+    /* Tail */
+    while (n--) {
+        *d++ = *s++;
+    }
+    return dst;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * uint32_t head = (0U - (uint32_t)(uintptr_t)d) & 3U;
+ * 
+ * d = 0x...5 → head = 3; d = 0x...8 → head = 0. The same trick gives
+ * the bytes to ANY power-of-two boundary: (0 - addr) & (align - 1).
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: OVERLAPPING BUFFERS
+ *  ====================================
+ * 
+ *  memmove(buf + 1, buf, 100) - shifting a buffer up by one byte. A
+ *  forward copy would write buf[1] before reading it and smear buf[0]
+ *  across the whole range. Copying from the END backwards fixes it.
+ * 
+ * ============================================================================ */
+
+MEM_FUNC void *Mem_Move(void *dst, const void *src, size_t n) {
+    uint8_t *d = dst;
+    const uint8_t *s = src;
+
+    /* ✏️ YOUR TURN: When is a forward copy safe? */
+    if (d <= s || d >= ???) {           /* HINT: Where does the source end? */
+        return Mem_Copy(dst, src, n);
+    }
+    if (n <= MEM_SMALL_MAX) {
+        Mem_CopySmall(d, s, (uint32_t)n);
+        return dst;
+    }
+
+    /* Backwards: d and s now point one past the end */
+    d += n;
+    s += n;
+
+    while (((uintptr_t)d & 3U) != 0) {
+        *--d = *--s;
+        n--;
+    }
+
+    if (((uintptr_t)s & 3U) == 0) {
+        if (n >= 32) {
+            Mem_CopyBlocksDown((uint32_t *)d, (const uint32_t *)s, (uint32_t)(n / 32U));
+            d -= n & ~(size_t)31U;
+            s -= n & ~(size_t)31U;
+            n &= 31U;
+        }
+        while (n >= 4) {
+            d -= 4;
+            s -= 4;
+            *(uint32_t *)d = *(const uint32_t *)s;
+            n -= 4;
+        }
+    } else {
+        while (n >= 4) {
+            d -= 4;
+            s -= 4;
+            *(uint32_t *)d = Load32(s);
+            n -= 4;
+        }
+    }
+
+    while (n--) {
+        *--d = *--s;
+    }
+    return dst;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (d <= s || d >= s + n) {
+ * 
+ * Only "dst starts inside the source" needs the backward copy. Every
+ * backward step loads a word before storing one, so the source bytes
+ * still to be read (below s) are never overwritten.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+MEM_FUNC void *Mem_Set(void *dst, int value, size_t n) {
+    uint8_t *d = dst;
+    uint32_t word = 0x01010101U * (uint8_t)value;
+
+    if (n < MEM_SMALL_MAX) {
+        while (n--) {
+            *d++ = (uint8_t)value;
+        }
+        return dst;
+    }
+
+    while (((uintptr_t)d & 3U) != 0) {
+        *d++ = (uint8_t)value;
+        n--;
+    }
+    if (n >= 32) {
+        Mem_SetBlocks((uint32_t *)d, word, (uint32_t)(n / 32U));
+        d += n & ~(size_t)31U;
+        n &= 31U;
+    }
+    while (n >= 4) {
+        *(uint32_t *)d = word;
+        d += 4;
+        n -= 4;
+    }
+    while (n--) {
+        *d++ = (uint8_t)value;
+    }
+    return dst;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: COMPARE A WORD AT A TIME
+ *  =========================================
+ * 
+ *  Equal words need no further look. Only when two words differ do we
+ *  go back to bytes - to return the sign of the FIRST differing byte,
+ *  as memcmp() must.
+ * 
+ * ============================================================================ */
+
+MEM_FUNC int Mem_Compare(const void *a, const void *b, size_t n) {
+    const uint8_t *p = a;
+    const uint8_t *q = b;
+
+    /* Align p; q may stay unaligned (LDR handles it) */
+    while (n > 0 && ((uintptr_t)p & 3U) != 0) {
+        if (*p != *q) {
+            return *p - *q;
+        }
+        p++;
+        q++;
+        n--;
+    }
+
+    while (n >= 8) {
+        uint32_t p0 = ((const uint32_t *)p)[0];
+        uint32_t p1 = ((const uint32_t *)p)[1];
+        uint32_t q0 = Load32(q);
+        uint32_t q1 = Load32(q + 4);
+
+        /* ✏️ YOUR TURN: Skip ahead when both words match */
+        if (((p0 ^ q0) | (p1 ^ q1)) != ???) {   /* HINT: XOR of equal words is... */
+            break;                      /* The bytes below find which one */
+        }
+        p += 8;
+        q += 8;
+        n -= 8;
+    }
+
+    while (n > 0) {
+        if (*p != *q) {
+            return *p - *q;
+        }
+        p++;
+        q++;
+        n--;
+    }
+    return 0;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (((p0 ^ q0) | (p1 ^ q1)) != 0) {
+ * 
+ * One OR of two XORs tests 8 bytes with a single branch.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  LESSON 3: TRUST, BUT CHECK
+ *  ===========================
+ * 
+ *  Fast copy code has many paths: small / large, each alignment of src
+ *  and dst, overlap up and down, every tail length. Mem_SelfTest() runs
+ *  them all against the obvious byte-by-byte loop, with guard bytes
+ *  around the destination to catch a write one byte too far.
+ * 
+ *  It uses no registers, so it runs unchanged on the PC:
+ * 
+ *      gcc -O2 -DMEM_HOST_TEST memcpy_tutorial.c -o memtest && ./memtest
+ * 
+ *  (MEM_HOST_TEST replaces main() with one that only runs the test.)
+ * 
+ * ============================================================================ */
+
+#define MEM_TEST_SIZE           300U
+#define MEM_TEST_GUARD          0xA5U
+
+uint8_t mem_test_src[MEM_TEST_SIZE + 64];
+uint8_t mem_test_dst[MEM_TEST_SIZE + 64];
+uint8_t mem_test_ref[MEM_TEST_SIZE + 64];
+
+static uint32_t mem_test_seed = 12345;
+
+static uint8_t Mem_TestRandom(void) {
+    mem_test_seed = mem_test_seed * 1103515245U + 12345U;
+    return (uint8_t)(mem_test_seed >> 16);
+}
+
+static int Mem_SameBytes(const uint8_t *x, const uint8_t *y, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (x[i] != y[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int Mem_Sign(int v) {
+    return (v > 0) - (v < 0);
+}
+
+/* Number of failed cases, 0 = all good */
+uint32_t Mem_SelfTest(void) {
+    uint32_t failures = 0;
+
+    for (uint32_t i = 0; i < sizeof(mem_test_src); i++) {
+        mem_test_src[i] = Mem_TestRandom();
+    }
+
+    for (uint32_t n = 0; n <= MEM_TEST_SIZE; n += (n < 80U) ? 1U : 37U) {
+        for (uint32_t so = 0; so < 8; so++) {
+            for (uint32_t dof = 0; dof < 8; dof++) {
+                uint8_t fill = (uint8_t)(n + so);
+
+                /* Copy */
+                for (uint32_t i = 0; i < sizeof(mem_test_dst); i++) {
+                    mem_test_dst[i] = MEM_TEST_GUARD;
+                    mem_test_ref[i] = MEM_TEST_GUARD;
+                }
+                Mem_Copy(mem_test_dst + 16 + dof, mem_test_src + so, n);
+                for (uint32_t i = 0; i < n; i++) {
+                    mem_test_ref[16 + dof + i] = mem_test_src[so + i];
+                }
+                failures += !Mem_SameBytes(mem_test_dst, mem_test_ref, sizeof(mem_test_dst));
+
+                /* Compare: equal, then one byte changed somewhere */
+                failures += Mem_Compare(mem_test_dst + 16 + dof, mem_test_src + so, n) != 0;
+                if (n > 0) {
+                    uint32_t at = (so * 7U + dof) % n;
+                    mem_test_dst[16 + dof + at] ^= 0x40;
+                    failures += Mem_Sign(Mem_Compare(mem_test_dst + 16 + dof, mem_test_src + so, n)) !=
+                                Mem_Sign((int)mem_test_dst[16 + dof + at] - (int)mem_test_src[so + at]);
+                }
+
+                /* Set */
+                for (uint32_t i = 0; i < sizeof(mem_test_dst); i++) {
+                    mem_test_dst[i] = MEM_TEST_GUARD;
+                    mem_test_ref[i] = MEM_TEST_GUARD;
+                }
+                Mem_Set(mem_test_dst + 16 + dof, fill, n);
+                for (uint32_t i = 0; i < n; i++) {
+                    mem_test_ref[16 + dof + i] = fill;
+                }
+                failures += !Mem_SameBytes(mem_test_dst, mem_test_ref, sizeof(mem_test_dst));
+
+                /* Move within one buffer: up (so < dof) and down (so > dof) */
+                for (uint32_t i = 0; i < sizeof(mem_test_dst); i++) {
+                    mem_test_dst[i] = mem_test_src[i];
+                    mem_test_ref[i] = mem_test_src[i];
+                }
+                if (n + 16U <= MEM_TEST_SIZE) {
+                    uint8_t *from = mem_test_dst + 16 + so;
+                    uint8_t *to = mem_test_dst + 16 + dof * 3U;
+                    uint8_t tmp[MEM_TEST_SIZE];
+
+                    for (uint32_t i = 0; i < n; i++) {
+                        tmp[i] = mem_test_ref[16 + so + i];
+                    }
+                    for (uint32_t i = 0; i < n; i++) {
+                        mem_test_ref[16 + dof * 3U + i] = tmp[i];
+                    }
+                    Mem_Move(to, from, n);
+                    failures += !Mem_SameBytes(mem_test_dst, mem_test_ref, sizeof(mem_test_dst));
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 4: THE BENCHMARK
+ *  ========================
+ * 
+ *  Cycles for one call, smallest of several runs (the first run pays
+ *  for the instruction cache), for each size, src/dst alignment and RAM:
+ * 
+ *      DTCM → DTCM        64-bit, zero wait states - the best case
+ *      AXI  → AXI         through the AXI matrix
+ *      AXI  → SRAM1       D1 → D2, crossing domains
+ * 
+ *  The AXI SRAM and SRAM1 scratch areas below are assumed unused by your
+ *  linker script - check the map (memory regions tutorial). With the
+ *  D-cache on, AXI and SRAM1 numbers improve a lot after the first run.
+ * 
+ * ============================================================================ */
+
+#define BENCH_MAX               4096U
+#define BENCH_RUNS              4U
+
+uint8_t bench_dtcm_src[BENCH_MAX + 8] __attribute__((aligned(8)));
+uint8_t bench_dtcm_dst[BENCH_MAX + 8] __attribute__((aligned(8)));
+
+#define BENCH_AXI_SRC           ((uint8_t *) 0x24070000UL)  /* Top 64 KB of AXI SRAM */
+#define BENCH_AXI_DST           ((uint8_t *) 0x24078000UL)
+#define BENCH_SRAM1_DST         ((uint8_t *) 0x30000000UL)
+
+typedef void *(*CopyFn_t)(void *, const void *, size_t);
+typedef void *(*SetFn_t)(void *, int, size_t);
+
+uint32_t Bench_Copy(CopyFn_t fn, uint8_t *d, const uint8_t *s, uint32_t n) {
+    uint32_t best = 0xFFFFFFFFU;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+        uint32_t start = DWT_CYCCNT;
+        fn(d, s, n);
+        uint32_t cycles = DWT_CYCCNT - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+uint32_t Bench_Set(SetFn_t fn, uint8_t *d, uint32_t n) {
+    uint32_t best = 0xFFFFFFFFU;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+        uint32_t start = DWT_CYCCNT;
+        fn(d, 0x5A, n);
+        uint32_t cycles = DWT_CYCCNT - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+/* ============================================================================
+ *  UART OUTPUT (polled, for the report)
+ * ============================================================================ */
+
+void UART_Init(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIODEN;
+    RCC->APB1LENR |= RCC_APB1LENR_USART3EN;
+    (void)RCC->APB1LENR;
+
+    /* PD8 = USART3_TX, AF7 */
+    GPIOD->MODER &= ~(3U << (8 * 2));
+    GPIOD->MODER |= (2U << (8 * 2));
+    GPIOD->AFR[1] &= ~(0xFU << ((8 - 8) * 4));
+    GPIOD->AFR[1] |= (GPIO_AF7_USART3 << ((8 - 8) * 4));
+
+    USART3->CR1 = 0;
+    USART3->BRR = HSI_CLOCK / BAUD_RATE;
+    USART3->CR1 = USART_CR1_FIFOEN | USART_CR1_TE;
+    USART3->CR1 |= USART_CR1_UE;
+}
+
+void UART_SendChar(char c) {
+    while (!(USART3->ISR & USART_ISR_TXE_TXFNF));
+    USART3->TDR = (uint8_t)c;
+}
+
+void UART_SendString(const char *s) {
+    while (*s) {
+        UART_SendChar(*s++);
+    }
+}
+
+void UART_SendDec(uint32_t value, uint32_t width) {
+    char buf[10];
+    uint32_t n = 0;
+
+    do {
+        buf[n++] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while (value > 0 && n < sizeof(buf));
+    while (width-- > n) {
+        UART_SendChar(' ');
+    }
+    while (n > 0) {
+        UART_SendChar(buf[--n]);
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: PRINT THE RACE
+ *  ===============================
+ * 
+ *      memcpy DTCM->DTCM aligned
+ *       size   libc   ours  speed-up x10
+ *          4     14      9     15
+ *       1536   3100    420     73
+ * 
+ * ============================================================================ */
+
+static const uint32_t bench_sizes[] = { 4, 16, 64, 256, 1536, 4096 };
+
+void Bench_CopyTable(const char *title, uint8_t *d, const uint8_t *s) {
+    UART_SendString("\r\nmemcpy ");
+    UART_SendString(title);
+    UART_SendString("\r\n size   libc   ours  speed-up x10\r\n");
+
+    for (uint32_t i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        uint32_t n = bench_sizes[i];
+        uint32_t libc = Bench_Copy(memcpy, d, s, n);
+        uint32_t ours = Bench_Copy(Mem_Copy, d, s, n);
+
+        UART_SendDec(n, 5);
+        UART_SendDec(libc, 7);
+        UART_SendDec(ours, 7);
+
+        /* ✏️ YOUR TURN: Speed-up in tenths (25 = 2.5 times faster) */
+        UART_SendDec(???, 7);           /* HINT: libc * 10 / ours */
+        UART_SendString("\r\n");
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * UART_SendDec(libc * 10U / ours, 7);
+ * 
+ * Expect little gain at 4 bytes (call overhead dominates) and the most
+ * at the large aligned sizes, where LDRD/STRD keep the bus full.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void Bench_SetTable(const char *title, uint8_t *d) {
+    UART_SendString("\r\nmemset ");
+    UART_SendString(title);
+    UART_SendString("\r\n size   libc   ours  speed-up x10\r\n");
+
+    for (uint32_t i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++) {
+        uint32_t n = bench_sizes[i];
+        uint32_t libc = Bench_Set(memset, d, n);
+        uint32_t ours = Bench_Set(Mem_Set, d, n);
+
+        UART_SendDec(n, 5);
+        UART_SendDec(libc, 7);
+        UART_SendDec(ours, 7);
+        UART_SendDec(libc * 10U / ours, 7);
+        UART_SendString("\r\n");
+    }
+}
+
+void Bench_Run(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_LAR = 0xC5ACCE55;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    RCC->AHB2ENR |= RCC_AHB2ENR_SRAM1EN;
+    (void)RCC->AHB2ENR;
+
+    Bench_CopyTable("DTCM->DTCM aligned", bench_dtcm_dst, bench_dtcm_src);
+    Bench_CopyTable("DTCM->DTCM src+1", bench_dtcm_dst, bench_dtcm_src + 1);
+    Bench_CopyTable("AXI->AXI aligned", BENCH_AXI_DST, BENCH_AXI_SRC);
+    Bench_CopyTable("AXI->SRAM1 aligned", BENCH_SRAM1_DST, BENCH_AXI_SRC);
+    Bench_SetTable("DTCM aligned", bench_dtcm_dst);
+    Bench_SetTable("AXI dst+3", BENCH_AXI_DST + 3);
+}
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Check every path, then race newlib
+ * 
+ * ============================================================================ */
+
+volatile uint32_t mem_self_test_failures = 0;
+
+#ifdef MEM_HOST_TEST
+
+#include <stdio.h>
+
+int main(void)
+{
+    mem_self_test_failures = Mem_SelfTest();
+    printf("Mem_SelfTest: %u failures\n", (unsigned)mem_self_test_failures);
+    return mem_self_test_failures != 0;
+}
+
+#else
+
+int main(void)
+{
+    UART_Init();
+
+    mem_self_test_failures = Mem_SelfTest();
+    UART_SendString("\r\nself-test failures: ");
+    UART_SendDec(mem_self_test_failures, 1);
+    UART_SendString("\r\n");
+
+    if (mem_self_test_failures == 0) {
+        Bench_Run();
+    }
+
+    for (;;) {
+    }
+}
+
+#endif
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've written the memory routines every program leans on:
+ * 
+ *  ✅ Head / body / tail: align the destination, move blocks, finish
+ *  ✅ 32 bytes per loop with LDRD/STRD, LDMDB/STMDB and STMIA
+ *  ✅ Unaligned sources with plain LDR - no byte loop fallback
+ *  ✅ Branch-free copies for 0..16 bytes
+ *  ✅ A memmove() that picks the safe direction
+ *  ✅ A memcmp() that tests 8 bytes per branch
+ *  ✅ A self-test that also runs on the PC, and a benchmark per RAM
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Replace memcpy/memset in the Ethernet tutorial with Mem_Copy /
+ *    Mem_Set and time ETH_SendFrame() with DWT_CYCCNT
+ *  • Enable the D-cache (Cortex tutorial) and run the benchmark again
+ *  • Put Mem_Copy in ITCM with ITCM_CODE (memory regions tutorial)
+ *  • Try 64-byte blocks - where does the gain stop?
+ * 
+ * ============================================================================ */
@@ -0,0 +1,836 @@
+/**
+ ******************************************************************************
+ * @file           : memory_regions_tutorial.c
+ * @brief          : Learning where to put buffers in the H7's RAMs
+ ******************************************************************************
+ * 
+ *  ███╗   ███╗███████╗███╗   ███╗    ███╗   ███╗ █████╗ ██████╗ 
+ *  ████╗ ████║██╔════╝████╗ ████║    ████╗ ████║██╔══██╗██╔══██╗
+ *  ██╔████╔██║█████╗  ██╔████╔██║    ██╔████╔██║███████║██████╔╝
+ *  ██║╚██╔╝██║██╔══╝  ██║╚██╔╝██║    ██║╚██╔╝██║██╔══██║██╔═══╝ 
+ *  ██║ ╚═╝ ██║███████╗██║ ╚═╝ ██║    ██║ ╚═╝ ██║██║  ██║██║     
+ *  ╚═╝     ╚═╝╚══════╝╚═╝     ╚═╝    ╚═╝     ╚═╝╚═╝  ╚═╝╚═╝     
+ * 
+ *  INTERACTIVE LEARNING: EVERY BUFFER IN THE RAM ITS BUS MASTER CAN SEE
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. The seven memories of the STM32H753 and who can reach each one
+ *  2. How to place a variable in a chosen RAM with a section attribute
+ *  3. How a linker script gives every region its own .data and .bss
+ *  4. How to make the COMPILER reject a DMA buffer in the wrong RAM
+ *  5. How to check a run-time pointer before handing it to a DMA
+ *  6. How to print a memory map from the running firmware
+ * 
+ *  PREREQUISITES:
+ *  - Complete the DMA tutorial (streams, NDTR, flags)
+ *  - Complete the UART tutorial (USART3 on the ST-Link VCP)
+ * 
+ *  HARDWARE:
+ *  - Nucleo-H753ZI: USART3 is the ST-Link Virtual COM Port
+ *    (PD8 = TX, 115200 8N1) - the map report appears there
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐ (Advanced)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: ONE CHIP, SEVEN MEMORIES
+ *  ===================================
+ * 
+ *  The H7 is three "domains" joined by bus matrices. Each memory hangs
+ *  off one of them, and each bus MASTER (CPU, DMA, Ethernet...) only
+ *  sees the memories its matrix connects it to:
+ * 
+ *  ┌────────────┬────────────┬───────┬──────┬──────┬──────┬──────┬─────┐
+ *  │ Region     │ Address    │ Size  │ CPU  │ MDMA │DMA1/2│ BDMA │ ETH │
+ *  ├────────────┼────────────┼───────┼──────┼──────┼──────┼──────┼─────┤
+ *  │ ITCM       │ 0x00000000 │ 64 K  │  ✓   │  ✓   │  ✗   │  ✗   │  ✗  │
+ *  │ DTCM       │ 0x20000000 │ 128 K │  ✓   │  ✓   │  ✗   │  ✗   │  ✗  │
+ *  │ AXI SRAM   │ 0x24000000 │ 512 K │  ✓   │  ✓   │  ✓   │  ✗   │  ✓  │
+ *  │ SRAM1-3    │ 0x30000000 │ 288 K │  ✓   │  ✓   │  ✓   │  ✗   │  ✓  │
+ *  │ SRAM4      │ 0x38000000 │ 64 K  │  ✓   │  ✓   │  ✓   │  ✓   │  ✓  │
+ *  │ Backup     │ 0x38800000 │ 4 K   │  ✓   │  ✓   │  ✓   │  ✓   │  ✗  │
+ *  │ Flash      │ 0x08000000 │ 2 M   │  ✓   │  ✓   │  ✓   │  ✗   │  ✓  │
+ *  └────────────┴────────────┴───────┴──────┴──────┴──────┴──────┴─────┘
+ * 
+ *  WHAT GOES WRONG:
+ *  • DMA1 pointed at DTCM: transfer error (TEIF) - or, if nobody checks
+ *    the flag, a buffer that silently never fills
+ *  • BDMA (ADC3, SPI6, LPUART1) pointed anywhere but SRAM4/backup: same
+ *  • Ethernet descriptors in DTCM: the MAC never sees a packet
+ *  • Legal but slow: a D2 DMA streaming to AXI SRAM crosses from D2 to
+ *    D1 and competes with the CPU there; SRAM1-3 is local to it
+ * 
+ *  And the linker does not know any of this. Many linker scripts put
+ *  ALL of .data, .bss and the stack in DTCM - so every plain global is
+ *  out of DMA1's reach.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define PWR_BASE        0x58024800UL
+#define GPIOD_BASE      0x58020C00UL
+#define USART3_BASE     0x40004800UL
+#define DMA1_BASE       0x40020000UL
+#define DMA1_Stream0    (DMA1_BASE + 0x010)
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CSR1;
+    volatile uint32_t CR2;
+    volatile uint32_t CR3;
+} PWR_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;      /* 0x00 - Control register 1 */
+    volatile uint32_t CR2;      /* 0x04 - Control register 2 */
+    volatile uint32_t CR3;      /* 0x08 - Control register 3 */
+    volatile uint32_t BRR;      /* 0x0C - Baud rate register */
+    volatile uint32_t GTPR;     /* 0x10 - Guard time and prescaler */
+    volatile uint32_t RTOR;     /* 0x14 - Receiver timeout */
+    volatile uint32_t RQR;      /* 0x18 - Request register */
+    volatile uint32_t ISR;      /* 0x1C - Interrupt and status register */
+    volatile uint32_t ICR;      /* 0x20 - Interrupt flag clear register */
+    volatile uint32_t RDR;      /* 0x24 - Receive data register */
+    volatile uint32_t TDR;      /* 0x28 - Transmit data register */
+    volatile uint32_t PRESC;    /* 0x2C - Prescaler register */
+} USART_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR;       /* Configuration register */
+    volatile uint32_t NDTR;     /* Number of data register */
+    volatile uint32_t PAR;      /* Peripheral address register */
+    volatile uint32_t M0AR;     /* Memory 0 address register */
+    volatile uint32_t M1AR;     /* Memory 1 address register */
+    volatile uint32_t FCR;      /* FIFO control register */
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    volatile uint32_t LISR;     /* Low interrupt status register */
+    volatile uint32_t HISR;     /* High interrupt status register */
+    volatile uint32_t LIFCR;    /* Low interrupt flag clear register */
+    volatile uint32_t HIFCR;    /* High interrupt flag clear register */
+} DMA_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define PWR         ((PWR_TypeDef *) PWR_BASE)
+#define GPIOD       ((GPIO_TypeDef *) GPIOD_BASE)
+#define USART3      ((USART_TypeDef *) USART3_BASE)
+#define DMA1        ((DMA_TypeDef *) DMA1_BASE)
+#define DMA1_S0     ((DMA_Stream_TypeDef *) DMA1_Stream0)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB1ENR_DMA1EN      (1U << 0)
+#define RCC_AHB2ENR_SRAM1EN     (1U << 29)  /* D2 SRAMs: clock off after reset */
+#define RCC_AHB2ENR_SRAM2EN     (1U << 30)
+#define RCC_AHB2ENR_SRAM3EN     (1U << 31)
+#define RCC_AHB4ENR_GPIODEN     (1U << 3)
+#define RCC_AHB4ENR_BKPRAMEN    (1U << 28)
+#define RCC_APB1LENR_USART3EN   (1U << 18)
+
+/* PWR */
+#define PWR_CR1_DBP             (1U << 8)   /* Backup domain write access */
+
+/* USART */
+#define USART_CR1_UE            (1U << 0)
+#define USART_CR1_TE            (1U << 3)
+#define USART_CR1_FIFOEN        (1U << 29)
+#define USART_ISR_TXE_TXFNF     (1U << 7)
+#define USART_ISR_TC            (1U << 6)
+
+/* DMA */
+#define DMA_CR_EN               (1U << 0)
+#define DMA_CR_DIR_M2M          (2U << 6)
+#define DMA_CR_PINC             (1U << 9)
+#define DMA_CR_MINC             (1U << 10)
+#define DMA_CR_PSIZE_32         (2U << 11)
+#define DMA_CR_MSIZE_32         (2U << 13)
+#define DMA_FCR_FTH_FULL        (3U << 0)
+#define DMA_FCR_DMDIS           (1U << 2)   /* FIFO mode - required for M2M */
+#define DMA_LISR_TEIF0          (1U << 3)
+#define DMA_LISR_TCIF0          (1U << 5)
+#define DMA_S0_FLAGS_ALL        0x3DU
+
+#define GPIO_AF7_USART3         7U
+#define HSI_CLOCK               64000000UL
+#define BAUD_RATE               115200UL
+
+/* ============================================================================
+ * 
+ *  LESSON 1: REGIONS AND MASTERS AS BIT MASKS
+ *  ===========================================
+ * 
+ *  Give every region one bit. Then "which regions can this master
+ *  reach" is a mask, and "can DMA1 reach AXI SRAM" is a single AND -
+ *  one the compiler can evaluate.
+ * 
+ * ============================================================================ */
+
+#define REGION_ITCM             (1U << 0)
+#define REGION_DTCM             (1U << 1)
+#define REGION_AXI              (1U << 2)   /* AXI SRAM */
+#define REGION_D2               (1U << 3)   /* SRAM1-3 */
+#define REGION_D3               (1U << 4)   /* SRAM4 */
+#define REGION_BACKUP           (1U << 5)   /* Backup SRAM */
+#define REGION_FLASH            (1U << 6)
+
+#define REACH_CPU               0x7FU
+#define REACH_MDMA              0x7FU
+#define REACH_DMA               (REGION_AXI | REGION_D2 | REGION_D3 | REGION_BACKUP | REGION_FLASH)
+#define REACH_BDMA              (REGION_D3 | REGION_BACKUP)
+#define REACH_ETH               (REGION_AXI | REGION_D2 | REGION_D3 | REGION_FLASH)
+
+/* Output sections - the linker script below maps them to regions */
+#define SECTION_BSS_DTCM        ".dtcm_bss"
+#define SECTION_DATA_DTCM       ".dtcm_data"
+#define SECTION_BSS_AXI         ".axi_bss"
+#define SECTION_DATA_AXI        ".axi_data"
+#define SECTION_BSS_D2          ".d2_bss"
+#define SECTION_DATA_D2         ".d2_data"
+#define SECTION_BSS_D3          ".d3_bss"
+#define SECTION_DATA_D3         ".d3_data"
+#define SECTION_BSS_BACKUP      ".backup_noinit"    /* Never cleared - it must survive resets */
+
+/* Place a variable: PLACE(AXI) is zeroed at start-up, PLACE_INIT(AXI)
+ * gets its initial value copied from flash. 32-byte alignment keeps
+ * each buffer on its own cache lines. */
+#define PLACE(region)           __attribute__((section(SECTION_BSS_##region), aligned(32)))
+#define PLACE_INIT(region)      __attribute__((section(SECTION_DATA_##region), aligned(32)))
+
+/* Code that must not wait for flash (ISRs, inner loops): copied to ITCM */
+#define ITCM_CODE               __attribute__((section(".itcm_text"), noinline))
+
+/* ============================================================================
+ * 
+ *  LESSON 2: THE LINKER SCRIPT
+ *  ============================
+ * 
+ *  Add the regions and one output section per region to your script
+ *  (the usual .isr_vector, .text, .data and .bss stay as they are, in
+ *  FLASH and DTCM):
+ * 
+ *  MEMORY
+ *  {
+ *    FLASH   (rx)  : ORIGIN = 0x08000000, LENGTH = 2048K
+ *    ITCM    (xrw) : ORIGIN = 0x00000000, LENGTH = 64K
+ *    DTCM    (xrw) : ORIGIN = 0x20000000, LENGTH = 128K
+ *    AXI     (xrw) : ORIGIN = 0x24000000, LENGTH = 512K
+ *    SRAM123 (xrw) : ORIGIN = 0x30000000, LENGTH = 288K
+ *    SRAM4   (xrw) : ORIGIN = 0x38000000, LENGTH = 64K
+ *    BACKUP  (rw)  : ORIGIN = 0x38800000, LENGTH = 4K
+ *  }
+ * 
+ *  SECTIONS
+ *  {
+ *    ...existing .isr_vector, .text, .rodata...
+ * 
+ *    .data : { ... *(.dtcm_data*) ... } > DTCM AT> FLASH
+ *    .bss  : { ... } > DTCM
+ *    .dtcm_bss (NOLOAD) : { . = ALIGN(32); *(.dtcm_bss*) . = ALIGN(32); } > DTCM
+ *    __dtcm_used_start__ = ADDR(.data);
+ *    __dtcm_used_end__ = ADDR(.dtcm_bss) + SIZEOF(.dtcm_bss);
+ * 
+ *    .itcm_text : { __itcm_used_start__ = .; *(.itcm_text*) . = ALIGN(4);
+ *                   __itcm_used_end__ = .; } > ITCM AT> FLASH
+ * 
+ *    .axi_data : { . = ALIGN(32); __axi_used_start__ = .; *(.axi_data*)
+ *                  . = ALIGN(32); } > AXI AT> FLASH
+ *    .axi_bss (NOLOAD) : { . = ALIGN(32); *(.axi_bss*) . = ALIGN(32);
+ *                  __axi_used_end__ = .; } > AXI
+ * 
+ *    (.d2_data / .d2_bss > SRAM123 and .d3_data / .d3_bss > SRAM4: the
+ *     same pattern with __d2_used_... and __d3_used_...)
+ * 
+ *    .backup (NOLOAD) : { __backup_used_start__ = .; *(.backup_noinit*)
+ *                  __backup_used_end__ = .; } > BACKUP
+ * 
+ *    .region_tables : {
+ *      . = ALIGN(4);
+ *      __region_copy_table_start__ = .;
+ *      LONG(LOADADDR(.itcm_text)) LONG(ADDR(.itcm_text)) LONG(ADDR(.itcm_text) + SIZEOF(.itcm_text))
+ *      LONG(LOADADDR(.axi_data))  LONG(ADDR(.axi_data))  LONG(ADDR(.axi_data) + SIZEOF(.axi_data))
+ *      LONG(LOADADDR(.d2_data))   LONG(ADDR(.d2_data))   LONG(ADDR(.d2_data) + SIZEOF(.d2_data))
+ *      LONG(LOADADDR(.d3_data))   LONG(ADDR(.d3_data))   LONG(ADDR(.d3_data) + SIZEOF(.d3_data))
+ *      __region_copy_table_end__ = .;
+ *      __region_zero_table_start__ = .;
+ *      LONG(ADDR(.dtcm_bss)) LONG(ADDR(.dtcm_bss) + SIZEOF(.dtcm_bss))
+ *      LONG(ADDR(.axi_bss))  LONG(ADDR(.axi_bss) + SIZEOF(.axi_bss))
+ *      LONG(ADDR(.d2_bss))   LONG(ADDR(.d2_bss) + SIZEOF(.d2_bss))
+ *      LONG(ADDR(.d3_bss))   LONG(ADDR(.d3_bss) + SIZEOF(.d3_bss))
+ *      __region_zero_table_end__ = .;
+ *    } > FLASH
+ *  }
+ * 
+ *  The startup code only copies .data and clears .bss. The two TABLES
+ *  tell Memory_InitRegions() what else to copy and clear - add a region
+ *  and it is one more LONG line, no code change. Backup SRAM is in
+ *  neither table on purpose.
+ * 
+ *  Why (NOLOAD) on every *_bss section? gcc only emits sections named
+ *  .bss... as "nobits". .dtcm_bss and friends come out as PROGBITS, so
+ *  without NOLOAD - or mixed into .bss - the linker warns and stores
+ *  all those zeros in flash. The zero table clears them instead.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    const uint32_t *load;               /* In flash */
+    uint32_t *start;                    /* In the region */
+    uint32_t *end;
+} RegionCopy_t;
+
+typedef struct {
+    uint32_t *start;
+    uint32_t *end;
+} RegionZero_t;
+
+/* Weak: without the linker script above they are 0 and nothing happens */
+extern const RegionCopy_t __region_copy_table_start__[] __attribute__((weak));
+extern const RegionCopy_t __region_copy_table_end__[] __attribute__((weak));
+extern const RegionZero_t __region_zero_table_start__[] __attribute__((weak));
+extern const RegionZero_t __region_zero_table_end__[] __attribute__((weak));
+
+extern uint8_t __itcm_used_start__[] __attribute__((weak));
+extern uint8_t __itcm_used_end__[] __attribute__((weak));
+extern uint8_t __dtcm_used_start__[] __attribute__((weak));
+extern uint8_t __dtcm_used_end__[] __attribute__((weak));
+extern uint8_t __axi_used_start__[] __attribute__((weak));
+extern uint8_t __axi_used_end__[] __attribute__((weak));
+extern uint8_t __d2_used_start__[] __attribute__((weak));
+extern uint8_t __d2_used_end__[] __attribute__((weak));
+extern uint8_t __d3_used_start__[] __attribute__((weak));
+extern uint8_t __d3_used_end__[] __attribute__((weak));
+extern uint8_t __backup_used_start__[] __attribute__((weak));
+extern uint8_t __backup_used_end__[] __attribute__((weak));
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: INITIALISE EVERY REGION
+ *  ========================================
+ * 
+ *  Call this before main() touches any placed variable - best from
+ *  Reset_Handler right after the .data copy; in this tutorial it is the
+ *  first line of main().
+ * 
+ * ============================================================================ */
+
+void Memory_InitRegions(void) {
+    /* SRAM1-3 have no clock after reset; backup SRAM needs DBP too */
+    RCC->AHB2ENR |= RCC_AHB2ENR_SRAM1EN | RCC_AHB2ENR_SRAM2EN | RCC_AHB2ENR_SRAM3EN;
+    RCC->AHB4ENR |= RCC_AHB4ENR_BKPRAMEN;
+    PWR->CR1 |= PWR_CR1_DBP;
+    (void)RCC->AHB4ENR;
+
+    for (const RegionCopy_t *c = __region_copy_table_start__; c < __region_copy_table_end__; c++) {
+        const uint32_t *src = c->load;
+        for (uint32_t *dst = c->start; dst < c->end; dst++) {
+            *dst = *src++;
+        }
+    }
+
+    for (const RegionZero_t *z = __region_zero_table_start__; z < __region_zero_table_end__; z++) {
+        for (uint32_t *dst = z->start; dst < z->end; dst++) {
+            /* ✏️ YOUR TURN: Clear the word */
+            *dst = ???;                 /* HINT: .bss starts as... */
+        }
+    }
+
+    /* Code was copied into ITCM - make sure the core fetches the new bytes */
+    __asm volatile ("dsb\n isb" ::: "memory");
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * *dst = 0;
+ * 
+ * WHY WORDS? Every output section is aligned to 4 (or 32) bytes in the
+ * script, so start and end are always whole words.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  LESSON 3: LET THE COMPILER CHECK THE PLACEMENT
+ *  ===============================================
+ * 
+ *  DMA_BUFFER(master, region) places the variable AND states who will
+ *  use it. A _Static_assert compares the two masks at compile time:
+ * 
+ *      DMA_BUFFER(DMA, AXI)  uint8_t uart_rx[256];     ✓ compiles
+ *      DMA_BUFFER(BDMA, AXI) uint16_t adc3_rx[64];     ✗ error:
+ *                                "BDMA cannot reach AXI"
+ * 
+ *  The mistake never reaches the board. (It only works for buffers
+ *  declared this way - pointers computed at run time are checked by
+ *  Memory_DmaCanReach() below.)
+ * 
+ * ============================================================================ */
+
+#define DMA_BUFFER(master, region)                                              \
+    _Static_assert((REACH_##master & REGION_##region) != 0,                     \
+                   #master " cannot reach " #region);                           \
+    PLACE(region)
+
+#define DMA_BUFFER_INIT(master, region)                                         \
+    _Static_assert((REACH_##master & REGION_##region) != 0,                     \
+                   #master " cannot reach " #region);                           \
+    PLACE_INIT(region)
+
+/* The DMA tutorial's buffers, placed on purpose */
+DMA_BUFFER_INIT(DMA, AXI) uint32_t source_buffer[16] = {
+    0x11111111, 0x22222222, 0x33333333, 0x44444444,
+    0x55555555, 0x66666666, 0x77777777, 0x88888888,
+    0x99999999, 0xAAAAAAAA, 0xBBBBBBBB, 0xCCCCCCCC,
+    0xDDDDDDDD, 0xEEEEEEEE, 0xFFFFFFFF, 0x00000000
+};
+DMA_BUFFER(DMA, D2) uint32_t dest_buffer[16];
+
+/* Ethernet descriptors and buffers: the MAC is a D2 master */
+DMA_BUFFER(ETH, D2) uint32_t eth_rx_descriptors[4][4];
+DMA_BUFFER(ETH, D2) uint8_t eth_rx_buffers[4][1536];
+
+/* CPU-only work data: DTCM, no wait states */
+PLACE(DTCM) uint32_t filter_state[64];
+
+/* Kept across resets (not across power loss without VBAT) */
+PLACE(BACKUP) uint32_t reset_count;
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: A BUFFER FOR THE BDMA
+ *  ======================================
+ * 
+ *  ADC3 and SPI6 live in D3 and are served by the BDMA. Try AXI first,
+ *  read the compiler error, then fix it.
+ * 
+ * ============================================================================ */
+
+/* ✏️ YOUR TURN: Which region can the BDMA reach (and is not backup)? */
+DMA_BUFFER(BDMA, ???) uint16_t adc3_samples[64];    /* HINT: SRAM4 */
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * DMA_BUFFER(BDMA, D3) uint16_t adc3_samples[64];
+ * 
+ * SRAM4 is also the natural place for data that D3 keeps alive while D1
+ * and D2 are powered down (the Stop/Standby tutorials).
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Time-critical code in ITCM: no flash wait states, no cache misses */
+ITCM_CODE uint32_t Filter_Step(uint32_t sample) {
+    uint32_t sum = 0;
+
+    for (int i = 63; i > 0; i--) {
+        filter_state[i] = filter_state[i - 1];
+        sum += filter_state[i];
+    }
+    filter_state[0] = sample;
+    return (sum + sample) / 64U;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 4: THE SAME CHECK AT RUN TIME
+ *  =====================================
+ * 
+ *  Drivers get pointers from callers - a driver cannot know where they
+ *  point at compile time. So every DMA start asks the region table first
+ *  and refuses instead of starting a transfer that will fail (or worse,
+ *  half-work). The same table prints the map report.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    const char *name;
+    uint32_t id;                        /* REGION_... */
+    uint32_t base;
+    uint32_t size;
+    const uint8_t *used_start;          /* From the linker script, both 0 if */
+    const uint8_t *used_end;            /* absent - ITCM starts AT 0, though */
+} MemRegion_t;
+
+const MemRegion_t mem_regions[] = {
+    { "ITCM    ", REGION_ITCM,   0x00000000UL, 64U * 1024U,   __itcm_used_start__,   __itcm_used_end__ },
+    { "DTCM    ", REGION_DTCM,   0x20000000UL, 128U * 1024U,  __dtcm_used_start__,   __dtcm_used_end__ },
+    { "AXI SRAM", REGION_AXI,    0x24000000UL, 512U * 1024U,  __axi_used_start__,    __axi_used_end__ },
+    { "SRAM1-3 ", REGION_D2,     0x30000000UL, 288U * 1024U,  __d2_used_start__,     __d2_used_end__ },
+    { "SRAM4   ", REGION_D3,     0x38000000UL, 64U * 1024U,   __d3_used_start__,     __d3_used_end__ },
+    { "Backup  ", REGION_BACKUP, 0x38800000UL, 4U * 1024U,    __backup_used_start__, __backup_used_end__ },
+    { "Flash   ", REGION_FLASH,  0x08000000UL, 2048U * 1024U, NULL,                  NULL },
+};
+#define MEM_REGION_COUNT        (sizeof(mem_regions) / sizeof(mem_regions[0]))
+
+typedef struct {
+    const char *name;
+    uint32_t reach;                     /* REACH_... */
+} BusMaster_t;
+
+const BusMaster_t bus_masters[] = {
+    { "CPU", REACH_CPU }, { "MDMA", REACH_MDMA }, { "DMA1/2", REACH_DMA },
+    { "BDMA", REACH_BDMA }, { "ETH", REACH_ETH },
+};
+#define BUS_MASTER_COUNT        (sizeof(bus_masters) / sizeof(bus_masters[0]))
+
+/* The region that holds [addr, addr + len), or NULL (also when it spans two) */
+const MemRegion_t *Memory_FindRegion(const void *addr, uint32_t len) {
+    uint32_t start = (uint32_t)addr;
+
+    for (uint32_t i = 0; i < MEM_REGION_COUNT; i++) {
+        const MemRegion_t *r = &mem_regions[i];
+        if (start >= r->base && len <= r->size && start - r->base <= r->size - len) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: MAY THIS MASTER USE THIS BUFFER?
+ *  =================================================
+ * 
+ * ============================================================================ */
+
+volatile uint32_t dma_placement_errors = 0;
+
+int Memory_DmaCanReach(uint32_t reach, const void *addr, uint32_t len) {
+    const MemRegion_t *r = Memory_FindRegion(addr, len);
+
+    /* ✏️ YOUR TURN: Is the region in the master's mask? */
+    if (r == NULL || (reach & ???) == 0) {  /* HINT: The region's bit */
+        dma_placement_errors++;
+        return 0;
+    }
+    return 1;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (r == NULL || (reach & r->id) == 0) {
+ * 
+ * A buffer that is not inside ONE known region (a peripheral address, a
+ * buffer straddling the end of AXI SRAM) is refused as well.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Memory-to-memory copy on DMA1 stream 0 - refuses unreachable buffers.
+ * 0 = copied, -1 = refused or transfer error. */
+int DMA_Copy(const uint32_t *src, uint32_t *dst, uint32_t words) {
+    if (!Memory_DmaCanReach(REACH_DMA, src, words * 4U) ||
+        !Memory_DmaCanReach(REACH_DMA, dst, words * 4U)) {
+        return -1;
+    }
+
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    (void)RCC->AHB1ENR;
+
+    DMA1_S0->CR &= ~DMA_CR_EN;
+    while (DMA1_S0->CR & DMA_CR_EN);
+    DMA1->LIFCR = DMA_S0_FLAGS_ALL;
+
+    DMA1_S0->PAR = (uint32_t)src;       /* M2M: PAR is the source */
+    DMA1_S0->M0AR = (uint32_t)dst;
+    DMA1_S0->NDTR = words;
+    DMA1_S0->FCR = DMA_FCR_DMDIS | DMA_FCR_FTH_FULL;
+    DMA1_S0->CR = DMA_CR_DIR_M2M | DMA_CR_PINC | DMA_CR_MINC |
+                  DMA_CR_PSIZE_32 | DMA_CR_MSIZE_32;
+    DMA1_S0->CR |= DMA_CR_EN;
+
+    while (!(DMA1->LISR & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0)));
+    return (DMA1->LISR & DMA_LISR_TEIF0) ? -1 : 0;
+}
+
+/* ============================================================================
+ *  UART OUTPUT (polled, for the map report)
+ * ============================================================================ */
+
+void UART_Init(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIODEN;
+    RCC->APB1LENR |= RCC_APB1LENR_USART3EN;
+    (void)RCC->APB1LENR;
+
+    /* PD8 = USART3_TX, AF7 */
+    GPIOD->MODER &= ~(3U << (8 * 2));
+    GPIOD->MODER |= (2U << (8 * 2));
+    GPIOD->AFR[1] &= ~(0xFU << ((8 - 8) * 4));
+    GPIOD->AFR[1] |= (GPIO_AF7_USART3 << ((8 - 8) * 4));
+
+    USART3->CR1 = 0;
+    USART3->BRR = HSI_CLOCK / BAUD_RATE;
+    USART3->CR1 = USART_CR1_FIFOEN | USART_CR1_TE;
+    USART3->CR1 |= USART_CR1_UE;
+}
+
+void UART_SendChar(char c) {
+    while (!(USART3->ISR & USART_ISR_TXE_TXFNF));
+    USART3->TDR = (uint8_t)c;
+}
+
+void UART_SendString(const char *s) {
+    while (*s) {
+        UART_SendChar(*s++);
+    }
+}
+
+void UART_SendHex32(uint32_t value) {
+    UART_SendString("0x");
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        UART_SendChar("0123456789ABCDEF"[(value >> shift) & 0xFU]);
+    }
+}
+
+void UART_SendDec(uint32_t value, uint32_t width) {
+    char buf[10];
+    uint32_t n = 0;
+
+    do {
+        buf[n++] = (char)('0' + value % 10U);
+        value /= 10U;
+    } while (value > 0 && n < sizeof(buf));
+    while (width-- > n) {
+        UART_SendChar(' ');
+    }
+    while (n > 0) {
+        UART_SendChar(buf[--n]);
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: THE MAP REPORT
+ *  ===============================
+ * 
+ *  One line per region, then one per DMA buffer:
+ * 
+ *      region    base        used/size KB  reached by
+ *      AXI SRAM  0x24000000     1/512      CPU MDMA DMA1/2 ETH
+ *      ...
+ *      dest_buffer        0x30000000  SRAM1-3   DMA1/2 ok
+ *      adc3_samples       0x38000000  SRAM4     BDMA ok
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    const char *name;
+    const void *addr;
+    uint32_t size;
+    uint32_t master;                    /* Index into bus_masters */
+} DmaBufferInfo_t;
+
+const DmaBufferInfo_t dma_buffers[] = {
+    { "source_buffer     ", source_buffer,      sizeof(source_buffer),      2 },
+    { "dest_buffer       ", dest_buffer,        sizeof(dest_buffer),        2 },
+    { "eth_rx_descriptors", eth_rx_descriptors, sizeof(eth_rx_descriptors), 4 },
+    { "eth_rx_buffers    ", eth_rx_buffers,     sizeof(eth_rx_buffers),     4 },
+    { "adc3_samples      ", adc3_samples,       sizeof(adc3_samples),       3 },
+};
+#define DMA_BUFFER_COUNT        (sizeof(dma_buffers) / sizeof(dma_buffers[0]))
+
+void Memory_ReportMap(void) {
+    UART_SendString("\r\nregion    base        used/size KB  reached by\r\n");
+
+    for (uint32_t i = 0; i < MEM_REGION_COUNT; i++) {
+        const MemRegion_t *r = &mem_regions[i];
+        uint32_t used = (uint32_t)(r->used_end - r->used_start);
+
+        UART_SendString(r->name);
+        UART_SendString("  ");
+        UART_SendHex32(r->base);
+        UART_SendString("  ");
+        /* Not used_start != NULL: ITCM's first function sits at 0 */
+        if (r->used_end != r->used_start) {
+            UART_SendDec((used + 1023U) / 1024U, 4);
+        } else {
+            UART_SendString("   -");
+        }
+        UART_SendChar('/');
+        UART_SendDec(r->size / 1024U, 4);
+        UART_SendString("     ");
+
+        for (uint32_t m = 0; m < BUS_MASTER_COUNT; m++) {
+            /* ✏️ YOUR TURN: List the masters whose mask has this region */
+            if (bus_masters[m].reach & ???) {   /* HINT: Same test as EXERCISE 3 */
+                UART_SendString(bus_masters[m].name);
+                UART_SendChar(' ');
+            }
+        }
+        UART_SendString("\r\n");
+    }
+
+    UART_SendString("\r\nDMA buffer          address     region    master\r\n");
+    for (uint32_t i = 0; i < DMA_BUFFER_COUNT; i++) {
+        const DmaBufferInfo_t *b = &dma_buffers[i];
+        const MemRegion_t *r = Memory_FindRegion(b->addr, b->size);
+        const BusMaster_t *m = &bus_masters[b->master];
+
+        UART_SendString(b->name);
+        UART_SendString("  ");
+        UART_SendHex32((uint32_t)b->addr);
+        UART_SendString("  ");
+        UART_SendString(r != NULL ? r->name : "unknown ");
+        UART_SendString("  ");
+        UART_SendString(m->name);
+        UART_SendString(Memory_DmaCanReach(m->reach, b->addr, b->size) ? " ok\r\n" : " UNREACHABLE\r\n");
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (bus_masters[m].reach & r->id) {
+ * 
+ * "used" comes from the __*_used_* symbols of the linker script. Without
+ * the script every placed buffer lands in one default RAM - and the
+ * report shows exactly which ones are then out of reach.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Initialise the regions, print the map, copy with DMA
+ * 
+ * ============================================================================ */
+
+volatile uint8_t dma_copy_ok = 0;
+volatile int dtcm_copy_result = 0;
+
+int main(void)
+{
+    Memory_InitRegions();
+    reset_count++;                      /* Backup SRAM: counts every reset */
+
+    UART_Init();
+    Memory_ReportMap();
+
+    /* AXI SRAM → SRAM1: both reachable, the copy works */
+    if (DMA_Copy(source_buffer, dest_buffer, 16) == 0) {
+        dma_copy_ok = 1;
+        for (int i = 0; i < 16; i++) {
+            if (dest_buffer[i] != source_buffer[i]) {
+                dma_copy_ok = 0;
+            }
+        }
+    }
+
+    /* DTCM → refused before the DMA is even touched (-1) */
+    dtcm_copy_result = DMA_Copy(filter_state, dest_buffer, 16);
+
+    for (;;) {
+        Filter_Step(dest_buffer[0]);
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've taken control of the H7's memory map without HAL:
+ * 
+ *  ✅ Seven regions, five bus masters, and who can reach what
+ *  ✅ PLACE() / PLACE_INIT() / ITCM_CODE section attributes
+ *  ✅ A linker script with .data / .bss per region and init tables
+ *  ✅ DMA_BUFFER(): wrong placement is a compile error
+ *  ✅ Memory_DmaCanReach(): the same check for run-time pointers
+ *  ✅ A map report with usage per region and every DMA buffer
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Change dest_buffer to PLACE(DTCM) without the check and watch DMA1
+ *    set TEIF
+ *  • Time DMA_Copy() AXI → AXI against SRAM1 → SRAM2 with the D-cache
+ *    busy on AXI SRAM
+ *  • Put the SPI DMA tutorial's buffers behind DMA_BUFFER(DMA, D2)
+ *  • Move Filter_Step() out of ITCM and compare DWT_CYCCNT per call
+ * 
+ * ============================================================================ */
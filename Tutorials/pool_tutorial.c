@@ -0,0 +1,753 @@
+/**
+ ******************************************************************************
+ * @file           : pool_tutorial.c
+ * @brief          : Learning fixed-size block pools without malloc
+ ******************************************************************************
+ * 
+ *  ██████╗  ██████╗  ██████╗ ██╗     
+ *  ██╔══██╗██╔═══██╗██╔═══██╗██║     
+ *  ██████╔╝██║   ██║██║   ██║██║     
+ *  ██╔═══╝ ██║   ██║██║   ██║██║     
+ *  ██║     ╚██████╔╝╚██████╔╝███████╗
+ *  ╚═╝      ╚═════╝  ╚═════╝ ╚══════╝
+ * 
+ *  INTERACTIVE LEARNING: BUFFERS THAT MOVE, NOT BYTES THAT ARE COPIED
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. Why embedded code avoids malloc() - and what to use instead
+ *  2. How a pool of equal blocks gives O(1) alloc and free
+ *  3. How to alloc and free from main AND interrupts with LDREX/STREX
+ *  4. How to place each pool in the RAM that suits it (DTCM, AXI SRAM)
+ *  5. How high-water marks tell you how big a pool really needs to be
+ *  6. How guard words and fill patterns catch overruns, double frees and
+ *     use-after-free while debugging
+ * 
+ *  PREREQUISITES:
+ *  - Complete the NVIC tutorial (interrupt priorities, preemption)
+ *  - The LDREX/STREX lesson from the logging tutorial
+ * 
+ *  HARDWARE:
+ *  - Nucleo-H753ZI only - TIM6 plays the part of a sampling interrupt
+ *  - Watch pool_* statistics in the debugger
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐ (Advanced)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: WHO OWNS THIS BUFFER?
+ *  ================================
+ * 
+ *  So far every buffer in these tutorials is a static array with ONE
+ *  owner: RxBuffer[4][1536] belongs to the Ethernet driver, rx_buffer to
+ *  the UART. To hand a received packet to the main loop the data must be
+ *  COPIED out before the driver reuses the slot.
+ * 
+ *  malloc() would let the driver give the buffer away instead, but:
+ *  • its time is unbounded (it searches a free list)
+ *  • after hours of mixed sizes the heap fragments: 20 KB free, but no
+ *    single 1.5 KB hole left
+ *  • it is not safe to call from an interrupt
+ * 
+ *  A POOL is an array of N blocks of ONE size:
+ * 
+ *      ┌──────┬──────┬──────┬──────┬──────┬──────┐
+ *      │  0   │  1   │  2   │  3   │  4   │  5   │   256 bytes each
+ *      └──────┴──────┴──────┴──────┴──────┴──────┘
+ *      free list: 4 → 1 → 5 → end
+ * 
+ *  Alloc = take the first block of the free list. Free = put it back
+ *  in front. Both O(1), no fragmentation possible, and a buffer can be
+ *  passed from interrupt to main loop to driver without one byte being
+ *  copied - only the pointer moves ("zero-copy").
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define TIM6_BASE       0x40001000UL
+
+#define NVIC_ISER_BASE  0xE000E100UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+} TIM_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define TIM6        ((TIM_TypeDef *) TIM6_BASE)
+
+#define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_APB1LENR_TIM6EN     (1U << 4)
+
+/* TIM */
+#define TIM_CR1_CEN             (1U << 0)
+#define TIM_DIER_UIE            (1U << 0)
+#define TIM_SR_UIF              (1U << 0)
+#define TIM_EGR_UG              (1U << 0)
+
+/* NVIC */
+#define TIM6_DAC_IRQn           54
+
+/* ============================================================================
+ * 
+ *  LESSON 1: A POOL IN MEMORY
+ *  ===========================
+ * 
+ *  Two arrays per pool:
+ * 
+ *  • BLOCKS - the memory handed out. Each block is rounded up to 32
+ *    bytes (one cache line), so a block can be given to DMA and cleaned
+ *    or invalidated without touching its neighbour.
+ * 
+ *  • META - one word per block, kept OUTSIDE the blocks so the user can
+ *    overwrite every byte of a block without breaking the list:
+ *        free block  → index of the next free block (POOL_END = last)
+ *        used block  → POOL_META_USED
+ * 
+ *  The head of the free list is a single word - which is what makes
+ *  lock-free alloc/free possible.
+ * 
+ *  DEBUG GUARDS (POOL_DEBUG = 1):
+ *  • the word right after the user's size is a GUARD; a write past the
+ *    end changes it and Pool_Free() reports an overrun
+ *  • free blocks are filled with 0xDD; Pool_Alloc() checks the fill and
+ *    reports a use-after-free if someone wrote to a block after freeing
+ *  • freeing a block that is not in use is reported as a double free
+ *  They cost time proportional to the block size - turn them off in a
+ *  release build.
+ * 
+ * ============================================================================ */
+
+#define POOL_DEBUG              1
+
+#define POOL_END                0xFFFFFFFFU     /* End of the free list */
+#define POOL_META_USED          0xA110CA7EU     /* "ALLOCATE" */
+#define POOL_GUARD              0xB10CB10CU     /* "BLOCBLOC" */
+#define POOL_FILL               0xDDDDDDDDU
+#define POOL_ALIGN              32U             /* Cache line */
+
+#if POOL_DEBUG
+#define POOL_GUARD_BYTES        4U
+#else
+#define POOL_GUARD_BYTES        0U
+#endif
+
+/* Bytes per block: the user's size + guard, rounded up to a cache line */
+#define POOL_STRIDE(size)       ((((size) + POOL_GUARD_BYTES) + POOL_ALIGN - 1U) & ~(POOL_ALIGN - 1U))
+
+typedef struct {
+    const char *name;
+    uint8_t *blocks;
+    uint32_t *meta;
+    uint32_t size;                      /* Bytes the user may use */
+    uint32_t stride;                    /* Bytes between blocks */
+    uint32_t count;
+    volatile uint32_t free_head;        /* Index, or POOL_END */
+
+    /* Statistics - read them any time */
+    volatile uint32_t in_use;
+    volatile uint32_t high_water;       /* Most blocks ever in use at once */
+    volatile uint32_t failures;         /* Alloc found the pool empty */
+    volatile uint32_t bad_frees;        /* Double free or foreign pointer */
+    volatile uint32_t overruns;         /* Guard word damaged */
+    volatile uint32_t stale_writes;     /* Fill pattern damaged (use after free) */
+} Pool_t;
+
+/* ============================================================================
+ * 
+ *  LESSON 2: CHOOSING THE RAM
+ *  ===========================
+ * 
+ *  ┌────────────┬─────────────┬───────────────────────────────────────┐
+ *  │ Region     │ Address     │ Good for                              │
+ *  ├────────────┼─────────────┼───────────────────────────────────────┤
+ *  │ DTCM       │ 0x20000000  │ CPU-only data: messages, samples      │
+ *  │            │ 128 KB      │ zero wait states, but NO DMA1/DMA2    │
+ *  │ AXI SRAM   │ 0x24000000  │ DMA buffers: Ethernet, SPI, UART      │
+ *  │            │ 512 KB      │                                       │
+ *  │ SRAM1-3    │ 0x30000000  │ DMA buffers of the D2 peripherals     │
+ *  └────────────┴─────────────┴───────────────────────────────────────┘
+ * 
+ *  A section attribute picks the region - add matching lines to the
+ *  linker script (NOLOAD: pools need no initial values):
+ * 
+ *      .dtcm_pool (NOLOAD) : { *(.dtcm_pool*) } > DTCMRAM
+ *      .axi_pool  (NOLOAD) : { *(.axi_pool*)  } > RAM_D1
+ * 
+ * ============================================================================ */
+
+#define POOL_SECTION(name)      __attribute__((section(name), aligned(POOL_ALIGN)))
+
+/* Sample blocks: filled by TIM6, processed by main - CPU only → DTCM */
+#define SAMPLES_PER_BLOCK       64
+#define SAMPLE_POOL_SIZE        (SAMPLES_PER_BLOCK * sizeof(uint16_t))
+#define SAMPLE_POOL_COUNT       8
+
+/* Packet blocks: Ethernet-sized, DMA reachable → AXI SRAM */
+#define PACKET_POOL_SIZE        1536U
+#define PACKET_POOL_COUNT       6
+
+/* Small messages */
+#define MSG_POOL_SIZE           32U
+#define MSG_POOL_COUNT          16
+
+uint8_t sample_blocks[SAMPLE_POOL_COUNT * POOL_STRIDE(SAMPLE_POOL_SIZE)] POOL_SECTION(".dtcm_pool");
+uint8_t packet_blocks[PACKET_POOL_COUNT * POOL_STRIDE(PACKET_POOL_SIZE)] POOL_SECTION(".axi_pool");
+uint8_t msg_blocks[MSG_POOL_COUNT * POOL_STRIDE(MSG_POOL_SIZE)] POOL_SECTION(".dtcm_pool");
+
+uint32_t sample_meta[SAMPLE_POOL_COUNT];
+uint32_t packet_meta[PACKET_POOL_COUNT];
+uint32_t msg_meta[MSG_POOL_COUNT];
+
+Pool_t sample_pool;
+Pool_t packet_pool;
+Pool_t msg_pool;
+
+/* Every pool, for Pool_FreeAny() */
+Pool_t *const pool_list[] = { &sample_pool, &packet_pool, &msg_pool };
+#define POOL_LIST_COUNT         (sizeof(pool_list) / sizeof(pool_list[0]))
+
+/* ============================================================================
+ *  ATOMIC HELPERS (see the logging tutorial)
+ *  Every exception entry/exit clears the exclusive monitor, so if an
+ *  interrupt ran between LDREX and STREX, the STREX fails and we retry.
+ * ============================================================================ */
+
+static inline uint32_t LDREX(volatile uint32_t *addr) {
+    uint32_t value;
+    __asm volatile ("ldrex %0, [%1]" : "=r" (value) : "r" (addr) : "memory");
+    return value;
+}
+
+/* Returns 0 when the store happened */
+static inline uint32_t STREX(uint32_t value, volatile uint32_t *addr) {
+    uint32_t failed;
+    __asm volatile ("strex %0, %2, [%1]" : "=&r" (failed) : "r" (addr), "r" (value) : "memory");
+    return failed;
+}
+
+static inline void CLREX(void) {
+    __asm volatile ("clrex" ::: "memory");
+}
+
+/* *addr += delta from any context; returns the new value */
+uint32_t Atomic_Add(volatile uint32_t *addr, uint32_t delta) {
+    uint32_t n;
+    do {
+        n = LDREX(addr) + delta;
+    } while (STREX(n, addr));
+    return n;
+}
+
+/* *addr = max(*addr, value) from any context */
+void Atomic_Max(volatile uint32_t *addr, uint32_t value) {
+    uint32_t old;
+    do {
+        old = LDREX(addr);
+        if (value <= old) {
+            CLREX();
+            return;
+        }
+    } while (STREX(value, addr));
+}
+
+/* ============================================================================
+ *  POOL SETUP
+ * ============================================================================ */
+
+#if POOL_DEBUG
+/* The guard sits right behind the user's bytes, not at the end of the stride */
+static inline uint32_t *Pool_Guard(const Pool_t *pool, void *block) {
+    return (uint32_t *)((uint8_t *)block + ((pool->size + 3U) & ~3U));
+}
+#endif
+
+void Pool_Init(Pool_t *pool, const char *name, uint8_t *blocks, uint32_t *meta,
+               uint32_t size, uint32_t count) {
+    pool->name = name;
+    pool->blocks = blocks;
+    pool->meta = meta;
+    pool->size = size;
+    pool->stride = POOL_STRIDE(size);
+    pool->count = count;
+
+    /* Chain every block: 0 → 1 → ... → count-1 → end */
+    for (uint32_t i = 0; i < count; i++) {
+        meta[i] = (i + 1U < count) ? i + 1U : POOL_END;
+#if POOL_DEBUG
+        uint32_t *word = (uint32_t *)(blocks + i * pool->stride);
+        for (uint32_t w = 0; w < pool->stride / 4U; w++) {
+            word[w] = POOL_FILL;
+        }
+#endif
+    }
+    pool->free_head = (count > 0) ? 0U : POOL_END;
+
+    pool->in_use = 0;
+    pool->high_water = 0;
+    pool->failures = 0;
+    pool->bad_frees = 0;
+    pool->overruns = 0;
+    pool->stale_writes = 0;
+}
+
+void Pools_Init(void) {
+    Pool_Init(&sample_pool, "samples", sample_blocks, sample_meta,
+              SAMPLE_POOL_SIZE, SAMPLE_POOL_COUNT);
+    Pool_Init(&packet_pool, "packets", packet_blocks, packet_meta,
+              PACKET_POOL_SIZE, PACKET_POOL_COUNT);
+    Pool_Init(&msg_pool, "messages", msg_blocks, msg_meta,
+              MSG_POOL_SIZE, MSG_POOL_COUNT);
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 3: POP AND PUSH WITHOUT A LOCK
+ *  ======================================
+ * 
+ *  ALLOC (pop):                        FREE (push):
+ *      head = LDREX(free_head)             head = LDREX(free_head)
+ *      next = meta[head]                   meta[i] = head
+ *      STREX(next → free_head)             STREX(i → free_head)
+ *      failed? start over                  failed? start over
+ * 
+ *  Suppose main is between LDREX and STREX of an alloc and TIM6 fires,
+ *  allocates block 4 and frees block 2. When main resumes, its "next" is
+ *  stale - but the exception cleared the monitor, so its STREX fails and
+ *  it reads the list again. On a multi-core chip the same code would need
+ *  an ABA counter next to the index; on one core the monitor is enough.
+ * 
+ *  The other way to do it is cpsid i / cpsie i around the four lines -
+ *  also correct, but it delays every interrupt by the length of the
+ *  section, including ones that never touch a pool.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: TAKE A BLOCK
+ *  =============================
+ * 
+ * ============================================================================ */
+
+void *Pool_Alloc(Pool_t *pool) {
+    uint32_t head, next;
+    uint8_t *block;
+
+    do {
+        head = LDREX(&pool->free_head);
+        if (head == POOL_END) {
+            CLREX();
+            Atomic_Add(&pool->failures, 1U);
+            return NULL;
+        }
+        next = pool->meta[head];
+
+        /* ✏️ YOUR TURN: Make the next block the new head, retry if interrupted */
+    } while (STREX(???, &pool->free_head));     /* HINT: What comes after head? */
+
+    /* The block is ours alone from here on */
+    pool->meta[head] = POOL_META_USED;
+    Atomic_Max(&pool->high_water, Atomic_Add(&pool->in_use, 1U));
+
+    block = pool->blocks + head * pool->stride;
+
+#if POOL_DEBUG
+    {
+        uint32_t *word = (uint32_t *)block;
+        for (uint32_t w = 0; w < pool->stride / 4U; w++) {
+            if (word[w] != POOL_FILL) {
+                Atomic_Add(&pool->stale_writes, 1U);
+                break;
+            }
+        }
+        *Pool_Guard(pool, block) = POOL_GUARD;
+    }
+#endif
+
+    return block;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * } while (STREX(next, &pool->free_head));
+ * 
+ * WHY READ meta[head] INSIDE THE LOOP? Another context may take "head"
+ * and change its meta word. After a retry head may be a different block,
+ * so its successor must be read again too.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Block index of ptr, or POOL_END if ptr is not the start of a block */
+uint32_t Pool_IndexOf(const Pool_t *pool, const void *ptr) {
+    uint32_t offset = (uint32_t)((const uint8_t *)ptr - pool->blocks);
+
+    if ((const uint8_t *)ptr < pool->blocks ||
+        offset >= pool->count * pool->stride ||
+        (offset % pool->stride) != 0) {
+        return POOL_END;
+    }
+    return offset / pool->stride;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: GIVE IT BACK
+ *  =============================
+ * 
+ * ============================================================================ */
+
+/* 0 = freed, -1 = not a block of this pool, or not in use */
+int Pool_Free(Pool_t *pool, void *ptr) {
+    uint32_t index = Pool_IndexOf(pool, ptr);
+    uint32_t head;
+
+    if (index == POOL_END || pool->meta[index] != POOL_META_USED) {
+        Atomic_Add(&pool->bad_frees, 1U);
+        return -1;
+    }
+
+#if POOL_DEBUG
+    {
+        uint32_t *word = (uint32_t *)ptr;
+        if (*Pool_Guard(pool, ptr) != POOL_GUARD) {
+            Atomic_Add(&pool->overruns, 1U);
+        }
+        for (uint32_t w = 0; w < pool->stride / 4U; w++) {
+            word[w] = POOL_FILL;
+        }
+    }
+#endif
+
+    do {
+        head = LDREX(&pool->free_head);
+
+        /* ✏️ YOUR TURN: Link this block in front of the current list */
+        pool->meta[index] = ???;        /* HINT: Who is first right now? */
+    } while (STREX(index, &pool->free_head));
+
+    Atomic_Add(&pool->in_use, 0U - 1U);
+    return 0;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * pool->meta[index] = head;
+ * 
+ * The meta word is written before STREX publishes the index, so anyone
+ * who sees the new head also sees a valid "next". On the M7 a plain
+ * store to another address does not clear the monitor.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Free without knowing the pool - for buffers that have travelled */
+int Pool_FreeAny(void *ptr) {
+    for (uint32_t i = 0; i < POOL_LIST_COUNT; i++) {
+        if (Pool_IndexOf(pool_list[i], ptr) != POOL_END) {
+            return Pool_Free(pool_list[i], ptr);
+        }
+    }
+    return -1;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 4: ZERO-COPY HANDOFF
+ *  ============================
+ * 
+ *  TIM6 (1 kHz) writes one sample per tick into the block it owns. When
+ *  the block is full it puts the POINTER into a mailbox and allocates the
+ *  next one. Main takes pointers out, processes the block, frees it:
+ * 
+ *      TIM6:  alloc ─► fill 64 samples ─► mailbox ─┐
+ *                ▲                                 │
+ *                └──── free ◄── process ◄── main ◄─┘
+ * 
+ *  The mailbox has exactly one writer (TIM6) and one reader (main), so a
+ *  plain ring with a DMB is enough. It holds as many pointers as there
+ *  are blocks, so it can never overflow.
+ * 
+ *  If main falls behind, the pool runs dry: TIM6 counts a failure and
+ *  drops samples until a block is free again. The high-water mark shows
+ *  how close you came - size the pool from it, not from a guess.
+ * 
+ * ============================================================================ */
+
+#define MAILBOX_SIZE            SAMPLE_POOL_COUNT
+
+uint16_t *volatile mailbox[MAILBOX_SIZE];
+volatile uint32_t mailbox_head = 0;     /* Written by TIM6 only */
+volatile uint32_t mailbox_tail = 0;     /* Written by main only */
+
+uint16_t *tim6_block = NULL;            /* Block TIM6 is filling */
+uint32_t tim6_fill = 0;
+volatile uint32_t samples_dropped = 0;
+volatile uint32_t blocks_processed = 0;
+volatile uint32_t last_block_average = 0;
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: THE PRODUCER
+ *  =============================
+ * 
+ * ============================================================================ */
+
+void TIM6_DAC_IRQHandler(void) {
+    static uint16_t sample = 0;
+
+    if (!(TIM6->SR & TIM_SR_UIF)) {
+        return;
+    }
+    TIM6->SR = ~TIM_SR_UIF;
+
+    if (tim6_block == NULL) {
+        tim6_block = Pool_Alloc(&sample_pool);
+        if (tim6_block == NULL) {
+            samples_dropped++;          /* Main is behind */
+            return;
+        }
+        tim6_fill = 0;
+    }
+
+    tim6_block[tim6_fill++] = sample++ & 0x0FFFU;   /* Stand-in for an ADC reading */
+
+    if (tim6_fill == SAMPLES_PER_BLOCK) {
+        mailbox[mailbox_head % MAILBOX_SIZE] = tim6_block;
+        __asm volatile ("dmb" ::: "memory");
+
+        /* ✏️ YOUR TURN: Publish the pointer, then forget the block */
+        mailbox_head = ???;             /* HINT: One more entry */
+        tim6_block = NULL;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * mailbox_head = mailbox_head + 1;
+ * 
+ * After this line the block belongs to main. TIM6 must not touch it
+ * again - setting tim6_block = NULL makes that impossible by accident.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void Tick_Start(void) {
+    RCC->APB1LENR |= RCC_APB1LENR_TIM6EN;
+    (void)RCC->APB1LENR;
+
+    TIM6->PSC = 63;                     /* 64 MHz / 64 = 1 MHz */
+    TIM6->ARR = 999;                    /* 1 ms */
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->SR = 0;
+    TIM6->DIER |= TIM_DIER_UIE;
+    TIM6->CR1 |= TIM_CR1_CEN;
+
+    NVIC_ISER[TIM6_DAC_IRQn / 32] = (1U << (TIM6_DAC_IRQn % 32));
+}
+
+/* The consumer: one block per call, 0 if the mailbox was empty */
+int Samples_ProcessOne(void) {
+    uint16_t *block;
+    uint32_t sum = 0;
+
+    if (mailbox_tail == mailbox_head) {
+        return 0;
+    }
+    __asm volatile ("dmb" ::: "memory");
+    block = mailbox[mailbox_tail % MAILBOX_SIZE];
+    mailbox_tail++;
+
+    for (uint32_t i = 0; i < SAMPLES_PER_BLOCK; i++) {
+        sum += block[i];
+    }
+    last_block_average = sum / SAMPLES_PER_BLOCK;
+    blocks_processed++;
+
+    Pool_FreeAny(block);                /* Travelled from TIM6 - pool looked up */
+    return 1;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: TRIP THE GUARDS
+ *  ================================
+ * 
+ *  Make each mistake once on purpose and check the counter that moves.
+ * 
+ * ============================================================================ */
+
+void Pools_GuardDemo(void) {
+    uint8_t *msg = Pool_Alloc(&msg_pool);
+
+    if (msg == NULL) {
+        return;
+    }
+
+    /* One byte too far: the user owns msg[0..31] */
+    msg[MSG_POOL_SIZE] = 0x55;
+    Pool_Free(&msg_pool, msg);          /* → msg_pool.overruns */
+
+    /* Freed twice */
+    Pool_Free(&msg_pool, msg);          /* → msg_pool.bad_frees */
+
+    /* ✏️ YOUR TURN: Write to the block after freeing it, then allocate */
+    msg[0] = ???;                       /* HINT: Any value but 0xDD */
+    msg = Pool_Alloc(&msg_pool);        /* → msg_pool.stale_writes */
+    Pool_Free(&msg_pool, msg);
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * msg[0] = 0x42;
+ * 
+ * The free list is LIFO: the block freed last is the next one handed
+ * out, so the stale write is found on the very next alloc. Without
+ * POOL_DEBUG all three mistakes go unnoticed - and corrupt a message
+ * minutes later somewhere else.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - TIM6 fills sample blocks, main drains them
+ * 
+ * ============================================================================ */
+
+int main(void)
+{
+    uint8_t *packet;
+
+    Pools_Init();
+    Pools_GuardDemo();
+
+    /* A DMA-ready buffer: 32-byte aligned, in AXI SRAM */
+    packet = Pool_Alloc(&packet_pool);
+    if (packet != NULL) {
+        packet[0] = 0xFF;               /* Would be handed to the ETH TX descriptor */
+        Pool_Free(&packet_pool, packet);
+    }
+
+    Tick_Start();
+
+    for (;;) {
+        /* Process everything waiting, then sleep until the next tick */
+        while (Samples_ProcessOne()) {
+        }
+        __asm volatile ("wfi");
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've built a block pool allocator without HAL:
+ * 
+ *  ✅ Equal-size blocks: O(1) alloc and free, no fragmentation
+ *  ✅ Free list metadata kept outside the blocks
+ *  ✅ Lock-free pop and push with LDREX/STREX - safe from any interrupt
+ *  ✅ Pools placed in DTCM or AXI SRAM with section attributes
+ *  ✅ In-use, high-water and failure counters per pool
+ *  ✅ Guard words and fill patterns for overruns, double and stale frees
+ *  ✅ A zero-copy mailbox from TIM6 to the main loop
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Add a busy loop in Samples_ProcessOne() and watch high_water reach
+ *    SAMPLE_POOL_COUNT, then failures and samples_dropped climb
+ *  • Give the Ethernet tutorial's RX descriptors buffers from packet_pool
+ *    and pass received frames to the main loop without memcpy
+ *  • Time Pool_Alloc() with DWT_CYCCNT with POOL_DEBUG = 1 and = 0
+ *  • Replace the LDREX/STREX loops with cpsid/cpsie and compare
+ * 
+ * ============================================================================ */
@@ -351,9 +351,46 @@ typedef struct {
  * 
  * ============================================================================ */
 
-/* Simple delay function */
-void delay(volatile uint32_t count) {
-    while (count--);
+/* ============================================================================
+ *  CALIBRATED DELAY
+ *  
+ *  Counts CPU cycles on the DWT counter. How many cycles make a
+ *  microsecond depends on SYSCLK - so cpu_clock_hz must follow every
+ *  clock switch, or every delay in the program is off by the same factor.
+ * ============================================================================ */
+
+uint32_t cpu_clock_hz = 64000000U;      /* HSI after reset */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* Started on demand. CYCCNT keeps counting across clock switches -
+     * only cpu_clock_hz, the cycles per µs, changes. */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (cpu_clock_hz / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
 }
 
 /* ============================================================================
@@ -368,13 +405,10 @@ void delay(volatile uint32_t count) {
  * ============================================================================ */
 
 void RCC_EnableGPIOClocks(void) {
-    /* ✏️ YOUR TURN: Enable GPIOB clock */
-    RCC->AHB4ENR |= ???;        /* HINT: Use the macro you defined for GPIOB clock enable */
+    /* ✏️ YOUR TURN: Enable GPIOB and GPIOE clocks in ONE read-modify-write */
+    RCC->AHB4ENR |= ??? | ???;  /* HINT: The macros you defined for GPIOB and GPIOE */
     
-    /* ✏️ YOUR TURN: Enable GPIOE clock */
-    RCC->AHB4ENR |= ???;        /* HINT: Use the macro you defined for GPIOE clock enable */
-    
-    /* Dummy read to ensure writes complete */
+    /* Dummy read to ensure the write completed */
     (void)RCC->AHB4ENR;
 }
 
@@ -382,10 +416,12 @@ void RCC_EnableGPIOClocks(void) {
  * 💡 SOLUTION:
  * 
  * void RCC_EnableGPIOClocks(void) {
- *     RCC->AHB4ENR |= RCC_AHB4ENR_GPIOBEN;
- *     RCC->AHB4ENR |= RCC_AHB4ENR_GPIOEEN;
+ *     RCC->AHB4ENR |= RCC_AHB4ENR_GPIOBEN | RCC_AHB4ENR_GPIOEEN;
  *     (void)RCC->AHB4ENR;
  * }
+ * 
+ * Each |= is a read, a modify and a write on the slow RCC bus. Two
+ * separate |= lines do it twice; combining the bits costs one.
  * ───────────────────────────────────────────────────────────────────────────── */
 
 /* ============================================================================
@@ -705,14 +741,15 @@ int main(void)
     /* ========================================================================
      * OPTIONAL: Switch to HSE (8 MHz external crystal)
      * 
-     * Uncomment to try HSE. The LEDs will blink SLOWER because
-     * we drop from 64 MHz to 8 MHz!
+     * Uncomment to try HSE. We drop from 64 MHz to 8 MHz, but the
+     * LEDs keep their rhythm because cpu_clock_hz follows the switch.
+     * Leave that line out and they blink 8× SLOWER!
      * ======================================================================== */
     
     /*
     if (RCC_EnableHSE() == 0) {
         RCC_SwitchToHSE();
-        // Now running at 8 MHz (slower!)
+        cpu_clock_hz = 8000000U;    // Now running at 8 MHz
     }
     */
     
@@ -728,19 +765,19 @@ int main(void)
         LED_GreenOn();
         LED_YellowOff();
         LED_RedOff();
-        delay(2000000);
+        delay_ms(200);
         
         /* YELLOW phase */
         LED_GreenOff();
         LED_YellowOn();
         LED_RedOff();
-        delay(1000000);
+        delay_ms(100);
         
         /* RED phase */
         LED_GreenOff();
         LED_YellowOff();
         LED_RedOn();
-        delay(2000000);
+        delay_ms(200);
     }
 }
 
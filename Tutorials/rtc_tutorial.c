@@ -30,6 +30,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 
 /* ============================================================================
  * 
@@ -157,29 +158,33 @@ typedef struct {
 typedef struct {
     volatile uint32_t TR;       /* 0x00 - Time register */
     volatile uint32_t DR;       /* 0x04 - Date register */
-    volatile uint32_t SSR;      /* 0x08 - Sub second register */
-    volatile uint32_t ICSR;     /* 0x0C - Initialization and status register */
+    volatile uint32_t CR;       /* 0x08 - Control register */
+    volatile uint32_t ISR;      /* 0x0C - Initialization and status register */
     volatile uint32_t PRER;     /* 0x10 - Prescaler register */
     volatile uint32_t WUTR;     /* 0x14 - Wakeup timer register */
-    volatile uint32_t CR;       /* 0x18 - Control register */
-    volatile uint32_t RESERVED1[2];
+    volatile uint32_t RESERVED0;
+    volatile uint32_t ALRMAR;   /* 0x1C - Alarm A register */
+    volatile uint32_t ALRMBR;   /* 0x20 - Alarm B register */
     volatile uint32_t WPR;      /* 0x24 - Write protection register */
-    volatile uint32_t CALR;     /* 0x28 - Calibration register */
+    volatile uint32_t SSR;      /* 0x28 - Sub second register */
     volatile uint32_t SHIFTR;   /* 0x2C - Shift control register */
     volatile uint32_t TSTR;     /* 0x30 - Time stamp time register */
     volatile uint32_t TSDR;     /* 0x34 - Time stamp date register */
     volatile uint32_t TSSSR;    /* 0x38 - Time stamp sub second register */
-    volatile uint32_t RESERVED2;
-    volatile uint32_t ALRMAR;   /* 0x40 - Alarm A register */
+    volatile uint32_t CALR;     /* 0x3C - Calibration register */
+    volatile uint32_t TAMPCR;   /* 0x40 - Tamper configuration register */
     volatile uint32_t ALRMASSR; /* 0x44 - Alarm A sub second register */
-    volatile uint32_t ALRMBR;   /* 0x48 - Alarm B register */
-    volatile uint32_t ALRMBSSR; /* 0x4C - Alarm B sub second register */
-    volatile uint32_t SR;       /* 0x50 - Status register */
-    volatile uint32_t MISR;     /* 0x54 - Masked interrupt status register */
-    volatile uint32_t RESERVED3;
-    volatile uint32_t SCR;      /* 0x5C - Status clear register */
+    volatile uint32_t ALRMBSSR; /* 0x48 - Alarm B sub second register */
+    volatile uint32_t OR;       /* 0x4C - Option register */
+    volatile uint32_t BKPR[32]; /* 0x50 - Backup registers (survive on VBAT) */
 } RTC_TypeDef;
 
+/* Offsets from RM0433 - a miscounted RESERVED word fails the build */
+_Static_assert(offsetof(RTC_TypeDef, ISR) == 0x0C, "RTC_ISR offset");
+_Static_assert(offsetof(RTC_TypeDef, ALRMAR) == 0x1C, "RTC_ALRMAR offset");
+_Static_assert(offsetof(RTC_TypeDef, WPR) == 0x24, "RTC_WPR offset");
+_Static_assert(offsetof(RTC_TypeDef, BKPR) == 0x50, "RTC_BKP0R offset");
+
 #define RTC     ((RTC_TypeDef *) RTC_BASE)
 
 /* ============================================================================
@@ -208,10 +213,10 @@ typedef struct {
 #define RTC_WPR_KEY1            0xCA
 #define RTC_WPR_KEY2            0x53
 
-/* RTC ICSR (Init and Status) */
-#define RTC_ICSR_INIT           (1U << 7)   /* Initialization mode */
-#define RTC_ICSR_INITF          (1U << 6)   /* Initialization flag */
-#define RTC_ICSR_RSF            (1U << 5)   /* Register sync flag */
+/* RTC ISR (Initialization and Status) */
+#define RTC_ISR_INIT            (1U << 7)   /* Initialization mode */
+#define RTC_ISR_INITF           (1U << 6)   /* Initialization flag */
+#define RTC_ISR_RSF             (1U << 5)   /* Register sync flag */
 
 /* RTC TR (Time Register) Bit Positions */
 #define RTC_TR_SU_POS           0           /* Seconds units */
@@ -338,7 +343,7 @@ typedef struct {
  *              ↓
  *              Write protection disabled
  *              
- *    Layer 3:  RTC->ICSR |= RTC_ICSR_INIT
+ *    Layer 3:  RTC->ISR |= RTC_ISR_INIT
  *              Wait for INITF flag
  *              ↓
  *              Can modify TR/DR registers!
@@ -508,23 +513,23 @@ void RTC_EnableWriteProtection(void) {
 
 void RTC_EnterInitMode(void) {
     /* ✏️ YOUR TURN: Set initialization mode bit */
-    RTC->ICSR |= ???;                      /* HINT: Which bit enters init mode? */
+    RTC->ISR |= ???;                       /* HINT: Which bit enters init mode? */
     
     /* ✏️ YOUR TURN: Wait for init flag */
-    while (!(RTC->ICSR & ???));            /* HINT: Which flag indicates init ready? */
+    while (!(RTC->ISR & ???));             /* HINT: Which flag indicates init ready? */
 }
 
 void RTC_ExitInitMode(void) {
     /* Clear init bit */
-    RTC->ICSR &= ~RTC_ICSR_INIT;
+    RTC->ISR &= ~RTC_ISR_INIT;
 }
 
 /* ─────────────────────────────────────────────────────────────────────────────
  * 💡 SOLUTION:
  * 
  * void RTC_EnterInitMode(void) {
- *     RTC->ICSR |= RTC_ICSR_INIT;
- *     while (!(RTC->ICSR & RTC_ICSR_INITF));
+ *     RTC->ISR |= RTC_ISR_INIT;
+ *     while (!(RTC->ISR & RTC_ISR_INITF));
  * }
  * ───────────────────────────────────────────────────────────────────────────── */
 
@@ -586,8 +591,8 @@ void RTC_GetTime(RTC_Time_t *time) {
     uint32_t tr;
     
     /* Wait for shadow registers to sync */
-    RTC->ICSR &= ~RTC_ICSR_RSF;
-    while (!(RTC->ICSR & RTC_ICSR_RSF));
+    RTC->ISR &= ~RTC_ISR_RSF;
+    while (!(RTC->ISR & RTC_ISR_RSF));
     
     /* ✏️ YOUR TURN: Read time register */
     tr = ???;                              /* HINT: Which register holds the current time? */
@@ -603,8 +608,8 @@ void RTC_GetTime(RTC_Time_t *time) {
  * 
  * void RTC_GetTime(RTC_Time_t *time) {
  *     uint32_t tr;
- *     RTC->ICSR &= ~RTC_ICSR_RSF;
- *     while (!(RTC->ICSR & RTC_ICSR_RSF));
+ *     RTC->ISR &= ~RTC_ISR_RSF;
+ *     while (!(RTC->ISR & RTC_ISR_RSF));
  *     tr = RTC->TR;
  *     time->hours = BcdToDec((tr >> 16) & 0x3F);
  *     time->minutes = BcdToDec((tr >> 8) & 0x7F);
@@ -647,8 +652,8 @@ void RTC_GetDate(RTC_Date_t *date) {
     uint32_t dr;
     
     /* Wait for shadow registers to sync */
-    RTC->ICSR &= ~RTC_ICSR_RSF;
-    while (!(RTC->ICSR & RTC_ICSR_RSF));
+    RTC->ISR &= ~RTC_ISR_RSF;
+    while (!(RTC->ISR & RTC_ISR_RSF));
     
     dr = RTC->DR;
     
@@ -686,11 +691,43 @@ void RTC_Init(void) {
 }
 
 /* ============================================================================
- *  HELPER: Simple delay
+ *  HELPER: Calibrated delay
+ *  Waits on the DWT cycle counter, so one second stays one second
+ *  whatever the compiler does with the loop.
  * ============================================================================ */
 
-void delay(volatile uint32_t count) {
-    while (count--);
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* The seconds demo is the only user - switch the counter on the
+     * first time through (LAR key needed on this core) */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
 }
 
 /* ============================================================================
@@ -735,7 +772,7 @@ int main(void)
          * Date format: 20date.year-date.month-date.day
          */
         
-        delay(10000000);  /* Wait ~1 second */
+        delay_ms(1000);   /* Wait 1 second */
     }
 }
 
@@ -0,0 +1,1309 @@
+/**
+ ******************************************************************************
+ * @file           : secure_boot_tutorial.c
+ * @brief          : Learning signed firmware verification without HAL
+ ******************************************************************************
+ * 
+ *  ███████╗███████╗ ██████╗    ██████╗  ██████╗  ██████╗ ████████╗
+ *  ██╔════╝██╔════╝██╔════╝    ██╔══██╗██╔═══██╗██╔═══██╗╚══██╔══╝
+ *  ███████╗█████╗  ██║         ██████╔╝██║   ██║██║   ██║   ██║   
+ *  ╚════██║██╔══╝  ██║         ██╔══██╗██║   ██║██║   ██║   ██║   
+ *  ███████║███████╗╚██████╗    ██████╔╝╚██████╔╝╚██████╔╝   ██║   
+ *  ╚══════╝╚══════╝ ╚═════╝    ╚═════╝  ╚═════╝  ╚═════╝    ╚═╝   
+ * 
+ *  INTERACTIVE LEARNING: ONLY RUN FIRMWARE YOU SIGNED
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. Why a CRC proves "not damaged" but not "written by us"
+ *  2. How a signed image is laid out (header, signature, application)
+ *  3. How to drive the HASH accelerator (SHA-256) from the CPU and DMA
+ *  4. How to write the same SHA-256 in plain C, for the PC and as a check
+ *  5. How ECDSA P-256 verification works - 256-bit maths on a 32-bit CPU
+ *  6. How a bootloader measures itself and hands over to the application
+ * 
+ *  PREREQUISITES:
+ *  - Complete the FLASH tutorial (sectors, FLASH_Program256Bit)
+ *  - Complete the DMA tutorial (streams, DMAMUX, flags)
+ *  - The DWT cycle counter from the SPI tutorial
+ * 
+ *  HARDWARE:
+ *  - Nucleo-H753ZI only (the "3" = the crypto version of the H743)
+ *  - LD1 green (PB0) = image accepted, LD3 red (PB14) = image rejected
+ *  - A PC with openssl to sign images
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐⭐ (Expert)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: CHECKSUM OR SIGNATURE?
+ *  =================================
+ * 
+ *  The FLASH tutorial writes whatever it is given. A CRC in the image
+ *  catches a bad download - but anyone can compute a CRC, so it does
+ *  not stop a modified image.
+ * 
+ *  A SIGNATURE can only be made with the PRIVATE key, which never leaves
+ *  the build server. The bootloader holds the PUBLIC key and can only
+ *  check:
+ * 
+ *      PC (build):    digest = SHA-256(image)
+ *                     signature = Sign(private key, digest)
+ *      MCU (boot):    digest = SHA-256(image)
+ *                     Verify(public key, digest, signature) → yes / no
+ * 
+ *  WHERE THE TIME GOES (64 MHz, 1 MB image, rough - main() measures yours):
+ * 
+ *  ┌──────────────────────────┬─────────────────┐
+ *  │ Step                     │ Time            │
+ *  ├──────────────────────────┼─────────────────┤
+ *  │ SHA-256 in software      │ ~ 500 ms        │
+ *  │ SHA-256 on HASH + DMA    │ ~ 20 ms         │
+ *  │ ECDSA P-256 verify       │ ~ 50 ms, fixed  │
+ *  └──────────────────────────┴─────────────────┘
+ * 
+ *  Hashing grows with the image, the signature check does not - so the
+ *  hash is what must be accelerated.
+ * 
+ *  WHY ECDSA P-256 AND NOT Ed25519?
+ *  Ed25519 hashes with SHA-512, which the HASH unit cannot do. ECDSA
+ *  P-256 signs a SHA-256 digest, so the whole image goes through the
+ *  hardware. (The H753 also has CRYP, an AES engine. It would DECRYPT
+ *  an encrypted image - a different job from proving who built it.)
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOB_BASE      0x58020400UL
+#define HASH_BASE       0x48021400UL
+#define DMA1_BASE       0x40020000UL
+#define DMA1_Stream0    (DMA1_BASE + 0x010)
+#define DMAMUX1_BASE    0x40020800UL
+
+#define SCB_VTOR_ADDR   0xE000ED08UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR;           /* 0x000 - Control register */
+    volatile uint32_t DIN;          /* 0x004 - Data input register */
+    volatile uint32_t STR;          /* 0x008 - Start register */
+    volatile uint32_t HRA[5];       /* 0x00C - Digest, first 5 words (SHA-1 era) */
+    volatile uint32_t IMR;          /* 0x020 - Interrupt enable register */
+    volatile uint32_t SR;           /* 0x024 - Status register */
+    volatile uint32_t RESERVED0[52];
+    volatile uint32_t CSR[54];      /* 0x0F8 - Context swap registers */
+    volatile uint32_t RESERVED1[80];
+    volatile uint32_t HR[8];        /* 0x310 - Digest, all 8 words */
+} HASH_TypeDef;
+
+_Static_assert(offsetof(HASH_TypeDef, SR) == 0x024, "HASH_SR offset");
+_Static_assert(offsetof(HASH_TypeDef, CSR) == 0x0F8, "HASH_CSR0 offset");
+_Static_assert(offsetof(HASH_TypeDef, HR) == 0x310, "HASH_HR0 offset");
+
+typedef struct {
+    volatile uint32_t CR;       /* Configuration register */
+    volatile uint32_t NDTR;     /* Number of data register */
+    volatile uint32_t PAR;      /* Peripheral address register */
+    volatile uint32_t M0AR;     /* Memory 0 address register */
+    volatile uint32_t M1AR;     /* Memory 1 address register */
+    volatile uint32_t FCR;      /* FIFO control register */
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    volatile uint32_t LISR;     /* Low interrupt status register */
+    volatile uint32_t HISR;     /* High interrupt status register */
+    volatile uint32_t LIFCR;    /* Low interrupt flag clear register */
+    volatile uint32_t HIFCR;    /* High interrupt flag clear register */
+} DMA_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define GPIOB       ((GPIO_TypeDef *) GPIOB_BASE)
+#define HASH        ((HASH_TypeDef *) HASH_BASE)
+#define DMA1        ((DMA_TypeDef *) DMA1_BASE)
+#define DMA1_S0     ((DMA_Stream_TypeDef *) DMA1_Stream0)
+
+/* DMAMUX1 channel n feeds DMA1 stream n (one CCR per channel, 4 bytes apart) */
+#define DMAMUX1_CCR ((volatile uint32_t *) DMAMUX1_BASE)
+
+#define SCB_VTOR    (*(volatile uint32_t *) SCB_VTOR_ADDR)
+
+/* DWT cycle counter (see the SPI tutorial) */
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB1ENR_DMA1EN      (1U << 0)
+#define RCC_AHB2ENR_HASHEN      (1U << 5)
+#define RCC_AHB4ENR_GPIOBEN     (1U << 1)
+
+/* HASH_CR */
+#define HASH_CR_INIT            (1U << 2)   /* Start a new digest */
+#define HASH_CR_DMAE            (1U << 3)   /* DMA requests enable */
+#define HASH_CR_DATATYPE_8      (2U << 4)   /* Bytes: swap each word to big-endian */
+#define HASH_CR_MDMAT           (1U << 13)  /* More DMA transfers follow - no auto DCAL */
+#define HASH_CR_ALGO_SHA256     ((1U << 18) | (1U << 7))
+
+/* HASH_STR */
+#define HASH_STR_NBLW_Pos       0U          /* Valid bits in the last word (0 = 32) */
+#define HASH_STR_DCAL           (1U << 8)   /* Pad and compute the digest */
+
+/* HASH_SR */
+#define HASH_SR_DCIS            (1U << 1)   /* Digest ready */
+#define HASH_SR_BUSY            (1U << 3)
+
+/* DMA_SxCR */
+#define DMA_CR_EN               (1U << 0)
+#define DMA_CR_DIR_M2P          (1U << 6)
+#define DMA_CR_MINC             (1U << 10)
+#define DMA_CR_PSIZE_32         (2U << 11)
+#define DMA_CR_MSIZE_32         (2U << 13)
+
+/* DMA LISR / LIFCR, stream 0 */
+#define DMA_LISR_TEIF0          (1U << 3)
+#define DMA_LISR_TCIF0          (1U << 5)
+#define DMA_S0_FLAGS_ALL        0x3DU       /* FEIF | DMEIF | TEIF | HTIF | TCIF */
+
+/* DMAMUX request IDs */
+#define DMAMUX_REQ_HASH_IN      78
+
+/* GPIO */
+#define LED_GREEN_PIN           0           /* PB0 */
+#define LED_RED_PIN             14          /* PB14 */
+
+#define CPU_CLOCK_HZ            64000000UL
+
+/* ============================================================================
+ * 
+ *  LESSON 1: THE SIGNED IMAGE
+ *  ===========================
+ * 
+ *  Flash bank 1 is split between this bootloader and the application:
+ * 
+ *      0x08000000  ┌──────────────────────────┐
+ *                  │ bootloader (this file)   │  sector 0, 128 KB
+ *      0x08020000  ├──────────────────────────┤
+ *                  │ ImageHeader_t            │  magic, version, size,
+ *                  │                          │  signature r and s
+ *      0x08020400  ├──────────────────────────┤
+ *                  │ application              │  its own vector table
+ *                  │ (size bytes)             │  first (1 KB aligned
+ *                  │                          │  for VTOR)
+ *                  └──────────────────────────┘
+ * 
+ *  SIGNED MESSAGE = the first 16 bytes of the header + the application.
+ *  The size and version are signed too, so nobody can cut the image
+ *  short or roll it back to an old version that claims to be new.
+ * 
+ *  SIGNING ON THE PC (once: make a key pair, keep signing_key.pem safe):
+ * 
+ *      openssl ecparam -name prime256v1 -genkey -noout -out signing_key.pem
+ *      openssl ec -in signing_key.pem -pubout -text -noout
+ *          → "pub:" 04 | X (32 bytes) | Y (32 bytes) → boot_public_key_x/y
+ * 
+ *  For each release:
+ * 
+ *      cat header16.bin app.bin > signed.bin
+ *      openssl dgst -sha256 -sign signing_key.pem -out sig.der signed.bin
+ *      openssl asn1parse -inform DER -in sig.der
+ *          → two INTEGERs: r and s. Left-pad each to 32 bytes (drop a
+ *            leading 00) and put them in sig_r / sig_s.
+ * 
+ * ============================================================================ */
+
+#define APP_SLOT_ADDR           0x08020000UL
+#define APP_HEADER_SIZE         0x400UL
+#define APP_VECTORS_ADDR        (APP_SLOT_ADDR + APP_HEADER_SIZE)
+#define APP_MAX_SIZE            (0x00100000UL - 0x20000UL - APP_HEADER_SIZE)
+#define IMAGE_MAGIC             0x5349474EUL    /* "SIGN" */
+#define IMAGE_SIGNED_HEADER     16U             /* magic, version, size, flags */
+
+typedef struct {
+    uint32_t magic;         /* IMAGE_MAGIC */
+    uint32_t version;       /* Release number */
+    uint32_t size;          /* Application bytes after the header */
+    uint32_t flags;         /* Reserved, 0 */
+    uint8_t sig_r[32];      /* ECDSA signature, big-endian */
+    uint8_t sig_s[32];
+} ImageHeader_t;
+
+_Static_assert(offsetof(ImageHeader_t, sig_r) == IMAGE_SIGNED_HEADER, "signed header size");
+
+/* The PUBLIC half of the demo key used for the self-test below. Replace
+ * it with your own - the private half of this one is not secret. */
+const uint8_t boot_public_key_x[32] = {
+    0x53, 0x6F, 0x9F, 0xBE, 0xB8, 0xF0, 0xAE, 0x64, 0x7C, 0xD8, 0xA0, 0xE7, 0x71, 0xB7, 0x84, 0xCB,
+    0x07, 0xDE, 0xB3, 0x24, 0xC3, 0x55, 0x69, 0xC6, 0x88, 0x05, 0xC0, 0x13, 0xB3, 0x33, 0x3C, 0x96
+};
+const uint8_t boot_public_key_y[32] = {
+    0xC1, 0x82, 0x2F, 0xAD, 0xDD, 0x11, 0x39, 0x30, 0x7F, 0xF5, 0xE7, 0x51, 0x04, 0x72, 0x20, 0xBF,
+    0x37, 0x8A, 0x4F, 0x70, 0x9B, 0x5F, 0x93, 0xCE, 0x4C, 0x80, 0x6C, 0x5D, 0x31, 0x4A, 0x31, 0x2C
+};
+
+/* ============================================================================
+ * 
+ *  LESSON 2: THE HASH ACCELERATOR
+ *  ===============================
+ * 
+ *  1. CR = algorithm + data type + INIT          (starts a new digest)
+ *  2. Write the message to DIN, 32 bits at a time (CPU or DMA)
+ *  3. STR = valid bits in the last word + DCAL  (pad and finish)
+ *  4. Wait for DCIS, read HR[0..7]
+ * 
+ *  DATA TYPE: SHA-256 reads the message big-endian, the M7 is little-
+ *  endian. DATATYPE = 8-bit makes the unit swap the bytes of each word,
+ *  so memory can be written as-is.
+ * 
+ *  THE LAST WORD: a 10-byte message is 3 words; only 16 bits of the
+ *  third count. NBLW = 16 tells the unit so (0 means all 32).
+ * 
+ *  WITH DMA: the unit requests words through DMAMUX (HASH_IN). One DMA
+ *  transfer moves at most 65535 words (256 KB), so 1 MB needs several.
+ *  MDMAT = 1 keeps the unit from finishing after the first one; we set
+ *  DCAL ourselves at the end.
+ * 
+ * ============================================================================ */
+
+void Hash_InitHardware(void) {
+    RCC->AHB2ENR |= RCC_AHB2ENR_HASHEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    (void)RCC->AHB2ENR;                 /* Let the clock settle */
+
+    DMAMUX1_CCR[0] = DMAMUX_REQ_HASH_IN;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: START A DIGEST
+ *  ===============================
+ * 
+ * ============================================================================ */
+
+uint32_t hash_last_bytes = 0;           /* Bytes in the final partial word */
+
+void HashHw_Begin(void) {
+    /* ✏️ YOUR TURN: SHA-256, byte data, start a new digest */
+    HASH->CR = HASH_CR_ALGO_SHA256 | HASH_CR_DATATYPE_8 | ???;  /* HINT: Which bit starts over? */
+
+    hash_last_bytes = 0;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * HASH->CR = HASH_CR_ALGO_SHA256 | HASH_CR_DATATYPE_8 | HASH_CR_INIT;
+ * 
+ * Algorithm and data type are taken at INIT - changing them later has
+ * no effect on the digest in progress.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* CPU feed. Every call but the last must be a multiple of 4 bytes. */
+void HashHw_Update(const uint8_t *data, uint32_t len) {
+    while (len >= 4) {
+        uint32_t word;
+
+        word = (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+               ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+        HASH->DIN = word;
+        data += 4;
+        len -= 4;
+    }
+
+    if (len > 0) {
+        uint32_t word = 0;
+
+        for (uint32_t i = 0; i < len; i++) {
+            word |= (uint32_t)data[i] << (8 * i);
+        }
+        HASH->STR = (len * 8U) << HASH_STR_NBLW_Pos;
+        HASH->DIN = word;
+        hash_last_bytes = len;
+    }
+}
+
+/* DMA feed, for large aligned regions in flash or AXI SRAM (DMA1 cannot
+ * see DTCM). The last call may end in a partial word. 0 or -1. */
+#define HASH_DMA_MAX_WORDS      65535U      /* NDTR is 16 bits */
+
+int HashHw_UpdateDMA(const uint32_t *words, uint32_t len) {
+    uint32_t count = (len + 3U) / 4U;
+
+    HASH->CR |= HASH_CR_DMAE | HASH_CR_MDMAT;
+
+    /* NBLW must be known before the last word arrives */
+    hash_last_bytes = len & 3U;
+    HASH->STR = (hash_last_bytes * 8U) << HASH_STR_NBLW_Pos;
+
+    while (count > 0) {
+        uint32_t chunk = (count > HASH_DMA_MAX_WORDS) ? HASH_DMA_MAX_WORDS : count;
+
+        DMA1_S0->CR &= ~DMA_CR_EN;
+        while (DMA1_S0->CR & DMA_CR_EN);
+        DMA1->LIFCR = DMA_S0_FLAGS_ALL;
+
+        DMA1_S0->PAR = (uint32_t)&HASH->DIN;
+        DMA1_S0->M0AR = (uint32_t)words;
+        DMA1_S0->NDTR = chunk;
+        DMA1_S0->FCR = 0;               /* Direct mode: word in, word out */
+        DMA1_S0->CR = DMA_CR_DIR_M2P | DMA_CR_MINC | DMA_CR_PSIZE_32 | DMA_CR_MSIZE_32;
+        DMA1_S0->CR |= DMA_CR_EN;
+
+        /* The CPU is free here - the ECDSA maths could run meanwhile */
+        while (!(DMA1->LISR & (DMA_LISR_TCIF0 | DMA_LISR_TEIF0)));
+        if (DMA1->LISR & DMA_LISR_TEIF0) {
+            HASH->CR &= ~HASH_CR_DMAE;
+            return -1;
+        }
+
+        words += chunk;
+        count -= chunk;
+    }
+
+    HASH->CR &= ~HASH_CR_DMAE;
+    return 0;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: FINISH THE DIGEST
+ *  ==================================
+ * 
+ * ============================================================================ */
+
+void HashHw_Final(uint8_t digest[32]) {
+    while (HASH->SR & HASH_SR_BUSY);
+
+    /* ✏️ YOUR TURN: Keep NBLW, add the bit that pads and computes */
+    HASH->STR = ((hash_last_bytes * 8U) << HASH_STR_NBLW_Pos) | ???;    /* HINT: HASH_STR_... */
+
+    while (!(HASH->SR & HASH_SR_DCIS));
+
+    for (int i = 0; i < 8; i++) {
+        uint32_t h = HASH->HR[i];
+
+        digest[4 * i + 0] = (uint8_t)(h >> 24);
+        digest[4 * i + 1] = (uint8_t)(h >> 16);
+        digest[4 * i + 2] = (uint8_t)(h >> 8);
+        digest[4 * i + 3] = (uint8_t)h;
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * HASH->STR = ((hash_last_bytes * 8U) << HASH_STR_NBLW_Pos) | HASH_STR_DCAL;
+ * 
+ * Writing STR without NBLW would say "the last word is a full 32 bits"
+ * and a 10-byte message would be hashed as 12 bytes.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  LESSON 3: SHA-256 IN PLAIN C
+ *  =============================
+ * 
+ *  Why write it when the hardware exists?
+ *  • The PC signing tool needs the SAME digest - this code compiles there
+ *    unchanged (no registers), and sha256sum gives a third opinion
+ *  • A second, independent result to check the hardware against
+ *  • A fallback for a chip without HASH (an H743)
+ * 
+ *  SHA-256 eats 64-byte blocks. Each block stirs 8 state words through
+ *  64 rounds of add / rotate / xor. The message is padded with 0x80,
+ *  zeros and its length in bits so it ends on a block boundary.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t length;            /* Bytes hashed so far */
+    uint8_t block[64];
+    uint32_t used;              /* Bytes waiting in block */
+} Sha256_t;
+
+static const uint32_t sha256_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+#define ROR32(x, n)     (((x) >> (n)) | ((x) << (32 - (n))))
+
+void Sha256Soft_Block(Sha256_t *ctx, const uint8_t *p) {
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) |
+               ((uint32_t)p[4 * i + 2] << 8) | (uint32_t)p[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROR32(w[i - 15], 7) ^ ROR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROR32(w[i - 2], 17) ^ ROR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = ctx->state[0]; b = ctx->state[1]; c = ctx->state[2]; d = ctx->state[3];
+    e = ctx->state[4]; f = ctx->state[5]; g = ctx->state[6]; h = ctx->state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (ROR32(e, 6) ^ ROR32(e, 11) ^ ROR32(e, 25)) +
+                      ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        uint32_t t2 = (ROR32(a, 2) ^ ROR32(a, 13) ^ ROR32(a, 22)) +
+                      ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    ctx->state[0] += a; ctx->state[1] += b; ctx->state[2] += c; ctx->state[3] += d;
+    ctx->state[4] += e; ctx->state[5] += f; ctx->state[6] += g; ctx->state[7] += h;
+}
+
+void Sha256Soft_Begin(Sha256_t *ctx) {
+    static const uint32_t init[8] = {
+        0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+        0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+    };
+
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = init[i];
+    }
+    ctx->length = 0;
+    ctx->used = 0;
+}
+
+void Sha256Soft_Update(Sha256_t *ctx, const uint8_t *data, uint32_t len) {
+    ctx->length += len;
+
+    while (len > 0) {
+        if (ctx->used == 0 && len >= 64) {
+            Sha256Soft_Block(ctx, data);    /* Whole blocks straight from the source */
+            data += 64;
+            len -= 64;
+            continue;
+        }
+        ctx->block[ctx->used++] = *data++;
+        len--;
+        if (ctx->used == 64) {
+            Sha256Soft_Block(ctx, ctx->block);
+            ctx->used = 0;
+        }
+    }
+}
+
+void Sha256Soft_Final(Sha256_t *ctx, uint8_t digest[32]) {
+    uint64_t bits = ctx->length * 8U;
+
+    ctx->block[ctx->used++] = 0x80;
+    if (ctx->used > 56) {
+        while (ctx->used < 64) {
+            ctx->block[ctx->used++] = 0;
+        }
+        Sha256Soft_Block(ctx, ctx->block);
+        ctx->used = 0;
+    }
+    while (ctx->used < 56) {
+        ctx->block[ctx->used++] = 0;
+    }
+    for (int i = 0; i < 8; i++) {
+        ctx->block[56 + i] = (uint8_t)(bits >> (56 - 8 * i));
+    }
+    Sha256Soft_Block(ctx, ctx->block);
+
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i + 0] = (uint8_t)(ctx->state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)ctx->state[i];
+    }
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 4: 256-BIT NUMBERS ON A 32-BIT CPU
+ *  ==========================================
+ * 
+ *  ECDSA P-256 works with numbers modulo two 256-bit primes: p (the
+ *  coordinates) and n (the signature values). A number = 8 words, least
+ *  significant first.
+ * 
+ *  The expensive part is a × b mod m. Dividing by m is slow, so we use
+ *  MONTGOMERY form: keep every number as a·R mod m (R = 2^256). Then
+ * 
+ *      MontMul(aR, bR) = aR · bR / R = abR      (mod m)
+ * 
+ *  and "/ R" is just dropping the low 8 words - once the low words are
+ *  made zero by adding the right multiple of m, one word at a time.
+ * 
+ *  Only PUBLIC values go through this code (image, signature, public
+ *  key), so it does not need to be constant-time. Signing code would.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    uint32_t v[8];              /* Least significant word first */
+} Bn256_t;
+
+typedef struct {
+    Bn256_t m;                  /* The modulus */
+    uint32_t m_inv;             /* -1 / m mod 2^32 */
+    Bn256_t rr;                 /* R^2 mod m - converts into Montgomery form */
+    Bn256_t one;                /* R mod m - the number 1 in Montgomery form */
+} Modulus_t;
+
+void Bn_FromBytes(Bn256_t *r, const uint8_t bytes[32]) {
+    for (int i = 0; i < 8; i++) {
+        const uint8_t *p = &bytes[28 - 4 * i];
+        r->v[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                  ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    }
+}
+
+int Bn_Cmp(const Bn256_t *a, const Bn256_t *b) {
+    for (int i = 7; i >= 0; i--) {
+        if (a->v[i] != b->v[i]) {
+            return (a->v[i] > b->v[i]) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+int Bn_IsZero(const Bn256_t *a) {
+    uint32_t any = 0;
+
+    for (int i = 0; i < 8; i++) {
+        any |= a->v[i];
+    }
+    return any == 0;
+}
+
+uint32_t Bn_Add(Bn256_t *r, const Bn256_t *a, const Bn256_t *b) {
+    uint64_t carry = 0;
+
+    for (int i = 0; i < 8; i++) {
+        carry += (uint64_t)a->v[i] + b->v[i];
+        r->v[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    return (uint32_t)carry;
+}
+
+uint32_t Bn_Sub(Bn256_t *r, const Bn256_t *a, const Bn256_t *b) {
+    uint64_t borrow = 0;
+
+    for (int i = 0; i < 8; i++) {
+        uint64_t d = (uint64_t)a->v[i] - b->v[i] - borrow;
+        r->v[i] = (uint32_t)d;
+        borrow = (d >> 32) & 1U;
+    }
+    return (uint32_t)borrow;
+}
+
+void Mod_Add(Bn256_t *r, const Bn256_t *a, const Bn256_t *b, const Modulus_t *mod) {
+    if (Bn_Add(r, a, b) || Bn_Cmp(r, &mod->m) >= 0) {
+        Bn_Sub(r, r, &mod->m);
+    }
+}
+
+void Mod_Sub(Bn256_t *r, const Bn256_t *a, const Bn256_t *b, const Modulus_t *mod) {
+    if (Bn_Sub(r, a, b)) {
+        Bn_Add(r, r, &mod->m);
+    }
+}
+
+/* r = a · b / R mod m (word-by-word Montgomery, "CIOS") */
+void Mod_Mul(Bn256_t *r, const Bn256_t *a, const Bn256_t *b, const Modulus_t *mod) {
+    uint32_t t[10] = { 0 };
+
+    for (int i = 0; i < 8; i++) {
+        uint64_t c = 0;
+        uint32_t u;
+
+        /* t += a · b[i] */
+        for (int j = 0; j < 8; j++) {
+            c += (uint64_t)a->v[j] * b->v[i] + t[j];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[8] = (uint32_t)c;
+        t[9] = (uint32_t)(c >> 32);
+
+        /* t += u · m makes the low word 0; then drop it (t /= 2^32) */
+        u = t[0] * mod->m_inv;
+        c = ((uint64_t)u * mod->m.v[0] + t[0]) >> 32;
+        for (int j = 1; j < 8; j++) {
+            c += (uint64_t)u * mod->m.v[j] + t[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[7] = (uint32_t)c;
+        t[8] = t[9] + (uint32_t)(c >> 32);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        r->v[i] = t[i];
+    }
+    if (t[8] || Bn_Cmp(r, &mod->m) >= 0) {
+        Bn_Sub(r, r, &mod->m);
+    }
+}
+
+void Mod_ToMont(Bn256_t *r, const Bn256_t *a, const Modulus_t *mod) {
+    Mod_Mul(r, a, &mod->rr, mod);
+}
+
+void Mod_FromMont(Bn256_t *r, const Bn256_t *a, const Modulus_t *mod) {
+    static const Bn256_t plain_one = { { 1, 0, 0, 0, 0, 0, 0, 0 } };
+
+    Mod_Mul(r, a, &plain_one, mod);
+}
+
+/* r = 1/a (Montgomery form in and out). m is prime, so 1/a = a^(m-2). */
+void Mod_Inv(Bn256_t *r, const Bn256_t *a, const Modulus_t *mod) {
+    static const Bn256_t two = { { 2, 0, 0, 0, 0, 0, 0, 0 } };
+    Bn256_t e, x = mod->one;
+
+    Bn_Sub(&e, &mod->m, &two);
+    for (int bit = 255; bit >= 0; bit--) {
+        Mod_Mul(&x, &x, &x, mod);
+        if (e.v[bit / 32] & (1U << (bit % 32))) {
+            Mod_Mul(&x, &x, a, mod);
+        }
+    }
+    *r = x;
+}
+
+void Mod_Init(Modulus_t *mod, const uint8_t m[32]) {
+    uint32_t inv = 1;
+
+    Bn_FromBytes(&mod->m, m);
+
+    /* Newton: each step doubles the correct low bits (1 → 2 → ... → 32) */
+    for (int i = 0; i < 5; i++) {
+        inv *= 2U - mod->m.v[0] * inv;
+    }
+    mod->m_inv = 0U - inv;
+
+    /* R mod m and R^2 mod m by doubling 1, 256 and 512 times */
+    for (int i = 0; i < 8; i++) {
+        mod->rr.v[i] = (i == 0) ? 1U : 0U;
+    }
+    for (int i = 0; i < 512; i++) {
+        Mod_Add(&mod->rr, &mod->rr, &mod->rr, mod);
+        if (i == 255) {
+            mod->one = mod->rr;
+        }
+    }
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 5: THE CURVE AND THE CHECK
+ *  ==================================
+ * 
+ *  P-256: the points (x, y) with  y² = x³ - 3x + b  (mod p), plus a
+ *  "point at infinity" that acts like 0. Points can be ADDED; adding G
+ *  to itself k times is written k·G.
+ * 
+ *  Private key d, public key Q = d·G. Knowing Q and G, d cannot be found.
+ * 
+ *  VERIFY (e = digest, (r, s) = signature, everything mod n):
+ *      1. 1 ≤ r, s < n                 (else: reject)
+ *      2. w = 1/s,  u1 = e·w,  u2 = r·w
+ *      3. X = u1·G + u2·Q              (the expensive part)
+ *      4. accept if X.x mod n == r
+ * 
+ *  Step 3 walks the bits of u1 and u2 together ("Shamir's trick"): one
+ *  doubling per bit and an addition of G, Q or G+Q. Points are kept as
+ *  (X, Y, Z) with x = X/Z², y = Y/Z³ ("Jacobian") so no division is
+ *  needed until the very end.
+ * 
+ * ============================================================================ */
+
+typedef struct {
+    Bn256_t x, y, z;            /* Jacobian, Montgomery form mod p; z = 0 is infinity */
+} Point_t;
+
+static const uint8_t p256_p[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+static const uint8_t p256_n[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51
+};
+static const uint8_t p256_b[32] = {
+    0x5A, 0xC6, 0x35, 0xD8, 0xAA, 0x3A, 0x93, 0xE7, 0xB3, 0xEB, 0xBD, 0x55, 0x76, 0x98, 0x86, 0xBC,
+    0x65, 0x1D, 0x06, 0xB0, 0xCC, 0x53, 0xB0, 0xF6, 0x3B, 0xCE, 0x3C, 0x3E, 0x27, 0xD2, 0x60, 0x4B
+};
+static const uint8_t p256_gx[32] = {
+    0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+    0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96
+};
+static const uint8_t p256_gy[32] = {
+    0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+    0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5
+};
+
+Modulus_t mod_p;
+Modulus_t mod_n;
+uint8_t ecc_ready = 0;
+
+void Ecc_Init(void) {
+    Mod_Init(&mod_p, p256_p);
+    Mod_Init(&mod_n, p256_n);
+    ecc_ready = 1;
+}
+
+/* Affine bytes → Jacobian point. Rejects points that are not on the curve. */
+int Point_FromBytes(Point_t *pt, const uint8_t x[32], const uint8_t y[32]) {
+    Bn256_t lhs, rhs, t, b;
+
+    Bn_FromBytes(&pt->x, x);
+    Bn_FromBytes(&pt->y, y);
+    if (Bn_Cmp(&pt->x, &mod_p.m) >= 0 || Bn_Cmp(&pt->y, &mod_p.m) >= 0) {
+        return -1;
+    }
+    Mod_ToMont(&pt->x, &pt->x, &mod_p);
+    Mod_ToMont(&pt->y, &pt->y, &mod_p);
+    pt->z = mod_p.one;
+
+    /* y² == x³ - 3x + b ? */
+    Bn_FromBytes(&b, p256_b);
+    Mod_ToMont(&b, &b, &mod_p);
+    Mod_Mul(&lhs, &pt->y, &pt->y, &mod_p);
+    Mod_Mul(&rhs, &pt->x, &pt->x, &mod_p);
+    Mod_Mul(&rhs, &rhs, &pt->x, &mod_p);
+    Mod_Add(&t, &pt->x, &pt->x, &mod_p);
+    Mod_Add(&t, &t, &pt->x, &mod_p);
+    Mod_Sub(&rhs, &rhs, &t, &mod_p);
+    Mod_Add(&rhs, &rhs, &b, &mod_p);
+
+    return (Bn_Cmp(&lhs, &rhs) == 0) ? 0 : -1;
+}
+
+/* r = 2·a  (a = -3 formulas) */
+void Point_Double(Point_t *r, const Point_t *a) {
+    Bn256_t delta, gamma, beta, alpha, t1, t2;
+
+    if (Bn_IsZero(&a->z) || Bn_IsZero(&a->y)) {
+        Bn_Sub(&r->z, &r->z, &r->z);    /* Infinity */
+        return;
+    }
+
+    Mod_Mul(&delta, &a->z, &a->z, &mod_p);
+    Mod_Mul(&gamma, &a->y, &a->y, &mod_p);
+    Mod_Mul(&beta, &a->x, &gamma, &mod_p);
+
+    /* alpha = 3 (X - delta)(X + delta) */
+    Mod_Sub(&t1, &a->x, &delta, &mod_p);
+    Mod_Add(&t2, &a->x, &delta, &mod_p);
+    Mod_Mul(&t1, &t1, &t2, &mod_p);
+    Mod_Add(&alpha, &t1, &t1, &mod_p);
+    Mod_Add(&alpha, &alpha, &t1, &mod_p);
+
+    /* Z3 = (Y + Z)² - gamma - delta */
+    Mod_Add(&t1, &a->y, &a->z, &mod_p);
+    Mod_Mul(&t1, &t1, &t1, &mod_p);
+    Mod_Sub(&t1, &t1, &gamma, &mod_p);
+    Mod_Sub(&r->z, &t1, &delta, &mod_p);
+
+    /* X3 = alpha² - 8 beta */
+    Mod_Add(&beta, &beta, &beta, &mod_p);
+    Mod_Add(&beta, &beta, &beta, &mod_p);       /* 4 beta */
+    Mod_Mul(&t1, &alpha, &alpha, &mod_p);
+    Mod_Add(&t2, &beta, &beta, &mod_p);
+    Mod_Sub(&r->x, &t1, &t2, &mod_p);
+
+    /* Y3 = alpha (4 beta - X3) - 8 gamma² */
+    Mod_Sub(&t1, &beta, &r->x, &mod_p);
+    Mod_Mul(&t1, &alpha, &t1, &mod_p);
+    Mod_Mul(&t2, &gamma, &gamma, &mod_p);
+    Mod_Add(&t2, &t2, &t2, &mod_p);
+    Mod_Add(&t2, &t2, &t2, &mod_p);
+    Mod_Add(&t2, &t2, &t2, &mod_p);
+    Mod_Sub(&r->y, &t1, &t2, &mod_p);
+}
+
+/* r = a + b (r may be a or b) */
+void Point_Add(Point_t *r, const Point_t *a, const Point_t *b) {
+    Bn256_t z1z1, z2z2, u1, u2, s1, s2, h, rr, hh, hhh, v, t;
+
+    if (Bn_IsZero(&a->z)) {
+        *r = *b;
+        return;
+    }
+    if (Bn_IsZero(&b->z)) {
+        *r = *a;
+        return;
+    }
+
+    Mod_Mul(&z1z1, &a->z, &a->z, &mod_p);
+    Mod_Mul(&z2z2, &b->z, &b->z, &mod_p);
+    Mod_Mul(&u1, &a->x, &z2z2, &mod_p);
+    Mod_Mul(&u2, &b->x, &z1z1, &mod_p);
+    Mod_Mul(&s1, &a->y, &b->z, &mod_p);
+    Mod_Mul(&s1, &s1, &z2z2, &mod_p);
+    Mod_Mul(&s2, &b->y, &a->z, &mod_p);
+    Mod_Mul(&s2, &s2, &z1z1, &mod_p);
+    Mod_Sub(&h, &u2, &u1, &mod_p);
+    Mod_Sub(&rr, &s2, &s1, &mod_p);
+
+    if (Bn_IsZero(&h)) {
+        if (Bn_IsZero(&rr)) {
+            Point_Double(r, a);         /* a == b */
+        } else {
+            Bn_Sub(&r->z, &r->z, &r->z);    /* a == -b */
+        }
+        return;
+    }
+
+    Mod_Mul(&hh, &h, &h, &mod_p);
+    Mod_Mul(&hhh, &h, &hh, &mod_p);
+    Mod_Mul(&v, &u1, &hh, &mod_p);
+
+    /* Z3 = Z1 Z2 H (before r->z may overwrite a->z or b->z) */
+    Mod_Mul(&t, &a->z, &b->z, &mod_p);
+    Mod_Mul(&r->z, &t, &h, &mod_p);
+
+    /* X3 = rr² - HHH - 2V */
+    Mod_Mul(&t, &rr, &rr, &mod_p);
+    Mod_Sub(&t, &t, &hhh, &mod_p);
+    Mod_Sub(&t, &t, &v, &mod_p);
+    Mod_Sub(&r->x, &t, &v, &mod_p);
+
+    /* Y3 = rr (V - X3) - S1 HHH */
+    Mod_Sub(&t, &v, &r->x, &mod_p);
+    Mod_Mul(&t, &rr, &t, &mod_p);
+    Mod_Mul(&s1, &s1, &hhh, &mod_p);
+    Mod_Sub(&r->y, &t, &s1, &mod_p);
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: u1·G + u2·Q IN ONE PASS
+ *  ========================================
+ * 
+ * ============================================================================ */
+
+void Point_DoubleMul(Point_t *r, const Bn256_t *u1, const Point_t *g,
+                     const Bn256_t *u2, const Point_t *q) {
+    Point_t gq;
+
+    Point_Add(&gq, g, q);
+    Bn_Sub(&r->z, &r->z, &r->z);        /* Start at infinity */
+
+    for (int bit = 255; bit >= 0; bit--) {
+        uint32_t b1 = (u1->v[bit / 32] >> (bit % 32)) & 1U;
+        uint32_t b2 = (u2->v[bit / 32] >> (bit % 32)) & 1U;
+
+        Point_Double(r, r);
+
+        /* ✏️ YOUR TURN: Add the point that matches this pair of bits */
+        if (b1 && b2) {
+            Point_Add(r, r, ???);       /* HINT: G and Q at once */
+        } else if (b1) {
+            Point_Add(r, r, g);
+        } else if (b2) {
+            Point_Add(r, r, q);
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * Point_Add(r, r, &gq);
+ * 
+ * Two separate multiplications cost 2 × 256 doublings. Sharing them costs
+ * 256 - almost half the verify time saved for one extra addition.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* 0 = valid signature, -1 = reject */
+int Ecdsa_Verify(const uint8_t qx[32], const uint8_t qy[32], const uint8_t digest[32],
+                 const uint8_t sig_r[32], const uint8_t sig_s[32]) {
+    Point_t g, q, x;
+    Bn256_t r, s, e, w, u1, u2, zinv;
+
+    if (!ecc_ready) {
+        Ecc_Init();
+    }
+
+    /* 1. Range check */
+    Bn_FromBytes(&r, sig_r);
+    Bn_FromBytes(&s, sig_s);
+    if (Bn_IsZero(&r) || Bn_IsZero(&s) ||
+        Bn_Cmp(&r, &mod_n.m) >= 0 || Bn_Cmp(&s, &mod_n.m) >= 0) {
+        return -1;
+    }
+    if (Point_FromBytes(&q, qx, qy) != 0) {
+        return -1;
+    }
+    Point_FromBytes(&g, p256_gx, p256_gy);
+
+    /* 2. e < 2^256 < 2n, so one subtraction reduces it */
+    Bn_FromBytes(&e, digest);
+    if (Bn_Cmp(&e, &mod_n.m) >= 0) {
+        Bn_Sub(&e, &e, &mod_n.m);
+    }
+    Mod_ToMont(&w, &s, &mod_n);
+    Mod_Inv(&w, &w, &mod_n);            /* (1/s)·R */
+    Mod_Mul(&u1, &e, &w, &mod_n);       /* Plain e·w: the R cancels */
+    Mod_Mul(&u2, &r, &w, &mod_n);
+
+    /* 3. */
+    Point_DoubleMul(&x, &u1, &g, &u2, &q);
+    if (Bn_IsZero(&x.z)) {
+        return -1;
+    }
+
+    /* 4. Affine x = X / Z², then mod n */
+    Mod_Inv(&zinv, &x.z, &mod_p);
+    Mod_Mul(&zinv, &zinv, &zinv, &mod_p);
+    Mod_Mul(&x.x, &x.x, &zinv, &mod_p);
+    Mod_FromMont(&x.x, &x.x, &mod_p);
+    if (Bn_Cmp(&x.x, &mod_n.m) >= 0) {
+        Bn_Sub(&x.x, &x.x, &mod_n.m);
+    }
+
+    return (Bn_Cmp(&x.x, &r) == 0) ? 0 : -1;
+}
+
+/* ============================================================================
+ * 
+ *  LESSON 6: THE BOOT DECISION
+ *  ============================
+ * 
+ *  1. Header sane?  magic, size fits the slot
+ *  2. digest = SHA-256(header[0..15] + application)    HASH + DMA
+ *  3. ECDSA verify with the built-in public key
+ *  4. Pass → point VTOR at the application, load its stack pointer,
+ *     jump to its reset handler.  Fail → stay here, red LED.
+ * 
+ *  Every step is timed with DWT_CYCCNT so you can see where boot time
+ *  goes - watch boot_hash_us and boot_verify_us in the debugger.
+ * 
+ * ============================================================================ */
+
+typedef enum {
+    BOOT_OK = 0,
+    BOOT_NO_IMAGE,              /* Bad magic or size */
+    BOOT_HASH_ERROR,            /* DMA transfer error */
+    BOOT_BAD_SIGNATURE
+} BootResult_t;
+
+volatile BootResult_t boot_result = BOOT_NO_IMAGE;
+volatile uint32_t boot_hash_us = 0;
+volatile uint32_t boot_verify_us = 0;
+volatile uint32_t boot_soft_hash_us = 0;    /* Same digest in software, for comparison */
+volatile uint8_t boot_digests_match = 0;
+volatile uint8_t boot_self_test_ok = 0;
+
+void Cycles_Init(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_LAR = 0xC5ACCE55;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+uint32_t Cycles_ToUs(uint32_t cycles) {
+    return cycles / (CPU_CLOCK_HZ / 1000000UL);
+}
+
+/* Known answers: SHA-256("abc") on both paths, and a signature made on
+ * the PC with the demo key over "STM32 Bare Metal Academy". */
+int Boot_SelfTest(void) {
+    static const uint8_t abc_digest[32] = {
+        0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+        0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD
+    };
+    static const uint8_t demo_msg[] = "STM32 Bare Metal Academy";
+    static const uint8_t demo_r[32] = {
+        0x4A, 0x1C, 0xB2, 0x32, 0x34, 0x2E, 0xAE, 0x62, 0x45, 0xE2, 0x00, 0xD4, 0x79, 0xA9, 0x46, 0x44,
+        0x18, 0x67, 0x5C, 0x23, 0x92, 0xF4, 0xC3, 0x7A, 0x8D, 0xBF, 0xE3, 0x3F, 0x98, 0xA1, 0xDC, 0x3B
+    };
+    static const uint8_t demo_s[32] = {
+        0x8C, 0xD3, 0xDF, 0x7F, 0x70, 0xEC, 0x6C, 0xD7, 0xE9, 0x75, 0xFC, 0xCF, 0x8A, 0x39, 0xD3, 0x84,
+        0xFD, 0x47, 0x83, 0xB2, 0xCD, 0xC3, 0x2F, 0xA4, 0x3E, 0x29, 0xA5, 0x06, 0xD6, 0x68, 0x27, 0xA6
+    };
+    uint8_t hw[32], sw[32];
+    Sha256_t ctx;
+    uint8_t bad_s[32];
+
+    HashHw_Begin();
+    HashHw_Update((const uint8_t *)"abc", 3);
+    HashHw_Final(hw);
+
+    Sha256Soft_Begin(&ctx);
+    Sha256Soft_Update(&ctx, (const uint8_t *)"abc", 3);
+    Sha256Soft_Final(&ctx, sw);
+
+    for (int i = 0; i < 32; i++) {
+        if (hw[i] != abc_digest[i] || sw[i] != abc_digest[i]) {
+            return -1;
+        }
+    }
+
+    Sha256Soft_Begin(&ctx);
+    Sha256Soft_Update(&ctx, demo_msg, sizeof(demo_msg) - 1U);
+    Sha256Soft_Final(&ctx, sw);
+    if (Ecdsa_Verify(boot_public_key_x, boot_public_key_y, sw, demo_r, demo_s) != 0) {
+        return -1;
+    }
+
+    /* One flipped bit must fail */
+    for (int i = 0; i < 32; i++) {
+        bad_s[i] = demo_s[i];
+    }
+    bad_s[31] ^= 1U;
+    if (Ecdsa_Verify(boot_public_key_x, boot_public_key_y, sw, demo_r, bad_s) == 0) {
+        return -1;
+    }
+    return 0;
+}
+
+BootResult_t Boot_VerifyImage(void) {
+    const ImageHeader_t *hdr = (const ImageHeader_t *)APP_SLOT_ADDR;
+    const uint8_t *app = (const uint8_t *)APP_VECTORS_ADDR;
+    uint8_t digest[32], soft[32];
+    Sha256_t ctx;
+    uint32_t start;
+
+    if (hdr->magic != IMAGE_MAGIC || hdr->size == 0 || hdr->size > APP_MAX_SIZE) {
+        return BOOT_NO_IMAGE;
+    }
+
+    start = DWT_CYCCNT;
+    HashHw_Begin();
+    HashHw_Update((const uint8_t *)hdr, IMAGE_SIGNED_HEADER);
+    if (HashHw_UpdateDMA((const uint32_t *)app, hdr->size) != 0) {
+        return BOOT_HASH_ERROR;
+    }
+    HashHw_Final(digest);
+    boot_hash_us = Cycles_ToUs(DWT_CYCCNT - start);
+
+    /* The software path, timed for comparison - drop it in production */
+    start = DWT_CYCCNT;
+    Sha256Soft_Begin(&ctx);
+    Sha256Soft_Update(&ctx, (const uint8_t *)hdr, IMAGE_SIGNED_HEADER);
+    Sha256Soft_Update(&ctx, app, hdr->size);
+    Sha256Soft_Final(&ctx, soft);
+    boot_soft_hash_us = Cycles_ToUs(DWT_CYCCNT - start);
+
+    boot_digests_match = 1;
+    for (int i = 0; i < 32; i++) {
+        if (digest[i] != soft[i]) {
+            boot_digests_match = 0;
+        }
+    }
+
+    start = DWT_CYCCNT;
+    if (Ecdsa_Verify(boot_public_key_x, boot_public_key_y, digest,
+                     hdr->sig_r, hdr->sig_s) != 0) {
+        boot_verify_us = Cycles_ToUs(DWT_CYCCNT - start);
+        return BOOT_BAD_SIGNATURE;
+    }
+    boot_verify_us = Cycles_ToUs(DWT_CYCCNT - start);
+
+    return BOOT_OK;
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: HAND OVER TO THE APPLICATION
+ *  =============================================
+ * 
+ *  The application's vector table starts with its initial stack pointer
+ *  and the address of its reset handler - exactly what the hardware
+ *  reads at power-up from 0x08000000.
+ * 
+ * ============================================================================ */
+
+void Boot_JumpToApp(void) {
+    const uint32_t *vectors = (const uint32_t *)APP_VECTORS_ADDR;
+    uint32_t stack = vectors[0];
+    void (*reset_handler)(void) = (void (*)(void))vectors[1];
+
+    __asm volatile ("cpsid i" ::: "memory");
+
+    /* Undo what the bootloader set up */
+    DMA1_S0->CR = 0;
+    RCC->AHB2ENR &= ~RCC_AHB2ENR_HASHEN;
+
+    /* ✏️ YOUR TURN: Interrupts must now use the application's table */
+    SCB_VTOR = ???;                     /* HINT: Where does the application start? */
+
+    __asm volatile ("dsb\n isb" ::: "memory");
+    __asm volatile ("msr msp, %0" : : "r" (stack) : "memory");
+    __asm volatile ("cpsie i" ::: "memory");
+
+    reset_handler();
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * SCB_VTOR = APP_VECTORS_ADDR;
+ * 
+ * WHY 1 KB ALIGNED? VTOR ignores the low bits; the H7 table has over 150
+ * entries (more than 512 bytes), so it must start on a 1024-byte boundary.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void LED_Init(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOBEN;
+
+    GPIOB->MODER &= ~((3U << (LED_GREEN_PIN * 2)) | (3U << (LED_RED_PIN * 2)));
+    GPIOB->MODER |= (1U << (LED_GREEN_PIN * 2)) | (1U << (LED_RED_PIN * 2));
+    GPIOB->BSRR = (1U << (LED_GREEN_PIN + 16)) | (1U << (LED_RED_PIN + 16));
+}
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - Check ourselves, check the application, boot or stop
+ * 
+ * ============================================================================ */
+
+int main(void)
+{
+    LED_Init();
+    Cycles_Init();
+    Hash_InitHardware();
+
+    boot_self_test_ok = (Boot_SelfTest() == 0);
+
+    boot_result = Boot_VerifyImage();
+    if (boot_self_test_ok && boot_result == BOOT_OK) {
+        GPIOB->BSRR = (1U << LED_GREEN_PIN);
+        Boot_JumpToApp();
+    }
+
+    /* Rejected: never run it. Wait here for a debugger or a new download. */
+    GPIOB->BSRR = (1U << LED_RED_PIN);
+    for (;;) {
+        __asm volatile ("wfi");
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've built a secure-boot verifier without HAL:
+ * 
+ *  ✅ A signed image layout that covers size and version too
+ *  ✅ SHA-256 on the HASH unit, fed by the CPU and by DMA in 256 KB chunks
+ *  ✅ The same SHA-256 in plain C - for the PC and as a cross-check
+ *  ✅ Montgomery multiplication: 256-bit modular maths on 32-bit words
+ *  ✅ ECDSA P-256 verification with Shamir's trick
+ *  ✅ A timed boot decision and a clean jump to the application
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Flip one byte of the application with the debugger - red LED
+ *  • Refuse versions lower than one stored in the last flash sector
+ *    (anti-rollback) - remember to sign the new version number
+ *  • Start the ECDSA range checks and Point_FromBytes while the DMA is
+ *    still feeding the HASH unit
+ *  • Lock sector 0 with write protection so the bootloader and its key
+ *    cannot be replaced from the application
+ * 
+ * ============================================================================ */
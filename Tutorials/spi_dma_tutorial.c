@@ -0,0 +1,848 @@
+/**
+ ******************************************************************************
+ * @file           : spi_dma_tutorial.c
+ * @brief          : Learning a DMA-driven SPI bus manager without HAL
+ ******************************************************************************
+ * 
+ *  ███████╗██████╗ ██╗    ██████╗ ███╗   ███╗ █████╗ 
+ *  ██╔════╝██╔══██╗██║    ██╔══██╗████╗ ████║██╔══██╗
+ *  ███████╗██████╔╝██║    ██║  ██║██╔████╔██║███████║
+ *  ╚════██║██╔═══╝ ██║    ██║  ██║██║╚██╔╝██║██╔══██║
+ *  ███████║██║     ██║    ██████╔╝██║ ╚═╝ ██║██║  ██║
+ *  ╚══════╝╚═╝     ╚═╝    ╚═════╝ ╚═╝     ╚═╝╚═╝  ╚═╝
+ * 
+ *  INTERACTIVE LEARNING: SPI + DMA (Shared Bus, Queued Transactions)
+ * 
+ *  WHAT YOU'LL LEARN:
+ *  1. How to describe an SPI transaction as a data structure
+ *  2. How to queue transactions from several drivers on ONE bus
+ *  3. How to move the bytes with DMA (TX and RX streams via DMAMUX)
+ *  4. How to switch CPOL/CPHA/baud rate per device between transactions
+ *  5. How to drive chip select by hardware (NSS) or software (GPIO)
+ *  6. How to finish a transaction on EOT and fire a completion callback
+ * 
+ *  PREREQUISITES:
+ *  - Complete the SPI tutorial first! (TSIZE, TXP/RXP, EOT)
+ *  - Complete the DMA tutorial (streams, DMAMUX, flags)
+ * 
+ *  HARDWARE:
+ *  - SPI1: PA5 = SCK, PA6 = MISO, PA7 = MOSI (AF5)
+ *  - PA4  = SPI1_NSS (AF5)  → ADC        (hardware chip select)
+ *  - PD14 = GPIO            → SPI flash  (software chip select)
+ *  - PD15 = GPIO            → Display    (software chip select)
+ * 
+ *  DIFFICULTY: ⭐⭐⭐⭐ (Advanced)
+ * 
+ ******************************************************************************
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * 
+ *  LESSON 0: ONE BUS, THREE DEVICES
+ *  =================================
+ * 
+ *              ┌──────────┐
+ *              │  STM32   │── SCK/MOSI/MISO ──┬───────────┬────────────┐
+ *              │  SPI1    │                   │           │            │
+ *              │          │── NSS (PA4) ───► ADC          │            │
+ *              │          │── PD14 ────────────────────► FLASH         │
+ *              │          │── PD15 ─────────────────────────────────► DISPLAY
+ *              └──────────┘
+ * 
+ *  ┌──────────┬──────┬──────────┬────────────────────────────────────┐
+ *  │ Device   │ Mode │ SCK      │ Typical traffic                    │
+ *  ├──────────┼──────┼──────────┼────────────────────────────────────┤
+ *  │ ADC      │ 3    │ /16      │ 3 bytes every 1 ms (full duplex)   │
+ *  │ Flash    │ 0    │ /4       │ 4 + 256 bytes (command + data)     │
+ *  │ Display  │ 0    │ /2       │ Kilobytes of pixels (TX only)      │
+ *  └──────────┴──────┴──────────┴────────────────────────────────────┘
+ * 
+ *  With polled SPI the CPU sits in a while(!TXP) loop for every byte of
+ *  every device. A 4 KB display update at 16 MHz SCK = 2 ms of CPU time
+ *  spent doing NOTHING.
+ * 
+ *  THE IDEA:
+ * 
+ *  Driver ──► SPI_Bus_Submit(&txn) ──► [ queue ] ──► DMA + SPI ──► EOT IRQ
+ *                  returns at once                                   │
+ *                                                                    ▼
+ *                                   start next txn ◄── callback(&txn)
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  PERIPHERAL BASE ADDRESSES
+ * ============================================================================ */
+#define RCC_BASE        0x58024400UL
+#define GPIOA_BASE      0x58020000UL
+#define GPIOB_BASE      0x58020400UL
+#define GPIOD_BASE      0x58020C00UL
+#define SPI1_BASE       0x40013000UL
+#define DMA1_BASE       0x40020000UL
+#define DMAMUX1_BASE    0x40020800UL
+
+/* DMA1 streams used here */
+#define DMA1_Stream0    (DMA1_BASE + 0x010)     /* SPI1 RX */
+#define DMA1_Stream1    (DMA1_BASE + 0x028)     /* SPI1 TX */
+
+#define NVIC_ISER_BASE  0xE000E100UL
+
+/* ============================================================================
+ *  REGISTER STRUCTURES
+ * ============================================================================ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t HSICFGR;
+    volatile uint32_t CRRCR;
+    volatile uint32_t CSICFGR;
+    volatile uint32_t CFGR;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t D1CFGR;
+    volatile uint32_t D2CFGR;
+    volatile uint32_t D3CFGR;
+    volatile uint32_t RESERVED2;
+    volatile uint32_t PLLCKSELR;
+    volatile uint32_t PLLCFGR;
+    volatile uint32_t PLL1DIVR;
+    volatile uint32_t PLL1FRACR;
+    volatile uint32_t PLL2DIVR;
+    volatile uint32_t PLL2FRACR;
+    volatile uint32_t PLL3DIVR;
+    volatile uint32_t PLL3FRACR;
+    volatile uint32_t RESERVED3;
+    volatile uint32_t D1CCIPR;
+    volatile uint32_t D2CCIP1R;
+    volatile uint32_t D2CCIP2R;
+    volatile uint32_t D3CCIPR;
+    volatile uint32_t RESERVED4;
+    volatile uint32_t CIER;
+    volatile uint32_t CIFR;
+    volatile uint32_t CICR;
+    volatile uint32_t RESERVED5;
+    volatile uint32_t BDCR;
+    volatile uint32_t CSR;
+    volatile uint32_t RESERVED6;
+    volatile uint32_t AHB3RSTR;
+    volatile uint32_t AHB1RSTR;
+    volatile uint32_t AHB2RSTR;
+    volatile uint32_t AHB4RSTR;
+    volatile uint32_t APB3RSTR;
+    volatile uint32_t APB1LRSTR;
+    volatile uint32_t APB1HRSTR;
+    volatile uint32_t APB2RSTR;
+    volatile uint32_t APB4RSTR;
+    volatile uint32_t GCR;
+    volatile uint32_t RESERVED7;
+    volatile uint32_t D3AMR;
+    volatile uint32_t RESERVED8[9];
+    volatile uint32_t RSR;
+    volatile uint32_t AHB3ENR;
+    volatile uint32_t AHB1ENR;
+    volatile uint32_t AHB2ENR;
+    volatile uint32_t AHB4ENR;
+    volatile uint32_t APB3ENR;
+    volatile uint32_t APB1LENR;
+    volatile uint32_t APB1HENR;
+    volatile uint32_t APB2ENR;
+    volatile uint32_t APB4ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1;      /* 0x00 - Control register 1 */
+    volatile uint32_t CR2;      /* 0x04 - Control register 2 (TSIZE) */
+    volatile uint32_t CFG1;     /* 0x08 - Configuration register 1 */
+    volatile uint32_t CFG2;     /* 0x0C - Configuration register 2 */
+    volatile uint32_t IER;      /* 0x10 - Interrupt enable register */
+    volatile uint32_t SR;       /* 0x14 - Status register */
+    volatile uint32_t IFCR;     /* 0x18 - Interrupt flag clear register */
+    volatile uint32_t RESERVED0;/* 0x1C */
+    volatile uint32_t TXDR;     /* 0x20 - Transmit data register */
+    volatile uint32_t RESERVED1[3];
+    volatile uint32_t RXDR;     /* 0x30 - Receive data register */
+} SPI_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR;       /* Configuration register */
+    volatile uint32_t NDTR;     /* Number of data register */
+    volatile uint32_t PAR;      /* Peripheral address register */
+    volatile uint32_t M0AR;     /* Memory 0 address register */
+    volatile uint32_t M1AR;     /* Memory 1 address register */
+    volatile uint32_t FCR;      /* FIFO control register */
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    volatile uint32_t LISR;     /* Low interrupt status register */
+    volatile uint32_t HISR;     /* High interrupt status register */
+    volatile uint32_t LIFCR;    /* Low interrupt flag clear register */
+    volatile uint32_t HIFCR;    /* High interrupt flag clear register */
+} DMA_TypeDef;
+
+#define RCC         ((RCC_TypeDef *) RCC_BASE)
+#define GPIOA       ((GPIO_TypeDef *) GPIOA_BASE)
+#define GPIOB       ((GPIO_TypeDef *) GPIOB_BASE)
+#define GPIOD       ((GPIO_TypeDef *) GPIOD_BASE)
+#define SPI1        ((SPI_TypeDef *) SPI1_BASE)
+#define DMA1        ((DMA_TypeDef *) DMA1_BASE)
+#define DMA1_S0     ((DMA_Stream_TypeDef *) DMA1_Stream0)
+#define DMA1_S1     ((DMA_Stream_TypeDef *) DMA1_Stream1)
+
+/* DMAMUX1 channel n feeds DMA1 stream n (one CCR per channel, 4 bytes apart) */
+#define DMAMUX1_CCR ((volatile uint32_t *) DMAMUX1_BASE)
+
+#define NVIC_ISER   ((volatile uint32_t *) NVIC_ISER_BASE)
+
+/* ============================================================================
+ *  BIT DEFINITIONS
+ * ============================================================================ */
+
+/* RCC */
+#define RCC_AHB4ENR_GPIOAEN     (1U << 0)
+#define RCC_AHB4ENR_GPIOBEN     (1U << 1)
+#define RCC_AHB4ENR_GPIODEN     (1U << 3)
+#define RCC_AHB1ENR_DMA1EN      (1U << 0)
+#define RCC_APB2ENR_SPI1EN      (1U << 12)
+
+/* SPI_CR1 */
+#define SPI_CR1_SPE             (1U << 0)   /* SPI enable */
+#define SPI_CR1_CSTART          (1U << 9)   /* Master transfer start */
+#define SPI_CR1_SSI             (1U << 12)  /* Internal SS level (SSM = 1) */
+
+/* SPI_CFG1 */
+#define SPI_CFG1_DSIZE_8BIT     (7U << 0)   /* 8-bit frames */
+#define SPI_CFG1_RXDMAEN        (1U << 14)  /* RX DMA request enable */
+#define SPI_CFG1_TXDMAEN        (1U << 15)  /* TX DMA request enable */
+#define SPI_CFG1_MBR_Pos        28U         /* Baud rate: SPI clock / 2^(MBR+1) */
+#define SPI_CFG1_MBR_Msk        (7U << 28)
+
+/* SPI_CFG2 */
+#define SPI_CFG2_COMM_FULLDUPLEX (0U << 17)
+#define SPI_CFG2_COMM_SIMPLEX_TX (1U << 17)
+#define SPI_CFG2_COMM_SIMPLEX_RX (2U << 17)
+#define SPI_CFG2_COMM_Msk       (3U << 17)
+#define SPI_CFG2_MASTER         (1U << 22)  /* Master mode */
+#define SPI_CFG2_LSBFRST        (1U << 23)  /* LSB first */
+#define SPI_CFG2_CPHA           (1U << 24)  /* Clock phase */
+#define SPI_CFG2_CPOL           (1U << 25)  /* Clock polarity */
+#define SPI_CFG2_SSM            (1U << 26)  /* Software slave management */
+#define SPI_CFG2_SSOE           (1U << 29)  /* NSS output enable (hardware CS) */
+#define SPI_CFG2_AFCNTR         (1U << 31)  /* Keep driving pins while SPE = 0 */
+
+/* SPI_IER / SPI_SR / SPI_IFCR */
+#define SPI_IER_EOTIE           (1U << 3)   /* End of transfer interrupt */
+#define SPI_SR_EOT              (1U << 3)
+#define SPI_SR_UDR              (1U << 5)
+#define SPI_SR_OVR              (1U << 6)
+#define SPI_IFCR_ALL            0x00000FF8U /* EOTC..SUSPC */
+
+/* DMA_SxCR */
+#define DMA_CR_EN               (1U << 0)
+#define DMA_CR_TEIE             (1U << 2)
+#define DMA_CR_DIR_P2M          (0U << 6)
+#define DMA_CR_DIR_M2P          (1U << 6)
+#define DMA_CR_MINC             (1U << 10)
+#define DMA_CR_PSIZE_8          (0U << 11)
+#define DMA_CR_MSIZE_8          (0U << 13)
+#define DMA_CR_PL_HIGH          (2U << 16)
+
+/* DMA LISR / LIFCR: stream 0 flags at bit 0, stream 1 flags at bit 6 */
+#define DMA_FLAGS_ALL           0x3DU       /* FEIF | DMEIF | TEIF | HTIF | TCIF */
+#define DMA_FLAG_TEIF           0x08U
+#define DMA_S0_SHIFT            0U
+#define DMA_S1_SHIFT            6U
+
+/* DMAMUX request IDs */
+#define DMAMUX_REQ_SPI1_RX      37
+#define DMAMUX_REQ_SPI1_TX      38
+
+/* NVIC IRQ numbers */
+#define DMA1_Stream0_IRQn       11
+#define DMA1_Stream1_IRQn       12
+#define SPI1_IRQn               35
+
+/* GPIO */
+#define GPIO_AF5_SPI1           5U
+#define CS_FLASH_PIN            14          /* PD14 */
+#define CS_DISPLAY_PIN          15          /* PD15 */
+#define LED_GREEN_PIN           0           /* PB0 */
+
+/* ============================================================================
+ * 
+ *  LESSON 1: DEVICES AND TRANSACTIONS AS DATA
+ *  ===========================================
+ * 
+ *  A DEVICE says HOW to talk to a chip:
+ *  • SPI mode 0-3   → CPOL = bit 1, CPHA = bit 0
+ *  • baud divider   → MBR (SPI clock / 2, /4, ... /256)
+ *  • chip select    → hardware NSS, or a GPIO port + pin
+ * 
+ *  A TRANSACTION says WHAT to send:
+ *  • which device
+ *  • tx buffer, rx buffer (either may be NULL), length
+ *  • callback + context, called from the EOT interrupt
+ *  • status, written by the engine
+ * 
+ *  The caller OWNS the transaction struct and its buffers, and must not
+ *  touch them until the callback has run (or status is DONE / ERROR).
+ *  That way the queue only stores pointers - no copying, no malloc.
+ * 
+ * ============================================================================ */
+
+typedef enum {
+    SPI_MBR_DIV2   = 0,
+    SPI_MBR_DIV4   = 1,
+    SPI_MBR_DIV8   = 2,
+    SPI_MBR_DIV16  = 3,
+    SPI_MBR_DIV32  = 4,
+    SPI_MBR_DIV64  = 5,
+    SPI_MBR_DIV128 = 6,
+    SPI_MBR_DIV256 = 7
+} SPI_Baud_t;
+
+typedef struct {
+    GPIO_TypeDef *cs_port;      /* Software CS port (NULL = hardware NSS) */
+    uint8_t cs_pin;             /* Software CS pin */
+    uint8_t mode;               /* SPI mode 0..3 */
+    SPI_Baud_t baud;            /* Clock divider */
+} SPI_Device_t;
+
+typedef enum {
+    SPI_TXN_IDLE,               /* Never submitted / recycled */
+    SPI_TXN_QUEUED,             /* Waiting for the bus */
+    SPI_TXN_ACTIVE,             /* On the wire right now */
+    SPI_TXN_DONE,               /* Finished OK */
+    SPI_TXN_ERROR               /* Overrun, underrun or DMA error */
+} SPI_TxnStatus_t;
+
+struct SPI_Txn;
+typedef void (*SPI_Callback_t)(struct SPI_Txn *txn);
+
+typedef struct SPI_Txn {
+    const SPI_Device_t *dev;    /* Who */
+    const uint8_t *tx;          /* NULL = receive only */
+    uint8_t *rx;                /* NULL = transmit only */
+    uint16_t len;               /* Bytes (1..65535) */
+    SPI_Callback_t callback;    /* Called from the ISR, may be NULL */
+    void *context;              /* Free for the driver */
+    volatile SPI_TxnStatus_t status;
+} SPI_Txn_t;
+
+/* ============================================================================
+ * 
+ *  LESSON 2: DMA-REACHABLE MEMORY
+ *  ===============================
+ * 
+ *  On the H7, DMA1/DMA2 sit in the D2 domain and can NOT reach the DTCM
+ *  RAM at 0x2000 0000 - which is where many linker scripts put .data,
+ *  .bss and the stack!
+ * 
+ *  ┌───────────────┬──────────────┬───────────────────┐
+ *  │ Memory        │ Address      │ DMA1/DMA2 access? │
+ *  ├───────────────┼──────────────┼───────────────────┤
+ *  │ DTCM          │ 0x2000 0000  │ ✗ NO              │
+ *  │ AXI SRAM      │ 0x2400 0000  │ ✓ yes             │
+ *  │ SRAM1/2/3     │ 0x3000 0000  │ ✓ yes             │
+ *  │ SRAM4         │ 0x3800 0000  │ ✓ yes             │
+ *  └───────────────┴──────────────┴───────────────────┘
+ * 
+ *  Put SPI buffers in AXI SRAM or SRAM1-3 (check your .map file).
+ *  If you enable the D-cache (Cortex tutorial), clean TX buffers before
+ *  a transaction and invalidate RX buffers after it.
+ * 
+ * ============================================================================ */
+
+/* ============================================================================
+ *  GLOBAL STATE
+ * ============================================================================ */
+
+#define SPI_QUEUE_SIZE          8U      /* Must be a power of 2 */
+
+SPI_Txn_t *spi_queue[SPI_QUEUE_SIZE];
+volatile uint8_t spi_queue_head = 0;    /* Written by Submit */
+volatile uint8_t spi_queue_tail = 0;    /* Written by the ISR */
+
+SPI_Txn_t *volatile spi_active = NULL;  /* Transaction on the wire */
+
+/* Statistics - watch them in the debugger */
+volatile uint32_t spi_txn_completed = 0;
+volatile uint32_t spi_txn_errors = 0;
+
+/* ============================================================================
+ * 
+ *  STEP 1: CLOCKS, PINS AND STATIC SPI SETUP
+ *  ==========================================
+ * 
+ *  AFCNTR = 1 keeps SCK/MOSI driven while SPE = 0. We disable the SPI
+ *  between transactions to change CPOL/CPHA, and without AFCNTR the
+ *  clock line would float and a device could see a false edge.
+ * 
+ * ============================================================================ */
+
+void SPI_Bus_InitHardware(void) {
+    RCC->AHB4ENR |= RCC_AHB4ENR_GPIOAEN | RCC_AHB4ENR_GPIOBEN | RCC_AHB4ENR_GPIODEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB2ENR |= RCC_APB2ENR_SPI1EN;
+    (void)RCC->APB2ENR;
+
+    /* PA4..PA7 → AF5 (NSS, SCK, MISO, MOSI), high speed */
+    for (uint32_t pin = 4; pin <= 7; pin++) {
+        GPIOA->MODER &= ~(3U << (pin * 2));
+        GPIOA->MODER |= (2U << (pin * 2));
+        GPIOA->AFR[0] &= ~(0xFU << (pin * 4));
+        GPIOA->AFR[0] |= (GPIO_AF5_SPI1 << (pin * 4));
+        GPIOA->OSPEEDR |= (3U << (pin * 2));
+    }
+
+    /* Software chip selects: output, idle HIGH */
+    GPIOD->BSRR = (1U << CS_FLASH_PIN) | (1U << CS_DISPLAY_PIN);
+    GPIOD->MODER &= ~((3U << (CS_FLASH_PIN * 2)) | (3U << (CS_DISPLAY_PIN * 2)));
+    GPIOD->MODER |= (1U << (CS_FLASH_PIN * 2)) | (1U << (CS_DISPLAY_PIN * 2));
+
+    /* Status LED */
+    GPIOB->MODER &= ~(3U << (LED_GREEN_PIN * 2));
+    GPIOB->MODER |= (1U << (LED_GREEN_PIN * 2));
+
+    SPI1->CR1 = 0;
+    SPI1->CFG1 = SPI_CFG1_DSIZE_8BIT;
+    SPI1->CFG2 = SPI_CFG2_MASTER | SPI_CFG2_AFCNTR;
+
+    /* DMA stream → request routing, done once */
+    DMAMUX1_CCR[0] = DMAMUX_REQ_SPI1_RX;    /* Stream 0 = SPI1 RX */
+    DMAMUX1_CCR[1] = DMAMUX_REQ_SPI1_TX;    /* Stream 1 = SPI1 TX */
+
+    NVIC_ISER[SPI1_IRQn / 32] = (1U << (SPI1_IRQn % 32));
+    NVIC_ISER[DMA1_Stream0_IRQn / 32] = (1U << (DMA1_Stream0_IRQn % 32));
+    NVIC_ISER[DMA1_Stream1_IRQn / 32] = (1U << (DMA1_Stream1_IRQn % 32));
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 1: PER-DEVICE CONFIGURATION
+ *  =========================================
+ * 
+ *  Called with SPE = 0 before every transaction. It costs a handful of
+ *  register writes, so switching devices is practically free.
+ * 
+ *  Chip select:
+ *  • Hardware (cs_port == NULL): SSM = 0, SSOE = 1 → SPI1 pulls NSS low
+ *    while SPE = 1 and releases it when we clear SPE at EOT.
+ *  • Software: SSM = 1, SSI = 1 (tell the SPI "you are selected as
+ *    master", else it reports a mode fault), and we drive the GPIO.
+ * 
+ * ============================================================================ */
+
+void SPI_Bus_ApplyDevice(const SPI_Device_t *dev, uint32_t comm) {
+    uint32_t cfg2 = SPI_CFG2_MASTER | SPI_CFG2_AFCNTR | comm;
+
+    /* ✏️ YOUR TURN: CPOL from mode bit 1, CPHA from mode bit 0 */
+    if (dev->mode & 2U) cfg2 |= ???;    /* HINT: Clock idles high */
+    if (dev->mode & 1U) cfg2 |= ???;    /* HINT: Sample on the second edge */
+
+    if (dev->cs_port == NULL) {
+        cfg2 |= SPI_CFG2_SSOE;
+        SPI1->CR1 &= ~SPI_CR1_SSI;
+    } else {
+        cfg2 |= SPI_CFG2_SSM;
+        SPI1->CR1 |= SPI_CR1_SSI;
+    }
+    SPI1->CFG2 = cfg2;
+
+    /* ✏️ YOUR TURN: Baud rate divider */
+    SPI1->CFG1 = (SPI1->CFG1 & ~SPI_CFG1_MBR_Msk)
+               | ((uint32_t)??? << SPI_CFG1_MBR_Pos);  /* HINT: From the device */
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (dev->mode & 2U) cfg2 |= SPI_CFG2_CPOL;
+ * if (dev->mode & 1U) cfg2 |= SPI_CFG2_CPHA;
+ * SPI1->CFG1 = (SPI1->CFG1 & ~SPI_CFG1_MBR_Msk)
+ *            | ((uint32_t)dev->baud << SPI_CFG1_MBR_Pos);
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void SPI_Bus_CS(const SPI_Device_t *dev, uint8_t select) {
+    if (dev->cs_port == NULL) {
+        return;                         /* Hardware NSS does it */
+    }
+    if (select) {
+        dev->cs_port->BSRR = (1U << (dev->cs_pin + 16));   /* LOW */
+    } else {
+        dev->cs_port->BSRR = (1U << dev->cs_pin);          /* HIGH */
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 2: START A TRANSACTION WITH DMA
+ *  =============================================
+ * 
+ *  The reference manual gives a strict order for SPI + DMA:
+ * 
+ *  1. SPE = 0, configure SPI (device settings, COMM, TSIZE)
+ *  2. Enable RX DMA request (RXDMAEN)     ← RX FIRST, or early bytes
+ *  3. Configure and enable the DMA streams  are lost
+ *  4. Enable TX DMA request (TXDMAEN)
+ *  5. SPE = 1
+ *  6. CSTART = 1
+ * 
+ *  We finish on the SPI's EOT interrupt, NOT the DMA's transfer-complete:
+ *  the TX DMA is "done" when the last byte is in the FIFO, long before
+ *  it has left the MOSI pin. Releasing CS at that point cuts it off.
+ * 
+ * ============================================================================ */
+
+void SPI_Bus_Start(SPI_Txn_t *txn) {
+    uint32_t comm;
+
+    comm = (txn->tx && txn->rx) ? SPI_CFG2_COMM_FULLDUPLEX
+         : txn->tx              ? SPI_CFG2_COMM_SIMPLEX_TX
+         :                        SPI_CFG2_COMM_SIMPLEX_RX;
+
+    /* 1. Configure with SPE = 0 */
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CFG1 &= ~(SPI_CFG1_RXDMAEN | SPI_CFG1_TXDMAEN);
+    SPI_Bus_ApplyDevice(txn->dev, comm);
+    SPI1->CR2 = txn->len;               /* TSIZE = whole transaction */
+    SPI1->IFCR = SPI_IFCR_ALL;
+    SPI1->IER = SPI_IER_EOTIE;
+
+    DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S0_SHIFT) | (DMA_FLAGS_ALL << DMA_S1_SHIFT);
+
+    /* 2 + 3. RX side first */
+    if (txn->rx) {
+        /* ✏️ YOUR TURN: Enable the SPI RX DMA request */
+        SPI1->CFG1 |= ???;              /* HINT: RX DMA enable bit in CFG1 */
+
+        DMA1_S0->CR = 0;
+        DMA1_S0->PAR = (uint32_t)&SPI1->RXDR;
+        DMA1_S0->M0AR = (uint32_t)txn->rx;
+        DMA1_S0->NDTR = txn->len;
+        DMA1_S0->CR = DMA_CR_DIR_P2M | DMA_CR_MINC | DMA_CR_PSIZE_8
+                    | DMA_CR_MSIZE_8 | DMA_CR_PL_HIGH | DMA_CR_TEIE;
+        DMA1_S0->CR |= DMA_CR_EN;
+    }
+
+    /* 3 + 4. TX side */
+    if (txn->tx) {
+        DMA1_S1->CR = 0;
+        DMA1_S1->PAR = (uint32_t)&SPI1->TXDR;
+        DMA1_S1->M0AR = (uint32_t)txn->tx;
+        DMA1_S1->NDTR = txn->len;
+        DMA1_S1->CR = DMA_CR_DIR_M2P | DMA_CR_MINC | DMA_CR_PSIZE_8
+                    | DMA_CR_MSIZE_8 | DMA_CR_PL_HIGH | DMA_CR_TEIE;
+
+        /* ✏️ YOUR TURN: Enable the TX stream, then the SPI TX DMA request */
+        DMA1_S1->CR |= ???;             /* HINT: Stream enable bit */
+        SPI1->CFG1 |= ???;              /* HINT: TX DMA enable bit in CFG1 */
+    }
+
+    /* 5 + 6. Select, enable, go */
+    txn->status = SPI_TXN_ACTIVE;
+    SPI_Bus_CS(txn->dev, 1);
+    SPI1->CR1 |= SPI_CR1_SPE;
+    SPI1->CR1 |= SPI_CR1_CSTART;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * SPI1->CFG1 |= SPI_CFG1_RXDMAEN;
+ * DMA1_S1->CR |= DMA_CR_EN;
+ * SPI1->CFG1 |= SPI_CFG1_TXDMAEN;
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 3: FINISHING AND CHAINING
+ *  ===============================
+ * 
+ *  Runs in interrupt context. Close the hardware, release CS, tell the
+ *  driver, then immediately start the next queued transaction so the
+ *  bus never sits idle while work is waiting.
+ * 
+ * ============================================================================ */
+
+void SPI_Bus_StartNext(void) {
+    if (spi_queue_tail == spi_queue_head) {
+        spi_active = NULL;              /* Bus idle */
+        return;
+    }
+    spi_active = spi_queue[spi_queue_tail];
+    spi_queue_tail = (spi_queue_tail + 1) & (SPI_QUEUE_SIZE - 1);
+    SPI_Bus_Start(spi_active);
+}
+
+void SPI_Bus_Finish(SPI_TxnStatus_t status) {
+    SPI_Txn_t *txn = spi_active;
+
+    /* Stop DMA streams and SPI; clearing SPE also releases hardware NSS */
+    DMA1_S0->CR &= ~DMA_CR_EN;
+    DMA1_S1->CR &= ~DMA_CR_EN;
+    SPI1->IER = 0;
+    SPI1->IFCR = SPI_IFCR_ALL;
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CFG1 &= ~(SPI_CFG1_RXDMAEN | SPI_CFG1_TXDMAEN);
+
+    if (txn == NULL) {
+        return;
+    }
+
+    SPI_Bus_CS(txn->dev, 0);
+    txn->status = status;
+
+    if (status == SPI_TXN_DONE) {
+        spi_txn_completed++;
+    } else {
+        spi_txn_errors++;
+    }
+
+    if (txn->callback) {
+        txn->callback(txn);
+    }
+
+    SPI_Bus_StartNext();
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 3: THE INTERRUPT HANDLERS
+ *  =======================================
+ * 
+ *  SPI1: EOT means every byte has been shifted out AND in.
+ *  DMA:  only the transfer-error flag matters (bus error / bad address,
+ *        e.g. a buffer in DTCM!).
+ * 
+ * ============================================================================ */
+
+void SPI1_IRQHandler(void) {
+    uint32_t sr = SPI1->SR;
+
+    /* ✏️ YOUR TURN: Only act on end of transfer */
+    if (sr & ???) {                     /* HINT: End-of-transfer flag */
+        if (sr & (SPI_SR_OVR | SPI_SR_UDR)) {
+            SPI_Bus_Finish(SPI_TXN_ERROR);
+        } else {
+            SPI_Bus_Finish(SPI_TXN_DONE);
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (sr & SPI_SR_EOT) {
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+void DMA1_Stream0_IRQHandler(void) {
+    if (DMA1->LISR & (DMA_FLAG_TEIF << DMA_S0_SHIFT)) {
+        DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S0_SHIFT);
+        SPI_Bus_Finish(SPI_TXN_ERROR);
+    }
+}
+
+void DMA1_Stream1_IRQHandler(void) {
+    if (DMA1->LISR & (DMA_FLAG_TEIF << DMA_S1_SHIFT)) {
+        DMA1->LIFCR = (DMA_FLAGS_ALL << DMA_S1_SHIFT);
+        SPI_Bus_Finish(SPI_TXN_ERROR);
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 4: SUBMITTING A TRANSACTION
+ *  =========================================
+ * 
+ *  Called from the main loop OR from a callback (e.g. the ADC callback
+ *  queues the next conversion). The ISR also touches the queue and
+ *  spi_active, so this short block runs with interrupts masked.
+ * 
+ *  Returns 0 if queued, -1 if the queue is full or the txn is invalid.
+ * 
+ * ============================================================================ */
+
+int SPI_Bus_Submit(SPI_Txn_t *txn) {
+    uint32_t primask;
+    uint8_t next;
+    int result = 0;
+
+    if (txn == NULL || txn->dev == NULL || txn->len == 0 || (!txn->tx && !txn->rx)) {
+        return -1;
+    }
+
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask));
+    __asm volatile ("CPSID i" : : : "memory");
+
+    next = (spi_queue_head + 1) & (SPI_QUEUE_SIZE - 1);
+
+    /* ✏️ YOUR TURN: Queue full? */
+    if (next == ???) {                  /* HINT: Writer caught up with the reader */
+        result = -1;
+    } else {
+        txn->status = SPI_TXN_QUEUED;
+        spi_queue[spi_queue_head] = txn;
+        spi_queue_head = next;
+
+        /* Bus idle → kick it; otherwise the EOT ISR will get to us */
+        if (spi_active == NULL) {
+            SPI_Bus_StartNext();
+        }
+    }
+
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+    return result;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * if (next == spi_queue_tail) {
+ * 
+ * WHY IS CALLING Submit() FROM A CALLBACK SAFE?
+ *   The callback runs inside SPI_Bus_Finish(), BEFORE StartNext(). The
+ *   bus is not idle yet (spi_active still points at the old txn), so
+ *   Submit() only queues - StartNext() then picks it up.
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* Spin until a transaction is finished (for code that must be blocking) */
+SPI_TxnStatus_t SPI_Bus_Wait(SPI_Txn_t *txn) {
+    while (txn->status == SPI_TXN_QUEUED || txn->status == SPI_TXN_ACTIVE) {
+        __asm("wfi");
+    }
+    return txn->status;
+}
+
+/* ============================================================================
+ * 
+ *  STEP 4: THE THREE DRIVERS
+ *  ==========================
+ * 
+ * ============================================================================ */
+
+const SPI_Device_t dev_adc     = { .cs_port = NULL,  .mode = 3, .baud = SPI_MBR_DIV16 };
+const SPI_Device_t dev_flash   = { .cs_port = GPIOD, .cs_pin = CS_FLASH_PIN,
+                                   .mode = 0, .baud = SPI_MBR_DIV4 };
+const SPI_Device_t dev_display = { .cs_port = GPIOD, .cs_pin = CS_DISPLAY_PIN,
+                                   .mode = 0, .baud = SPI_MBR_DIV2 };
+
+/* ─── ADC: 3-byte conversion, re-queued from its own callback ─── */
+uint8_t adc_tx[3] = { 0x06, 0x00, 0x00 };  /* Start, single-ended, channel 0 */
+uint8_t adc_rx[3];
+volatile uint16_t adc_value = 0;
+volatile uint32_t adc_samples = 0;
+volatile uint8_t adc_running = 1;
+
+void ADC_OnDone(SPI_Txn_t *txn) {
+    if (txn->status == SPI_TXN_DONE) {
+        adc_value = (uint16_t)(((adc_rx[1] & 0x0FU) << 8) | adc_rx[2]);
+        adc_samples++;
+    }
+    if (adc_running) {
+        SPI_Bus_Submit(txn);            /* Continuous conversion */
+    }
+}
+
+SPI_Txn_t adc_txn = { .dev = &dev_adc, .tx = adc_tx, .rx = adc_rx,
+                      .len = sizeof(adc_tx), .callback = ADC_OnDone };
+
+/* ─── Flash: JEDEC ID (0x9F + 3 response bytes) ─── */
+uint8_t flash_tx[4] = { 0x9F, 0x00, 0x00, 0x00 };
+uint8_t flash_rx[4];
+
+SPI_Txn_t flash_txn = { .dev = &dev_flash, .tx = flash_tx, .rx = flash_rx,
+                        .len = sizeof(flash_tx) };
+
+/* ─── Display: a big TX-only frame buffer push ─── */
+#define DISPLAY_BYTES           4096U
+uint8_t display_fb[DISPLAY_BYTES];
+volatile uint32_t display_frames = 0;
+
+void Display_OnDone(SPI_Txn_t *txn) {
+    (void)txn;
+    display_frames++;
+    GPIOB->ODR ^= (1U << LED_GREEN_PIN);
+}
+
+SPI_Txn_t display_txn = { .dev = &dev_display, .tx = display_fb, .rx = NULL,
+                          .len = DISPLAY_BYTES, .callback = Display_OnDone };
+
+/* ============================================================================
+ * 
+ *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
+ *  ██╔══██╗██╔══██╗██╔══██╗██╔════╝╚══██╔══╝██║██╔════╝██╔════╝
+ *  ██████╔╝██████╔╝███████║██║        ██║   ██║██║     █████╗
+ *  ██╔═══╝ ██╔══██╗██╔══██║██║        ██║   ██║██║     ██╔══╝
+ *  ██║     ██║  ██║██║  ██║╚██████╗   ██║   ██║╚██████╗███████╗
+ *  ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚══════╝
+ * 
+ *  MAIN PROGRAM - ADC, flash and display share SPI1 without the CPU
+ * 
+ * ============================================================================ */
+
+volatile uint32_t flash_jedec_id = 0;
+
+int main(void)
+{
+    SPI_Bus_InitHardware();
+
+    for (uint32_t i = 0; i < DISPLAY_BYTES; i++) {
+        display_fb[i] = (uint8_t)i;
+    }
+
+    /* Blocking use is still possible: submit, then wait */
+    SPI_Bus_Submit(&flash_txn);
+    if (SPI_Bus_Wait(&flash_txn) == SPI_TXN_DONE) {
+        flash_jedec_id = ((uint32_t)flash_rx[1] << 16)
+                       | ((uint32_t)flash_rx[2] << 8) | flash_rx[3];
+    }
+
+    /* ADC keeps itself going from its callback */
+    SPI_Bus_Submit(&adc_txn);
+
+    for (;;) {
+        /* Queue a new frame whenever the previous one is out */
+        if (display_txn.status != SPI_TXN_QUEUED && display_txn.status != SPI_TXN_ACTIVE) {
+            SPI_Bus_Submit(&display_txn);
+        }
+
+        /* The CPU is free - all three devices run from interrupts */
+        __asm("wfi");
+    }
+}
+
+/* ============================================================================
+ * 
+ *  🎉 CONGRATULATIONS!
+ * 
+ *  You've built a DMA SPI bus manager without HAL:
+ * 
+ *  ✅ Devices and transactions described as data
+ *  ✅ A pointer queue shared by several drivers on one bus
+ *  ✅ RX/TX DMA streams routed through DMAMUX, in the right order
+ *  ✅ CPOL/CPHA/baud switched per device between transactions
+ *  ✅ Hardware NSS and GPIO chip selects side by side
+ *  ✅ Completion on SPI EOT (not DMA TC) with per-transaction callbacks
+ * 
+ *  🔧 EXPERIMENT IDEAS:
+ * 
+ *  • Add a priority queue so the ADC always jumps ahead of the display
+ *  • Split the display frame into 1 KB chunks so the ADC never waits
+ *    longer than one chunk
+ *  • Move a buffer into DTCM on purpose and watch spi_txn_errors rise
+ *  • Measure CPU load with and without DMA (see Cortex tutorial SysTick)
+ * 
+ * ============================================================================ */
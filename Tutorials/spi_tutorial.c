@@ -18,6 +18,7 @@
  *  2. How to configure GPIO pins for SPI
  *  3. How to configure SPI as Master
  *  4. How to transmit and receive data
+ *  5. How to stream whole buffers through the SPI FIFO (packed frames)
  * 
  *  PREREQUISITES:
  *  - Complete the RCC tutorial first!
@@ -221,8 +222,13 @@ typedef struct {
 
 /* SPI_CFG1 Register */
 /* DSIZE[4:0] = Data size (bits 0-4), value = data_bits - 1 */
+/* FTHLV[3:0] = FIFO threshold (bits 5-8), value = frames_per_packet - 1 */
 /* MBR[2:0] = Baud rate prescaler (bits 28-30) */
 #define SPI_CFG1_DSIZE_8BIT     (7U << 0)   /* 8-bit data (8-1=7) */
+#define SPI_CFG1_DSIZE_Pos      0U
+#define SPI_CFG1_DSIZE_Msk      (0x1FU << 0)
+#define SPI_CFG1_FTHLV_Pos      5U
+#define SPI_CFG1_FTHLV_Msk      (0xFU << 5)
 #define SPI_CFG1_MBR_DIV8       (2U << 28)  /* Clock / 8 */
 #define SPI_CFG1_MBR_DIV32      (4U << 28)  /* Clock / 32 */
 
@@ -232,12 +238,26 @@ typedef struct {
 #define SPI_CFG2_SSM            (1U << 26)  /* Software slave management */
 #define SPI_CFG2_SSOM           (1U << 30)  /* SS output management */
 #define SPI_CFG2_COMM_FULLDUPLEX (0U << 17) /* Full duplex mode */
+#define SPI_CFG2_COMM_SIMPLEX_TX (1U << 17) /* Transmit only */
+#define SPI_CFG2_COMM_SIMPLEX_RX (2U << 17) /* Receive only */
+#define SPI_CFG2_COMM_Msk       (3U << 17)
 
 /* SPI_SR Register Bits */
 #define SPI_SR_TXP              (1U << 1)   /* TX packet space available */
 #define SPI_SR_RXP              (1U << 0)   /* RX packet available */
 #define SPI_SR_EOT              (1U << 3)   /* End of transfer */
 #define SPI_SR_TXTF             (1U << 4)   /* Transmission transfer filled */
+#define SPI_SR_UDR              (1U << 5)   /* Underrun */
+#define SPI_SR_OVR              (1U << 6)   /* Overrun */
+#define SPI_SR_RXPLVL_Pos       13U         /* Frames left in RX FIFO (<= 16 bit) */
+#define SPI_SR_RXPLVL_Msk       (3U << 13)
+#define SPI_SR_RXWNE            (1U << 15)  /* RX FIFO holds a full 32-bit word */
+
+/* SPI_IFCR Register Bits (write 1 to clear) */
+#define SPI_IFCR_EOTC           (1U << 3)
+#define SPI_IFCR_TXTFC          (1U << 4)
+#define SPI_IFCR_UDRC           (1U << 5)
+#define SPI_IFCR_OVRC           (1U << 6)
 
 /* GPIO Alternate Function */
 #define GPIO_AF5_SPI1           5U          /* AF5 = SPI1 */
@@ -542,6 +562,391 @@ uint8_t SPI_ReadRegister(uint8_t reg) {
  * }
  * ───────────────────────────────────────────────────────────────────────────── */
 
+/* ============================================================================
+ * 
+ *  LESSON 5: WHY ONE BYTE AT A TIME IS SLOW
+ *  =========================================
+ * 
+ *  SPI_Transfer() runs a COMPLETE transaction for every byte:
+ * 
+ *      TSIZE=1 → CSTART → wait TXP → write → wait RXP → read
+ *              → wait EOT → clear flags
+ * 
+ *  Between two bytes SCK stops while the CPU does all that bookkeeping:
+ * 
+ *  SCK:  ▌▌▌▌▌▌▌▌ ............ ▌▌▌▌▌▌▌▌ ............ ▌▌▌▌▌▌▌▌
+ *        byte 0    (overhead)   byte 1    (overhead)   byte 2
+ * 
+ *  SPI_ReadRegister() needs TWO such transactions, and reading a 6-byte
+ *  accelerometer burst with it would need SIX.
+ * 
+ *  The H7 SPI was built for streaming instead:
+ * 
+ *  ┌──────────────┬──────────────────────────────────────────────┐
+ *  │ Feature      │ What it gives us                             │
+ *  ├──────────────┼──────────────────────────────────────────────┤
+ *  │ TSIZE        │ Whole transfer length up front; EOT fires    │
+ *  │              │ ONCE at the very end                         │
+ *  │ FIFO         │ 16 bytes on SPI1/2/3 (8 on SPI4/5/6) - the   │
+ *  │              │ CPU can run ahead of the wire                │
+ *  │ FTHLV        │ TXP/RXP mean "room for / one whole PACKET",  │
+ *  │              │ not just one frame                           │
+ *  │ Packed       │ A 32-bit access to TXDR/RXDR moves 4 × 8-bit │
+ *  │ access       │ or 2 × 16-bit frames at once                 │
+ *  └──────────────┴──────────────────────────────────────────────┘
+ * 
+ *  Set FTHLV = "frames per 32-bit word" and every TXP / RXP is exactly
+ *  one 32-bit write / read:
+ * 
+ *  ┌────────────┬──────────────┬─────────────────┬───────────┐
+ *  │ Data size  │ Bytes/frame  │ Frames per word │ FTHLV     │
+ *  ├────────────┼──────────────┼─────────────────┼───────────┤
+ *  │ 4 - 8 bit  │ 1            │ 4               │ 3         │
+ *  │ 9 - 16 bit │ 2            │ 2               │ 1         │
+ *  │ 17 - 32 bit│ 4            │ 1               │ 0         │
+ *  └────────────┴──────────────┴─────────────────┴───────────┘
+ * 
+ *  The LOWEST byte of a packed word goes out FIRST (little endian).
+ * 
+ * ============================================================================ */
+
+/* Bytes one frame occupies in memory (1, 2 or 4) for the current DSIZE */
+uint8_t spi_frame_bytes = 1;
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 6: DATA SIZE AND FIFO THRESHOLD
+ *  =============================================
+ * 
+ *  DSIZE and FTHLV may only be changed while SPE = 0.
+ *  Frames of 4..32 bits are allowed (DSIZE = bits - 1 = 3..31).
+ * 
+ *  FTHLV stays 0 (one frame per TXP/RXP) outside a buffer transfer -
+ *  SPI_Transfer() waits for RXP after ONE byte, and with FTHLV = 3 that
+ *  RXP would never come. SPI_TransferBuffer() raises it to one packed
+ *  word for the length of the transfer and puts it back afterwards.
+ * 
+ * ============================================================================ */
+
+void SPI_SetDataSize(uint8_t bits) {
+    if (bits < 4 || bits > 32) {
+        return;
+    }
+
+    spi_frame_bytes = (bits <= 8) ? 1 : (bits <= 16) ? 2 : 4;
+
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CFG1 &= ~SPI_CFG1_DSIZE_Msk;
+
+    /* ✏️ YOUR TURN: Frame size */
+    SPI1->CFG1 |= ((uint32_t)??? << SPI_CFG1_DSIZE_Pos);      /* HINT: DSIZE = bits - 1 */
+
+    SPI1->CR1 |= SPI_CR1_SPE;
+}
+
+/* FIFO threshold in frames per packet - only while SPE = 0 */
+void SPI_SetThreshold(uint32_t frames_per_packet) {
+    SPI1->CFG1 = (SPI1->CFG1 & ~SPI_CFG1_FTHLV_Msk) |
+                 ((frames_per_packet - 1U) << SPI_CFG1_FTHLV_Pos);
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * SPI1->CFG1 |= ((uint32_t)(bits - 1U) << SPI_CFG1_DSIZE_Pos);
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  LESSON 6: PACKING FRAMES INTO WORDS
+ *  ====================================
+ * 
+ *  Buffers are plain byte arrays, so they may not be 32-bit aligned.
+ *  Assemble the word byte by byte - the compiler turns this into a
+ *  single LDR/STR on Cortex-M7 when it can.
+ * 
+ *  16-bit and 32-bit frames are stored little endian in the buffer,
+ *  exactly as a uint16_t[] / uint32_t[] array would be.
+ * 
+ * ============================================================================ */
+
+uint32_t SPI_LoadWord(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+         | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void SPI_StoreWord(uint8_t *p, uint32_t w) {
+    p[0] = (uint8_t)w;
+    p[1] = (uint8_t)(w >> 8);
+    p[2] = (uint8_t)(w >> 16);
+    p[3] = (uint8_t)(w >> 24);
+}
+
+/* Push ONE frame with an access exactly as wide as the frame */
+void SPI_WriteFrame(const uint8_t *p) {
+    if (spi_frame_bytes == 1) {
+        *((volatile uint8_t*)&SPI1->TXDR) = p[0];
+    } else if (spi_frame_bytes == 2) {
+        *((volatile uint16_t*)&SPI1->TXDR) = (uint16_t)(p[0] | (p[1] << 8));
+    } else {
+        SPI1->TXDR = SPI_LoadWord(p);
+    }
+}
+
+/* Pop ONE frame with an access exactly as wide as the frame */
+void SPI_ReadFrame(uint8_t *p) {
+    if (spi_frame_bytes == 1) {
+        p[0] = *((volatile uint8_t*)&SPI1->RXDR);
+    } else if (spi_frame_bytes == 2) {
+        uint16_t h = *((volatile uint16_t*)&SPI1->RXDR);
+        p[0] = (uint8_t)h;
+        p[1] = (uint8_t)(h >> 8);
+    } else {
+        SPI_StoreWord(p, SPI1->RXDR);
+    }
+}
+
+/* ============================================================================
+ * 
+ *  ✏️  EXERCISE 7: BUFFER TRANSFER THROUGH THE FIFO
+ *  =================================================
+ * 
+ *  One call = one transaction, any length up to 65535 frames:
+ * 
+ *  ┌─────────────┬─────────────┬──────────────────────────────────┐
+ *  │ tx          │ rx          │ Mode (CFG2.COMM)                 │
+ *  ├─────────────┼─────────────┼──────────────────────────────────┤
+ *  │ buffer      │ buffer      │ Full duplex       (00)           │
+ *  │ buffer      │ NULL (0)    │ Simplex transmit  (01) - RX off  │
+ *  │ NULL (0)    │ buffer      │ Simplex receive   (10) - no TX   │
+ *  └─────────────┴─────────────┴──────────────────────────────────┘
+ * 
+ *  In receive-only mode the master clocks by itself until TSIZE frames
+ *  have arrived - no dummy bytes to write.
+ * 
+ *  THE LOOP keeps both sides moving at once:
+ *  • TXP set → room for a whole packet → one 32-bit write
+ *  • RXP set → a whole packet waiting  → one 32-bit read
+ *  • The last 1-3 frames don't fill a packet, so RXP never comes for
+ *    them: RXPLVL says how many single frames are sitting in the FIFO.
+ * 
+ *  Never let TX run too far ahead: if the RX FIFO fills up, the master
+ *  overruns (OVR) and data is lost. Servicing RX in the same loop
+ *  prevents that.
+ * 
+ *  Returns 0 on success, -1 on bad arguments or overrun/underrun.
+ * 
+ * ============================================================================ */
+
+int SPI_TransferBuffer(const void *tx, void *rx, uint16_t frames) {
+    const uint8_t *txp = (const uint8_t *)tx;
+    uint8_t *rxp = (uint8_t *)rx;
+    uint32_t frames_per_word = 4U / spi_frame_bytes;
+    uint32_t tx_left = txp ? frames : 0;
+    uint32_t rx_left = rxp ? frames : 0;
+    uint32_t comm;
+    uint32_t sr;
+    int status = 0;
+
+    if (frames == 0 || (!txp && !rxp)) {
+        return -1;
+    }
+
+    comm = (txp && rxp) ? SPI_CFG2_COMM_FULLDUPLEX
+         : txp          ? SPI_CFG2_COMM_SIMPLEX_TX
+         :                SPI_CFG2_COMM_SIMPLEX_RX;
+
+    /* COMM, FTHLV and TSIZE are only written while the SPI is disabled */
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CFG2 = (SPI1->CFG2 & ~SPI_CFG2_COMM_Msk) | comm;
+
+    /* ✏️ YOUR TURN: One packet = one 32-bit word, so TXP/RXP match the packing */
+    SPI_SetThreshold(???);      /* HINT: How many frames fit in 4 bytes? */
+
+    /* ✏️ YOUR TURN: Tell the SPI the WHOLE length */
+    SPI1->CR2 = ???;            /* HINT: TSIZE = number of frames */
+
+    SPI1->CR1 |= SPI_CR1_SPE;
+    SPI1->CR1 |= SPI_CR1_CSTART;
+
+    while (tx_left || rx_left) {
+        sr = SPI1->SR;
+
+        /* ─── TX side ─── */
+        if (tx_left && (sr & SPI_SR_TXP)) {
+            if (tx_left >= frames_per_word) {
+                /* ✏️ YOUR TURN: One packed 32-bit write */
+                SPI1->TXDR = ???;           /* HINT: Assemble 4 bytes from txp */
+                txp += 4;
+                tx_left -= frames_per_word;
+            } else {
+                SPI_WriteFrame(txp);
+                txp += spi_frame_bytes;
+                tx_left--;
+            }
+        }
+
+        /* ─── RX side ─── */
+        if (rx_left >= frames_per_word && (sr & SPI_SR_RXP)) {
+            SPI_StoreWord(rxp, SPI1->RXDR);
+            rxp += 4;
+            rx_left -= frames_per_word;
+        } else if (rx_left && rx_left < frames_per_word) {
+            /* ✏️ YOUR TURN: Tail frames - how many are waiting? */
+            if (sr & ???) {                 /* HINT: RX FIFO packing level field */
+                SPI_ReadFrame(rxp);
+                rxp += spi_frame_bytes;
+                rx_left--;
+            }
+        }
+    }
+
+    /* One EOT for the whole buffer */
+    while (!(SPI1->SR & SPI_SR_EOT));
+
+    if (SPI1->SR & (SPI_SR_OVR | SPI_SR_UDR)) {
+        status = -1;
+    }
+    SPI1->IFCR = SPI_IFCR_EOTC | SPI_IFCR_TXTFC | SPI_IFCR_OVRC | SPI_IFCR_UDRC;
+
+    /* Leave the SPI the way SPI_Configure() left it: full duplex, one
+     * frame per TXP/RXP, enabled */
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CFG2 &= ~SPI_CFG2_COMM_Msk;
+    SPI_SetThreshold(1);
+    SPI1->CR1 |= SPI_CR1_SPE;
+
+    return status;
+}
+
+/* ─────────────────────────────────────────────────────────────────────────────
+ * 💡 SOLUTION:
+ * 
+ * SPI_SetThreshold(frames_per_word);
+ * SPI1->CR2 = frames;
+ * SPI1->TXDR = SPI_LoadWord(txp);
+ * 
+ * WHY SET FTHLV HERE?
+ *   TXP/RXP only promise room for, or arrival of, one PACKET. With
+ *   FTHLV = 0 a packet is one frame, and a 32-bit access would push
+ *   four frames into a FIFO that had room for one, or pop three that
+ *   have not arrived yet.
+ * if (sr & SPI_SR_RXPLVL_Msk) {
+ * 
+ * WHY NOT JUST READ RXDR AS 32 BITS AT THE END?
+ *   A 32-bit read with fewer than 4 frames in the FIFO returns garbage
+ *   in the missing bytes AND pops what is there. Tail frames must be
+ *   read with frame-sized accesses. (For 32-bit frames there is no tail:
+ *   one frame IS one word. RXPLVL is only valid up to 16-bit frames.)
+ * ───────────────────────────────────────────────────────────────────────────── */
+
+/* ============================================================================
+ * 
+ *  STEP 8: BURST REGISTER READ - ONE TRANSACTION
+ *  ===============================================
+ * 
+ *  Address byte + N data bytes in a single full-duplex transfer.
+ *  The first received byte is clocked in while the address goes out,
+ *  so it is thrown away.
+ * 
+ *  Many sensors also need an "auto-increment" bit in the address
+ *  (LIS3DH: bit 6 → reg | 0xC0). Check your datasheet.
+ * 
+ * ============================================================================ */
+
+#define SPI_BURST_MAX           32U
+
+int SPI_ReadRegisters(uint8_t reg, uint8_t *data, uint8_t len) {
+    uint8_t tx[SPI_BURST_MAX + 1];
+    uint8_t rx[SPI_BURST_MAX + 1];
+    int status;
+
+    if (len == 0 || len > SPI_BURST_MAX) {
+        return -1;
+    }
+
+    tx[0] = reg | 0x80;                 /* Read flag */
+    for (uint8_t i = 1; i <= len; i++) {
+        tx[i] = 0x00;                   /* Dummy bytes clock the data out */
+    }
+
+    SPI_CS_Low();
+    status = SPI_TransferBuffer(tx, rx, (uint16_t)(len + 1));
+    SPI_CS_High();
+
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = rx[i + 1];
+    }
+    return status;
+}
+
+/* ============================================================================
+ * 
+ *  STEP 9: THROUGHPUT BENCHMARK
+ *  =============================
+ * 
+ *  The DWT cycle counter counts CPU clocks (64 MHz here), so
+ *  cycles / 64 = microseconds.
+ * 
+ *  Both tests move the same 256 bytes at the same baud rate.
+ *  The difference is pure software overhead between frames.
+ * 
+ * ============================================================================ */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+#define SPI_BENCH_BYTES         256U
+
+uint8_t spi_bench_tx[SPI_BENCH_BYTES];
+uint8_t spi_bench_rx[SPI_BENCH_BYTES];
+
+/* Results - watch them in the debugger */
+volatile uint32_t spi_bench_byte_cycles = 0;
+volatile uint32_t spi_bench_fifo_cycles = 0;
+volatile uint32_t spi_bench_txonly_cycles = 0;
+
+void SPI_Benchmark(void) {
+    uint32_t start;
+
+    /* Enable the cycle counter (LAR unlock is needed on Cortex-M7) */
+    DEMCR |= DEMCR_TRCENA;
+    DWT_LAR = 0xC5ACCE55;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    for (uint32_t i = 0; i < SPI_BENCH_BYTES; i++) {
+        spi_bench_tx[i] = (uint8_t)i;
+    }
+
+    /* 1) Old way: one transaction per byte */
+    start = DWT_CYCCNT;
+    SPI_CS_Low();
+    for (uint32_t i = 0; i < SPI_BENCH_BYTES; i++) {
+        spi_bench_rx[i] = SPI_Transfer(spi_bench_tx[i]);
+    }
+    SPI_CS_High();
+    spi_bench_byte_cycles = DWT_CYCCNT - start;
+
+    /* 2) FIFO + packed 32-bit accesses, full duplex */
+    start = DWT_CYCCNT;
+    SPI_CS_Low();
+    SPI_TransferBuffer(spi_bench_tx, spi_bench_rx, SPI_BENCH_BYTES);
+    SPI_CS_High();
+    spi_bench_fifo_cycles = DWT_CYCCNT - start;
+
+    /* 3) Transmit only (e.g. pushing pixels to a display) */
+    start = DWT_CYCCNT;
+    SPI_CS_Low();
+    SPI_TransferBuffer(spi_bench_tx, 0, SPI_BENCH_BYTES);
+    SPI_CS_High();
+    spi_bench_txonly_cycles = DWT_CYCCNT - start;
+}
+
 /* ============================================================================
  * 
  *  ██████╗ ██████╗  █████╗  ██████╗████████╗██╗ ██████╗███████╗
@@ -555,13 +960,38 @@ uint8_t SPI_ReadRegister(uint8_t reg) {
  * 
  * ============================================================================ */
 
-void delay(volatile uint32_t count) {
-    while (count--);
+/* Reuses the DWT cycle counter from the benchmark above */
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* SPI_Benchmark() starts the counter, but main() may run without
+     * it - turn it on if it is still off */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
 }
 
 int main(void)
 {
     uint8_t whoami;
+    uint8_t accel[6];
     
     /* Initialize SPI */
     SPI_EnableClocks();
@@ -575,12 +1005,18 @@ int main(void)
     /* Your device should return its ID here */
     /* e.g., LIS3DH returns 0x33, MPU6000 returns 0x68 */
     
+    /* X/Y/Z low+high bytes in ONE transaction (LIS3DH OUT_X_L = 0x28) */
+    SPI_ReadRegisters(0x28 | 0x40, accel, sizeof(accel));
+    
+    /* Compare byte loop vs FIFO transfers (see spi_bench_*_cycles) */
+    SPI_Benchmark();
+    
     for(;;) {
         /* Toggle CS to show we're alive */
         SPI_CS_Low();
-        delay(100000);
+        delay_ms(10);
         SPI_CS_High();
-        delay(100000);
+        delay_ms(10);
     }
 }
 
@@ -597,6 +1033,9 @@ int main(void)
  *  ✅ SPI register configuration
  *  ✅ Transmit and receive data
  *  ✅ Read registers from SPI devices
+ *  ✅ Whole-buffer transfers with TSIZE, FIFO threshold and packed
+ *     32-bit TXDR/RXDR accesses (full duplex, TX-only, RX-only)
+ *  ✅ Measuring throughput with the DWT cycle counter
  *  
  *  COMMON SPI DEVICES TO TRY:
  *  • SD Card (SPI mode)
@@ -437,8 +437,40 @@ void LED_Toggle(void) {
     GPIOB->ODR ^= (1U << 0);
 }
 
-void delay(volatile uint32_t count) {
-    while (count--);
+/* Cycle-counted delay: the loop time must be KNOWN to stay inside the
+ * watchdog window - a count loop changes with every compiler setting */
+#define CPU_CLOCK_HZ            64000000U   /* HSI, the reset default */
+
+#define DEMCR                   (*(volatile uint32_t *) 0xE000EDFCUL)
+#define DWT_CTRL                (*(volatile uint32_t *) 0xE0001000UL)
+#define DWT_CYCCNT              (*(volatile uint32_t *) 0xE0001004UL)
+#define DWT_LAR                 (*(volatile uint32_t *) 0xE0001FB0UL)
+#define DEMCR_TRCENA            (1U << 24)
+#define DWT_CTRL_CYCCNTENA      (1U << 0)
+
+void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    /* Start the counter on first use - one check per call, then the
+     * loop below is the only thing between us and the window */
+    if (!(DWT_CTRL & DWT_CTRL_CYCCNTENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_LAR = 0xC5ACCE55;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+    }
+
+    start = DWT_CYCCNT;
+    while ((DWT_CYCCNT - start) < cycles);
+}
+
+void delay_us(uint32_t us) {
+    delay_cycles(us * (CPU_CLOCK_HZ / 1000000U));
+}
+
+void delay_ms(uint32_t ms) {
+    while (ms--) {
+        delay_us(1000);
+    }
 }
 
 /* ============================================================================
@@ -461,7 +493,7 @@ int main(void)
     /* Flash LED quickly 3 times at startup to show reset occurred */
     for (int i = 0; i < 6; i++) {
         LED_Toggle();
-        delay(500000);
+        delay_ms(50);
     }
     
     /* Initialize IWDG with ~1 second timeout
@@ -473,7 +505,7 @@ int main(void)
     
     for(;;) {
         LED_Toggle();
-        delay(2000000);
+        delay_ms(200);         /* Well inside the 1 s timeout */
         
         /* ⚠️ IMPORTANT: Feed the watchdog before timeout! */
         IWDG_Feed();